@@ -0,0 +1,879 @@
+/*
+**
+** libzbxredis - A Redis monitoring module for Zabbix
+** Copyright (C) 2016 - James Cook <james.cook000@gmail.com>
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+*/
+
+// Include bench header
+#include "bench.h"
+
+// Define bench items
+static bench_item_t bench_items[MAX_BENCH_ITEMS];
+static int          bench_items_count = 0;
+
+// Define results shared with the forked bench processes
+static unsigned long long *bench_latency = NULL;
+static unsigned long long *bench_failures = NULL;
+static size_t              bench_shared_size = 0;
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will parse a key line (name[param,"param",...]) *
+ *              into a bench item, replacing the password placeholder of the  *
+ *              key files                                                     *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int bench_item_parse(bench_item_t *item, const char *line, const char *password)
+{
+
+	// Declare Variables
+	char        param[MAX_LENGTH_BENCH_LINE];
+	const char *p, *end;
+	size_t      length;
+
+	memset(item, 0, sizeof(bench_item_t));
+
+	// Skip leading whitespace (item prototypes are indented)
+	while (isspace((unsigned char)*line)) {line++;}
+
+	// Trim trailing whitespace
+	end = line + strlen(line);
+	while (end > line && isspace((unsigned char)end[-1])) {end--;}
+
+	if (end == line) {return 1;}
+
+	item->key = zbx_malloc(NULL, end - line + 1);
+	memcpy(item->key, line, end - line);
+	item->key[end - line] = '\0';
+
+	// Key without parameters
+	if ((p = strchr(item->key, '[')) == NULL) {item->name = zbx_strdup(NULL, item->key); return 0;}
+
+	item->name = zbx_malloc(NULL, p - item->key + 1);
+	memcpy(item->name, item->key, p - item->key);
+	item->name[p - item->key] = '\0';
+
+	// Parameters must close the key
+	if (item->key[strlen(item->key) - 1] != ']') {goto fail;}
+
+	end = item->key + strlen(item->key) - 1;
+	p++;
+
+	// Split the parameters
+	while (p <= end) {
+
+		if (item->nparam == MAX_BENCH_PARAMS) {goto fail;}
+
+		while (*p == ' ') {p++;}
+
+		length = 0;
+
+		if (*p == '"') {
+
+			// Quoted parameter (\" escapes a quote)
+			for (p++; p < end && *p != '"'; p++) {
+
+				if (*p == '\\' && p[1] == '"') {p++;}
+
+				if (length < sizeof(param) - 1) {param[length++] = *p;}
+
+			}
+
+			if (*p++ != '"') {goto fail;}
+
+			while (*p == ' ') {p++;}
+
+		} else {
+
+			// Unquoted parameter
+			for (; p < end && *p != ','; p++) {if (length < sizeof(param) - 1) {param[length++] = *p;}}
+
+		}
+
+		param[length] = '\0';
+
+		if (p < end && *p != ',') {goto fail;}
+
+		// Replace the password placeholder
+		if (password != NULL && strcmp(param, DEFAULT_BENCH_PASSWORD) == 0) {zbx_strlcpy(param, password, sizeof(param));}
+
+		item->params[item->nparam++] = zbx_strdup(NULL, param);
+
+		p++;
+
+	}
+
+	return 0;
+
+fail:
+
+	bench_item_free(item);
+
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free a bench item                          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void bench_item_free(bench_item_t *item)
+{
+
+	// Declare Variables
+	int count;
+
+	for (count = 0; count < item->nparam; count++) {zbx_free(item->params[count]);}
+
+	zbx_free(item->key);
+	zbx_free(item->name);
+
+	item->nparam = 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Reads a JSON string (or bare value) into a buffer             *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int bench_json_value(const char **json, char *output, size_t size)
+{
+
+	// Declare Variables
+	const char *p = *json;
+	size_t      length = 0;
+
+	if (*p == '"') {
+
+		for (p++; *p != '\0' && *p != '"'; p++) {
+
+			if (*p == '\\') {
+
+				p++;
+
+				switch (*p) {
+					case 'n': if (length < size - 1) {output[length++] = '\n';} break;
+					case 't': if (length < size - 1) {output[length++] = '\t';} break;
+					case 'r': if (length < size - 1) {output[length++] = '\r';} break;
+					case 'u': if (strlen(p) < 5) {return 1;} if (length < size - 1) {output[length++] = (char)strtol((char[]){p[3], p[4], '\0'}, NULL, 16);} p += 4; break;
+					case '\0': return 1;
+					default: if (length < size - 1) {output[length++] = *p;}
+				}
+
+			} else if (length < size - 1) {output[length++] = *p;}
+
+		}
+
+		if (*p++ != '"') {return 1;}
+
+	} else {
+
+		for (; *p != '\0' && *p != ',' && *p != '}' && !isspace((unsigned char)*p); p++) {if (length < size - 1) {output[length++] = *p;}}
+
+	}
+
+	output[length] = '\0';
+	*json = p;
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will read the next row of a low level discovery *
+ *              reply ({"data":[{"{#MACRO}":"value",...},...]})               *
+ * Returns    : Macro count, -1 when no rows remain                           *
+ *                                                                            *
+ ******************************************************************************/
+int bench_lld_row(const char **json, char names[][MAX_LENGTH_BENCH_MACRO], char values[][MAX_LENGTH_BENCH_MACRO], int max)
+{
+
+	// Declare Variables
+	const char *p = *json;
+	char        name[MAX_LENGTH_BENCH_MACRO], value[MAX_LENGTH_BENCH_MACRO];
+	int         count = 0;
+
+	// Move into the data array on the first row
+	if (*p == '{') {
+
+		if ((p = strstr(p, "\"data\"")) == NULL || (p = strchr(p, '[')) == NULL) {return -1;}
+
+		p++;
+
+	}
+
+	while (isspace((unsigned char)*p) || *p == ',') {p++;}
+
+	if (*p != '{') {return -1;}
+
+	p++;
+
+	// Read the macros of the row
+	while (1) {
+
+		while (isspace((unsigned char)*p) || *p == ',') {p++;}
+
+		if (*p == '}') {p++; break;}
+
+		if (bench_json_value(&p, name, sizeof(name))) {return -1;}
+
+		while (isspace((unsigned char)*p) || *p == ':') {p++;}
+
+		if (bench_json_value(&p, value, sizeof(value))) {return -1;}
+
+		if (count < max) {
+
+			zbx_strlcpy(names[count], name, MAX_LENGTH_BENCH_MACRO);
+			zbx_strlcpy(values[count], value, MAX_LENGTH_BENCH_MACRO);
+			count++;
+
+		}
+
+	}
+
+	*json = p;
+
+	return count;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will expand the discovery macros of an item     *
+ *              prototype line                                                *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int bench_lld_expand(char *output, size_t size, const char *line, char names[][MAX_LENGTH_BENCH_MACRO], char values[][MAX_LENGTH_BENCH_MACRO], int count)
+{
+
+	// Declare Variables
+	size_t length = 0, value_length;
+	int    macro;
+
+	while (*line != '\0') {
+
+		// Substitute a known macro
+		for (macro = 0; macro < count; macro++) {if (strncmp(line, names[macro], strlen(names[macro])) == 0) {break;}}
+
+		if (macro < count) {
+
+			value_length = strlen(values[macro]);
+
+			if (length + value_length >= size) {return 1;}
+
+			memcpy(output + length, values[macro], value_length);
+			length += value_length;
+			line   += strlen(names[macro]);
+
+		} else {
+
+			if (length + 1 >= size) {return 1;}
+
+			output[length++] = *line++;
+
+		}
+
+	}
+
+	output[length] = '\0';
+
+	// Unknown macros are left unexpanded
+	return strstr(output, "{#") != NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will connect to a mock server (host:port)       *
+ * Returns    : Socket or -1 (failure)                                        *
+ *                                                                            *
+ ******************************************************************************/
+int bench_mock_connect(const char *address)
+{
+
+	// Declare Variables
+	char             host[MAX_LENGTH_BENCH_MACRO], *port;
+	struct addrinfo  hints, *addresses, *next;
+	int              fd = -1;
+
+	zbx_strlcpy(host, address, sizeof(host));
+
+	if ((port = strrchr(host, ':')) == NULL) {return -1;}
+
+	*port++ = '\0';
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_socktype = SOCK_STREAM;
+
+	if (getaddrinfo(host, port, &hints, &addresses) != 0) {return -1;}
+
+	for (next = addresses; next != NULL; next = next->ai_next) {
+
+		if ((fd = socket(next->ai_family, next->ai_socktype, next->ai_protocol)) < 0) {continue;}
+
+		if (connect(fd, next->ai_addr, next->ai_addrlen) == 0) {break;}
+
+		close(fd);
+		fd = -1;
+
+	}
+
+	freeaddrinfo(addresses);
+
+	return fd;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will read the commands and connections the mock *
+ *              server received since the last call, and reset them           *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int bench_mock_count(int fd, unsigned long *commands, unsigned long *connections)
+{
+
+	// Declare Variables
+	static const char request[] = "MOCK COUNT\r\nMOCK RESET\r\n";
+	char              reply[256] = "";
+	size_t            length = 0;
+	ssize_t           received;
+
+	if (send(fd, request, sizeof(request) - 1, MSG_NOSIGNAL) != (ssize_t)(sizeof(request) - 1)) {return 1;}
+
+	// Read until both replies have arrived
+	while (strstr(reply, "+OK\r\n") == NULL) {
+
+		if (length == sizeof(reply) - 1 || (received = recv(fd, reply + length, sizeof(reply) - 1 - length, 0)) <= 0) {return 1;}
+
+		length += received;
+		reply[length] = '\0';
+
+	}
+
+	return sscanf(reply, "*2\r\n:%lu\r\n:%lu\r\n", commands, connections) != 2;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will call a key handler with the request of an  *
+ *              item                                                          *
+ * Returns    : SYSINFO_RET_OK or SYSINFO_RET_FAIL, latency in nanoseconds    *
+ *                                                                            *
+ ******************************************************************************/
+static int bench_item_call(bench_item_t *item, AGENT_RESULT *result, unsigned long long *latency)
+{
+
+	// Declare Variables
+	AGENT_REQUEST request;
+	int           ret;
+	unsigned long long start;
+
+	memset(&request, 0, sizeof(request));
+	memset(result, 0, sizeof(AGENT_RESULT));
+
+	request.key    = item->name;
+	request.nparam = item->nparam;
+	request.params = item->params;
+
+	// Call the handler
+	start = bench_clock();
+	ret = ((bench_handler_t)item->metric->function)(&request, result);
+	*latency = bench_clock() - start;
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the values of a result                *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_result_free(AGENT_RESULT *result)
+{
+
+	if (result->type & AR_STRING) {zbx_free(result->str);}
+	if (result->type & AR_TEXT) {zbx_free(result->text);}
+	if (result->type & AR_MESSAGE) {zbx_free(result->msg);}
+
+	result->type = 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will add a key line as a bench item when the    *
+ *              module exports its key                                        *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_item_add(ZBX_METRIC *metrics, const char *line, const char *password)
+{
+
+	// Declare Variables
+	bench_item_t *item;
+	int           count;
+
+	if (bench_items_count == MAX_BENCH_ITEMS) {
+
+		fprintf(stderr, "%s: Too many items, skipping (%s)\n", BENCH, line);
+		return;
+
+	}
+
+	item = &bench_items[bench_items_count];
+
+	if (bench_item_parse(item, line, password)) {
+
+		fprintf(stderr, "%s: Invalid key, skipping (%s)\n", BENCH, line);
+		return;
+
+	}
+
+	// Find the key in the module
+	for (count = 0; metrics[count].key != NULL; count++) {if (strcmp(metrics[count].key, item->name) == 0) {break;}}
+
+	if (metrics[count].key == NULL) {
+
+		if (bench_log_level >= LOG_LEVEL_DEBUG) {fprintf(stderr, "%s: Key not exported by the module, skipping (%s)\n", BENCH, item->key);}
+
+		bench_item_free(item);
+		return;
+
+	}
+
+	item->metric = &metrics[count];
+	bench_items_count++;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will load a key file, expanding each item       *
+ *              prototype with the rows of the discovery key above it         *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int bench_load(ZBX_METRIC *metrics, const char *path, const char *password)
+{
+
+	// Declare Variables
+	FILE         *file;
+	char          line[MAX_LENGTH_BENCH_LINE], expanded[MAX_LENGTH_BENCH_LINE];
+	char          names[MAX_BENCH_MACROS][MAX_LENGTH_BENCH_MACRO], values[MAX_BENCH_MACROS][MAX_LENGTH_BENCH_MACRO];
+	char         *discovery = NULL, *p;
+	const char   *row;
+	AGENT_RESULT  result;
+	unsigned long long latency;
+	int           count, discovery_item = -1;
+
+	if ((file = fopen(path, "r")) == NULL) {
+
+		fprintf(stderr, "%s: Unable to open key file %s (%s)\n", BENCH, path, strerror(errno));
+		return 1;
+
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+
+		if ((p = strchr(line, '\n')) != NULL) {*p = '\0';}
+
+		for (p = line; isspace((unsigned char)*p); p++);
+
+		// Skip comments and blank lines
+		if (*p == '#' || *p == '\0') {continue;}
+
+		// A plain key (discoveries are benched as plain keys too)
+		if (strstr(p, "{#") == NULL) {
+
+			count = bench_items_count;
+			bench_item_add(metrics, p, password);
+
+			// Remember the most recent discovery for the prototypes below it
+			if (bench_items_count > count && strstr(bench_items[count].name, ".discovery") != NULL) {discovery_item = count; zbx_free(discovery);}
+
+			continue;
+
+		}
+
+		// An item prototype needs a discovery above it
+		if (discovery_item < 0) {
+
+			fprintf(stderr, "%s: Item prototype without a discovery, skipping (%s)\n", BENCH, p);
+			continue;
+
+		}
+
+		// Run the discovery once
+		if (discovery == NULL) {
+
+			if (bench_item_call(&bench_items[discovery_item], &result, &latency) != SYSINFO_RET_OK || !(result.type & AR_STRING)) {
+
+				fprintf(stderr, "%s: Discovery failed for %s (%s)\n", BENCH, bench_items[discovery_item].key, (result.type & AR_MESSAGE) ? result.msg : "no data");
+
+				bench_result_free(&result);
+				discovery_item = -1;
+				continue;
+
+			}
+
+			discovery = result.str;
+			result.str = NULL;
+			bench_result_free(&result);
+
+		}
+
+		// Add the prototype for every discovered row
+		for (row = discovery; (count = bench_lld_row(&row, names, values, MAX_BENCH_MACROS)) >= 0;) {
+
+			if (bench_lld_expand(expanded, sizeof(expanded), p, names, values, count)) {continue;}
+
+			bench_item_add(metrics, expanded, password);
+
+		}
+
+	}
+
+	zbx_free(discovery);
+	fclose(file);
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will call every item for the iterations of one  *
+ *              bench process, recording into the shared results              *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_worker(int process, int processes, int iterations)
+{
+
+	// Declare Variables
+	AGENT_RESULT       result;
+	unsigned long long latency;
+	int                iteration, count, item;
+
+	for (iteration = 0; iteration < iterations; iteration++) {
+
+		for (count = 0; count < bench_items_count; count++) {
+
+			// Stagger the processes across the keys
+			item = (count + process) % bench_items_count;
+
+			if (bench_item_call(&bench_items[item], &result, &latency) != SYSINFO_RET_OK) {bench_failures[(size_t)item * processes + process]++;}
+
+			bench_latency[((size_t)item * processes + process) * iterations + iteration] = latency;
+
+			bench_result_free(&result);
+
+		}
+
+	}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Compares two latencies for qsort                              *
+ * Returns    : -1, 0 or 1                                                    *
+ *                                                                            *
+ ******************************************************************************/
+static int bench_compare(const void *a, const void *b)
+{
+
+	// Declare Variables
+	unsigned long long x = *(const unsigned long long *)a, y = *(const unsigned long long *)b;
+
+	return x < y ? -1 : x > y;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will print the latency percentiles of every     *
+ *              item and the total items per second                           *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_report(int processes, int iterations, unsigned long long elapsed, int counted)
+{
+
+	// Declare Variables
+	unsigned long long *latency, failures, total_failures = 0;
+	size_t              samples = (size_t)processes * iterations;
+	int                 item, process;
+
+	printf("%-72s %8s %8s %10s %10s %10s %10s", "key", "calls", "errors", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+
+	if (counted) {printf(" %6s %6s", "cmds", "conns");}
+
+	printf("\n");
+
+	for (item = 0; item < bench_items_count; item++) {
+
+		latency = bench_latency + (size_t)item * samples;
+
+		qsort(latency, samples, sizeof(unsigned long long), bench_compare);
+
+		for (failures = 0, process = 0; process < processes; process++) {failures += bench_failures[(size_t)item * processes + process];}
+
+		total_failures += failures;
+
+		printf("%-72.72s %8zu %8llu %10.1f %10.1f %10.1f %10.1f", bench_items[item].key, samples, failures,
+			latency[samples * 50 / 100] / 1000.0, latency[samples * 90 / 100] / 1000.0,
+			latency[samples * 99 / 100] / 1000.0, latency[samples - 1] / 1000.0);
+
+		if (counted) {printf(" %6lu %6lu", bench_items[item].commands, bench_items[item].connections);}
+
+		printf("\n");
+
+	}
+
+	printf("\n%zu items (%llu errors) across %d processes in %.3fs: %.1f items/s\n", samples * bench_items_count, total_failures,
+		processes, elapsed / 1e9, elapsed ? samples * bench_items_count / (elapsed / 1e9) : 0.0);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Prints the usage                                              *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_usage()
+{
+
+	fprintf(stderr,
+		"Usage: %s [-m module] [-p processes] [-n iterations] [-t timeout] [-a password] [-c host:port [-B commands]] [-v] keyfile\n"
+		"  -m  Module to load (default %s)\n"
+		"  -p  Forked bench processes, as the agent forks its pollers (default %d)\n"
+		"  -n  Iterations of the key file in each process (default %d)\n"
+		"  -t  Item timeout passed to the module (default %d)\n"
+		"  -a  Password replacing %s in the key file\n"
+		"  -c  Count the commands and connections of each item against a mock server\n"
+		"  -B  Fail when an item sends more commands than this to the mock server\n"
+		"  -v  Print module log messages (repeat for debug)\n",
+		BENCH, DEFAULT_BENCH_MODULE, DEFAULT_BENCH_PROCESSES, DEFAULT_BENCH_ITERATIONS, DEFAULT_BENCH_TIMEOUT, DEFAULT_BENCH_PASSWORD);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will load the module and the key file, fork the *
+ *              bench processes and report the results                        *
+ * Returns    : EXIT_SUCCESS or EXIT_FAILURE                                  *
+ *                                                                            *
+ ******************************************************************************/
+int main(int argc, char **argv)
+{
+
+	// Declare Variables
+	const char        *module = DEFAULT_BENCH_MODULE, *password = NULL, *mock = NULL;
+	int                processes = DEFAULT_BENCH_PROCESSES, iterations = DEFAULT_BENCH_ITERATIONS, timeout = DEFAULT_BENCH_TIMEOUT;
+	int                option, process, forked, status, budget = 0, fd, ret = EXIT_FAILURE;
+	unsigned long      commands, connections;
+	AGENT_RESULT       result;
+	unsigned long long latency;
+	void              *handle;
+	int              (*module_api_version)();
+	int              (*module_init)();
+	int              (*module_uninit)();
+	void             (*module_item_timeout)(int);
+	ZBX_METRIC      *(*module_item_list)();
+	pid_t              pids[MAX_BENCH_PROCESSES];
+	unsigned long long start, elapsed;
+
+	while ((option = getopt(argc, argv, "m:p:n:t:a:c:B:v")) != -1) {
+
+		switch (option) {
+			case 'm': module = optarg; break;
+			case 'p': processes = atoi(optarg); break;
+			case 'n': iterations = atoi(optarg); break;
+			case 't': timeout = atoi(optarg); break;
+			case 'a': password = optarg; break;
+			case 'c': mock = optarg; break;
+			case 'B': budget = atoi(optarg); break;
+			case 'v': bench_log_level = bench_log_level < LOG_LEVEL_WARNING ? LOG_LEVEL_WARNING : LOG_LEVEL_DEBUG; break;
+			default: bench_usage(); return EXIT_FAILURE;
+		}
+
+	}
+
+	if (optind != argc - 1 || processes < 1 || processes > MAX_BENCH_PROCESSES || iterations < 1 || iterations > MAX_BENCH_ITERATIONS || timeout < 1) {
+
+		bench_usage();
+		return EXIT_FAILURE;
+
+	}
+
+#ifdef ZBX_CHECK_LOG_LEVEL
+	zbx_log_level = bench_log_level;
+#endif
+
+	// Load the module against the Zabbix symbols exported by the bench
+	if ((handle = dlopen(module, RTLD_NOW)) == NULL) {
+
+		fprintf(stderr, "%s: Unable to load module %s (%s)\n", BENCH, module, dlerror());
+		return EXIT_FAILURE;
+
+	}
+
+	*(void **)&module_api_version  = dlsym(handle, "zbx_module_api_version");
+	*(void **)&module_init         = dlsym(handle, "zbx_module_init");
+	*(void **)&module_uninit       = dlsym(handle, "zbx_module_uninit");
+	*(void **)&module_item_timeout = dlsym(handle, "zbx_module_item_timeout");
+	*(void **)&module_item_list    = dlsym(handle, "zbx_module_item_list");
+
+	if (module_api_version == NULL || module_init == NULL || module_item_list == NULL) {
+
+		fprintf(stderr, "%s: Module %s is not a Zabbix module\n", BENCH, module);
+		goto unload;
+
+	}
+
+	if (module_api_version() != ZBX_MODULE_API_VERSION_ONE) {
+
+		fprintf(stderr, "%s: Module %s has an unsupported api version\n", BENCH, module);
+		goto unload;
+
+	}
+
+	// Initialise in this process before forking, as the agent does
+	if (module_init() != ZBX_MODULE_OK) {
+
+		fprintf(stderr, "%s: Module %s failed to initialise\n", BENCH, module);
+		goto unload;
+
+	}
+
+	if (module_item_timeout != NULL) {module_item_timeout(timeout);}
+
+	if (bench_load(module_item_list(), argv[optind], password) || bench_items_count == 0) {
+
+		fprintf(stderr, "%s: No module keys found in %s\n", BENCH, argv[optind]);
+		goto uninit;
+
+	}
+
+	// Count the commands of each item against a mock server, one item at a time
+	if (mock != NULL) {
+
+		if ((fd = bench_mock_connect(mock)) < 0 || bench_mock_count(fd, &commands, &connections)) {
+
+			fprintf(stderr, "%s: Unable to reach mock server %s\n", BENCH, mock);
+			if (fd >= 0) {close(fd);}
+			goto uninit;
+
+		}
+
+		for (process = 0; process < bench_items_count; process++) {
+
+			bench_item_call(&bench_items[process], &result, &latency);
+			bench_result_free(&result);
+
+			if (bench_mock_count(fd, &bench_items[process].commands, &bench_items[process].connections)) {
+
+				fprintf(stderr, "%s: Lost mock server %s\n", BENCH, mock);
+				close(fd);
+				goto uninit;
+
+			}
+
+		}
+
+		close(fd);
+
+	}
+
+	// Allocate the results shared with the forked processes
+	bench_shared_size = (size_t)bench_items_count * processes * (iterations + 1) * sizeof(unsigned long long);
+
+	if ((bench_latency = mmap(NULL, bench_shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED) {
+
+		fprintf(stderr, "%s: Unable to allocate results (%s)\n", BENCH, strerror(errno));
+		goto uninit;
+
+	}
+
+	bench_failures = bench_latency + (size_t)bench_items_count * processes * iterations;
+
+	// Fork the bench processes
+	start = bench_clock();
+
+	for (forked = 0; forked < processes; forked++) {
+
+		if ((pids[forked] = fork()) == 0) {bench_worker(forked, processes, iterations); _exit(EXIT_SUCCESS);}
+
+		if (pids[forked] < 0) {fprintf(stderr, "%s: Unable to fork (%s)\n", BENCH, strerror(errno)); break;}
+
+	}
+
+	for (ret = forked == processes ? EXIT_SUCCESS : EXIT_FAILURE, process = 0; process < forked; process++) {
+
+		if (waitpid(pids[process], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+
+			fprintf(stderr, "%s: Bench process %d failed\n", BENCH, process);
+			ret = EXIT_FAILURE;
+
+		}
+
+	}
+
+	elapsed = bench_clock() - start;
+
+	if (ret == EXIT_SUCCESS) {bench_report(processes, iterations, elapsed, mock != NULL);}
+
+	// Check the round trip budget
+	for (process = 0; mock != NULL && budget > 0 && process < bench_items_count; process++) {
+
+		if (bench_items[process].commands <= (unsigned long)budget) {continue;}
+
+		fprintf(stderr, "%s: %s sent %lu commands, over the budget of %d\n", BENCH, bench_items[process].key, bench_items[process].commands, budget);
+		ret = EXIT_FAILURE;
+
+	}
+
+	munmap(bench_latency, bench_shared_size);
+
+uninit:
+
+	for (process = 0; process < bench_items_count; process++) {bench_item_free(&bench_items[process]);}
+
+	if (module_uninit != NULL) {module_uninit();}
+
+unload:
+
+	dlclose(handle);
+
+	return ret;
+
+}
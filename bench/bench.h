@@ -0,0 +1,94 @@
+/*
+**
+** libzbxredis - A Redis monitoring module for Zabbix
+** Copyright (C) 2016 - James Cook <james.cook000@gmail.com>
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+*/
+
+#ifndef ZBXREDIS_BENCH_H
+#define ZBXREDIS_BENCH_H
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <dlfcn.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netdb.h>
+
+// Zabbix source headers
+#include <sysinc.h>
+#include <module.h>
+#include <common.h>
+#include <time.h>
+#include <log.h>
+#include <zbxjson.h>
+
+// Default bench name
+#define BENCH "zbxredis_bench"
+
+// Define max lengths
+#define MAX_LENGTH_BENCH_LINE 8192
+#define MAX_LENGTH_BENCH_MACRO 255
+
+// Default values
+#define DEFAULT_BENCH_MODULE "src/.libs/libzbxredis.so"
+#define DEFAULT_BENCH_PROCESSES 1
+#define DEFAULT_BENCH_ITERATIONS 100
+#define DEFAULT_BENCH_TIMEOUT 3
+#define DEFAULT_BENCH_PASSWORD "REDIS-PASSWORD"
+#define DEFAULT_PARSE_CORPUS "bench/corpus"
+#define DEFAULT_PARSE_REPEAT 100
+
+// Bench limits
+#define MAX_BENCH_PROCESSES 256
+#define MAX_BENCH_ITERATIONS 1000000
+#define MAX_BENCH_ITEMS 4096
+#define MAX_BENCH_PARAMS 64
+#define MAX_BENCH_MACROS 16
+#define MAX_PARSE_FIELDS 1024
+#define MAX_PARSE_REPEAT 100000
+
+// Key handler as exported through zbx_module_item_list
+typedef int (*bench_handler_t)(AGENT_REQUEST *request, AGENT_RESULT *result);
+
+// Define bench item (one key line of a key file)
+typedef struct bench_item {
+	char          *key;
+	char          *name;
+	char          *params[MAX_BENCH_PARAMS];
+	int            nparam;
+	ZBX_METRIC    *metric;
+	unsigned long  commands;
+	unsigned long  connections;
+} bench_item_t;
+
+// Log level of the shimmed zabbix_log
+extern int bench_log_level;
+
+// Bench functions
+unsigned long long bench_clock();
+int bench_item_parse(bench_item_t *item, const char *line, const char *password);
+void bench_item_free(bench_item_t *item);
+int bench_lld_row(const char **json, char names[][MAX_LENGTH_BENCH_MACRO], char values[][MAX_LENGTH_BENCH_MACRO], int max);
+int bench_mock_connect(const char *address);
+int bench_mock_count(int fd, unsigned long *commands, unsigned long *connections);
+int bench_lld_expand(char *output, size_t size, const char *line, char names[][MAX_LENGTH_BENCH_MACRO], char values[][MAX_LENGTH_BENCH_MACRO], int count);
+
+#endif
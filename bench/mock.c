@@ -0,0 +1,894 @@
+/*
+**
+** libzbxredis - A Redis monitoring module for Zabbix
+** Copyright (C) 2016 - James Cook <james.cook000@gmail.com>
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+*/
+
+// Include mock header
+#include "mock.h"
+
+// Define mock configuration and canned replies
+static mock_config_t mock_config;
+static mock_reply_t  mock_replies[MAX_MOCK_REPLIES];
+static int           mock_replies_count = 0;
+
+// Define counters (guarded by mock_lock)
+static pthread_mutex_t mock_lock = PTHREAD_MUTEX_INITIALIZER;
+static mock_counter_t  mock_counters[MAX_MOCK_COMMANDS];
+static int             mock_counters_count = 0;
+static unsigned long   mock_commands = 0;
+static unsigned long   mock_connections = 0;
+static unsigned long   mock_connection_max = 0;
+static unsigned long   mock_count_commands = 0;
+static unsigned long   mock_count_connections = 0;
+
+// Commands answered by the mock itself
+static const char *mock_builtins[] = {"ping", "echo", "auth", "select", "client", "quit", "time", "command", "info", NULL};
+
+// Set by SIGINT and SIGTERM
+static volatile sig_atomic_t mock_stop = 0;
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Reads a whole file, converting bare line feeds to CRLF when   *
+ *              asked (RESP files are kept with plain line endings)           *
+ * Returns    : File contents or NULL                                         *
+ *                                                                            *
+ ******************************************************************************/
+static char *mock_file_read(const char *path, int crlf, size_t *length)
+{
+
+	// Declare Variables
+	FILE   *file;
+	char   *data = NULL;
+	size_t  allocated = 0, used = 0;
+	int     c, previous = 0;
+
+	if ((file = fopen(path, "r")) == NULL) {return NULL;}
+
+	while ((c = fgetc(file)) != EOF) {
+
+		if (used + 3 > allocated) {
+
+			allocated = allocated ? allocated * 2 : 4096;
+
+			if ((data = realloc(data, allocated)) == NULL) {fclose(file); return NULL;}
+
+		}
+
+		if (crlf && c == '\n' && previous != '\r') {data[used++] = '\r';}
+
+		data[used++] = (char)c;
+		previous = c;
+
+	}
+
+	fclose(file);
+
+	if (data == NULL && (data = malloc(1)) == NULL) {return NULL;}
+
+	data[used] = '\0';
+	*length = used;
+
+	return data;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will load the canned replies of a directory     *
+ *              (name.resp is sent as recorded, name.txt as a bulk string)    *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int mock_replies_load(const char *directory)
+{
+
+	// Declare Variables
+	DIR           *dir;
+	struct dirent *entry;
+	mock_reply_t  *reply;
+	char           path[MAX_LENGTH_MOCK_PATH];
+	char          *extension, *text;
+	size_t         length;
+
+	if ((dir = opendir(directory)) == NULL) {
+
+		fprintf(stderr, "%s: Unable to open replies %s (%s)\n", MOCK, directory, strerror(errno));
+		return 1;
+
+	}
+
+	while ((entry = readdir(dir)) != NULL && mock_replies_count < MAX_MOCK_REPLIES) {
+
+		if ((extension = strrchr(entry->d_name, '.')) == NULL || extension == entry->d_name) {continue;}
+		if (strcmp(extension, ".resp") != 0 && strcmp(extension, ".txt") != 0) {continue;}
+		if ((size_t)(extension - entry->d_name) >= MAX_LENGTH_MOCK_NAME) {continue;}
+
+		snprintf(path, sizeof(path), "%s/%s", directory, entry->d_name);
+
+		if ((text = mock_file_read(path, strcmp(extension, ".resp") == 0, &length)) == NULL) {
+
+			fprintf(stderr, "%s: Unable to read reply %s (%s)\n", MOCK, path, strerror(errno));
+			continue;
+
+		}
+
+		reply = &mock_replies[mock_replies_count++];
+
+		memcpy(reply->name, entry->d_name, extension - entry->d_name);
+		reply->name[extension - entry->d_name] = '\0';
+
+		// Recorded replies are sent as is
+		if (strcmp(extension, ".resp") == 0) {
+
+			reply->text   = NULL;
+			reply->data   = text;
+			reply->length = length;
+			continue;
+
+		}
+
+		// Text replies are sent as a bulk string
+		reply->text   = text;
+		reply->data   = malloc(length + 32);
+		reply->length = reply->data ? (size_t)sprintf(reply->data, "$%zu\r\n", length) : 0;
+
+		if (reply->data == NULL) {mock_replies_count--; free(text); continue;}
+
+		memcpy(reply->data + reply->length, text, length);
+		reply->length += length;
+		memcpy(reply->data + reply->length, "\r\n", 2);
+		reply->length += 2;
+
+	}
+
+	closedir(dir);
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Finds a canned reply by name                                  *
+ * Returns    : Reply or NULL                                                 *
+ *                                                                            *
+ ******************************************************************************/
+static mock_reply_t *mock_reply_find(const char *name)
+{
+
+	// Declare Variables
+	int count;
+
+	for (count = 0; count < mock_replies_count; count++) {if (strcmp(mock_replies[count].name, name) == 0) {return &mock_replies[count];}}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the canned reply of a command, trying *
+ *              the most specific name first (type_mylist, then type)         *
+ * Returns    : Reply or NULL                                                 *
+ *                                                                            *
+ ******************************************************************************/
+static mock_reply_t *mock_reply_command(int argc, char **argv)
+{
+
+	// Declare Variables
+	mock_reply_t *reply;
+	char          name[MAX_LENGTH_MOCK_NAME];
+	size_t        length;
+	int           words, count;
+	char         *p;
+
+	for (words = argc; words > 0; words--) {
+
+		for (length = 0, count = 0; count < words; count++) {
+
+			if (length + strlen(argv[count]) + 2 > sizeof(name)) {break;}
+
+			if (count > 0) {name[length++] = '_';}
+
+			for (p = argv[count]; *p != '\0'; p++) {name[length++] = (char)tolower((unsigned char)*p);}
+
+		}
+
+		if (count < words) {continue;}
+
+		name[length] = '\0';
+
+		if ((reply = mock_reply_find(name)) != NULL) {return reply;}
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Checks whether the mock can answer a command                  *
+ * Returns    : 1 (supported), 0 (unsupported)                                *
+ *                                                                            *
+ ******************************************************************************/
+static int mock_command_supported(const char *command)
+{
+
+	// Declare Variables
+	char   name[MAX_LENGTH_MOCK_NAME];
+	size_t length;
+	int    count;
+
+	for (length = 0; command[length] != '\0' && length < sizeof(name) - 1; length++) {name[length] = (char)tolower((unsigned char)command[length]);}
+
+	name[length] = '\0';
+
+	for (count = 0; mock_builtins[count] != NULL; count++) {if (strcmp(mock_builtins[count], name) == 0) {return 1;}}
+
+	for (count = 0; count < mock_replies_count; count++) {
+
+		if (strncmp(mock_replies[count].name, name, length) == 0 && (mock_replies[count].name[length] == '\0' || mock_replies[count].name[length] == '_')) {return 1;}
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will write a reply, split into chunks of the    *
+ *              partial size to force partial reads in the client             *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int mock_send(mock_client_t *client, const char *data, size_t length)
+{
+
+	// Declare Variables
+	struct timespec pause = {0, 1000000};
+	size_t          chunk;
+	ssize_t         sent;
+
+	while (length > 0) {
+
+		chunk = (mock_config.partial > 0 && length > (size_t)mock_config.partial) ? (size_t)mock_config.partial : length;
+
+		if ((sent = send(client->fd, data, chunk, MSG_NOSIGNAL)) < 0) {
+
+			if (errno == EINTR) {continue;}
+
+			return 1;
+
+		}
+
+		data   += sent;
+		length -= sent;
+
+		// Give the client a chance to read the partial reply
+		if (mock_config.partial > 0 && length > 0) {nanosleep(&pause, NULL);}
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Writes a formatted reply                                      *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int mock_sendf(mock_client_t *client, const char *format, ...)
+{
+
+	// Declare Variables
+	char    reply[MAX_LENGTH_MOCK_REQUEST];
+	va_list args;
+	int     length;
+
+	va_start(args, format);
+	length = vsnprintf(reply, sizeof(reply), format, args);
+	va_end(args);
+
+	if (length < 0 || (size_t)length >= sizeof(reply)) {return 1;}
+
+	return mock_send(client, reply, (size_t)length);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will send the canned INFO text, keeping only    *
+ *              the requested section as Redis does                           *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int mock_send_info(mock_client_t *client, const char *text, const char *section)
+{
+
+	// Declare Variables
+	char       *info, *header;
+	const char *line, *end;
+	size_t      length = 0, line_length;
+	int         include = 1, ret;
+
+	if ((info = malloc(strlen(text) * 2 + 64)) == NULL) {return 1;}
+
+	// Every section of the default INFO
+	if (section != NULL && (strcasecmp(section, "all") == 0 || strcasecmp(section, "default") == 0 || strcasecmp(section, "everything") == 0)) {section = NULL;}
+
+	for (line = text; *line != '\0'; line = *end ? end + 1 : end) {
+
+		if ((end = strchr(line, '\n')) == NULL) {end = line + strlen(line);}
+
+		line_length = end - line;
+
+		if (line_length > 0 && line[line_length - 1] == '\r') {line_length--;}
+		if (line_length == 0) {continue;}
+
+		// A section header ("# Replication")
+		if (line[0] == '#') {
+
+			for (header = (char *)line + 1; *header == ' '; header++);
+
+			include = section == NULL || (strncasecmp(header, section, line_length - (header - line)) == 0 && strlen(section) == line_length - (size_t)(header - line));
+
+			if (include && length > 0) {memcpy(info + length, "\r\n", 2); length += 2;}
+
+		}
+
+		if (!include) {continue;}
+
+		memcpy(info + length, line, line_length);
+		length += line_length;
+		memcpy(info + length, "\r\n", 2);
+		length += 2;
+
+	}
+
+	ret = mock_sendf(client, "$%zu\r\n", length) || mock_send(client, info, length) || mock_send(client, "\r\n", 2);
+
+	free(info);
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Counts a command received                                     *
+ * Returns    : Sequence number of the command                                *
+ *                                                                            *
+ ******************************************************************************/
+static unsigned long mock_count(mock_client_t *client, const char *command)
+{
+
+	// Declare Variables
+	unsigned long sequence;
+	int           count;
+
+	pthread_mutex_lock(&mock_lock);
+
+	sequence = ++mock_commands;
+	mock_count_commands++;
+
+	for (count = 0; count < mock_counters_count; count++) {if (strcasecmp(mock_counters[count].name, command) == 0) {break;}}
+
+	if (count == mock_counters_count && count < MAX_MOCK_COMMANDS) {
+
+		snprintf(mock_counters[count].name, MAX_LENGTH_MOCK_NAME, "%s", command);
+		mock_counters_count++;
+
+	}
+
+	if (count < mock_counters_count) {mock_counters[count].count++;}
+
+	if (++client->commands > mock_connection_max) {mock_connection_max = client->commands;}
+
+	pthread_mutex_unlock(&mock_lock);
+
+	return sequence;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Sleeps for the injected latency and jitter                    *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void mock_delay(unsigned int *seed)
+{
+
+	// Declare Variables
+	struct timespec delay;
+	int             ms = mock_config.latency;
+
+	if (mock_config.jitter > 0) {ms += rand_r(seed) % (mock_config.jitter + 1);}
+
+	if (ms <= 0) {return;}
+
+	delay.tv_sec  = ms / 1000;
+	delay.tv_nsec = (ms % 1000) * 1000000L;
+
+	while (nanosleep(&delay, &delay) != 0 && errno == EINTR);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will answer one command                         *
+ * Returns    : 0 (continue), 1 (close the connection)                        *
+ *                                                                            *
+ ******************************************************************************/
+static int mock_command(mock_client_t *client, int argc, char **argv, unsigned int *seed)
+{
+
+	// Declare Variables
+	mock_reply_t   *reply;
+	struct timespec now;
+	char            discard[4096];
+	unsigned long   sequence;
+	int             count;
+
+	// The bench reads and resets the counters between items
+	if (strcasecmp(argv[0], "MOCK") == 0) {
+
+		pthread_mutex_lock(&mock_lock);
+
+		if (argc == 2 && strcasecmp(argv[1], "RESET") == 0) {
+
+			mock_count_commands = mock_count_connections = 0;
+			pthread_mutex_unlock(&mock_lock);
+
+			return mock_send(client, "+OK\r\n", 5);
+
+		}
+
+		if (argc == 2 && strcasecmp(argv[1], "COUNT") == 0) {
+
+			count = mock_sendf(client, "*2\r\n:%lu\r\n:%lu\r\n", mock_count_commands, mock_count_connections);
+			pthread_mutex_unlock(&mock_lock);
+
+			return count;
+
+		}
+
+		pthread_mutex_unlock(&mock_lock);
+
+		return mock_send(client, "-ERR MOCK COUNT or MOCK RESET\r\n", 31);
+
+	}
+
+	sequence = mock_count(client, argv[0]);
+
+	// Injected disconnect
+	if (mock_config.disconnect > 0 && sequence % mock_config.disconnect == 0) {
+
+		if (mock_config.verbose) {fprintf(stderr, "%s: Disconnecting connection %lu on %s\n", MOCK, client->id, argv[0]);}
+
+		return 1;
+
+	}
+
+	// Injected stall (never reply, wait for the client to give up)
+	if (mock_config.stall > 0 && sequence % mock_config.stall == 0) {
+
+		if (mock_config.verbose) {fprintf(stderr, "%s: Stalling connection %lu on %s\n", MOCK, client->id, argv[0]);}
+
+		while (!mock_stop && read(client->fd, discard, sizeof(discard)) > 0);
+
+		return 1;
+
+	}
+
+	mock_delay(seed);
+
+	// Authentication
+	if (strcasecmp(argv[0], "AUTH") == 0) {
+
+		if (mock_config.password == NULL) {return mock_sendf(client, "-ERR Client sent AUTH, but no password is set\r\n");}
+
+		if (strcmp(argv[argc - 1], mock_config.password) != 0) {return mock_sendf(client, "-WRONGPASS invalid username-password pair\r\n");}
+
+		client->authenticated = 1;
+
+		return mock_send(client, "+OK\r\n", 5);
+
+	}
+
+	if (strcasecmp(argv[0], "QUIT") == 0) {mock_send(client, "+OK\r\n", 5); return 1;}
+
+	if (mock_config.password != NULL && !client->authenticated) {return mock_sendf(client, "-NOAUTH Authentication required.\r\n");}
+
+	// Canned replies
+	if ((reply = mock_reply_command(argc, argv)) != NULL && !(reply->text != NULL && strcmp(reply->name, "info") == 0)) {return mock_send(client, reply->data, reply->length);}
+
+	if (reply != NULL) {return mock_send_info(client, reply->text, argc > 1 ? argv[1] : NULL);}
+
+	// Built in replies
+	if (strcasecmp(argv[0], "PING") == 0) {
+
+		if (argc > 1) {return mock_sendf(client, "$%zu\r\n%s\r\n", strlen(argv[1]), argv[1]);}
+
+		return mock_send(client, "+PONG\r\n", 7);
+
+	}
+
+	if (strcasecmp(argv[0], "ECHO") == 0 && argc == 2) {return mock_sendf(client, "$%zu\r\n%s\r\n", strlen(argv[1]), argv[1]);}
+
+	if (strcasecmp(argv[0], "SELECT") == 0 || (strcasecmp(argv[0], "CLIENT") == 0 && argc > 1 && strcasecmp(argv[1], "SETNAME") == 0)) {return mock_send(client, "+OK\r\n", 5);}
+
+	if (strcasecmp(argv[0], "TIME") == 0) {
+
+		clock_gettime(CLOCK_REALTIME, &now);
+
+		return mock_sendf(client, "*2\r\n$%d\r\n%ld\r\n$%d\r\n%ld\r\n", snprintf(NULL, 0, "%ld", (long)now.tv_sec), (long)now.tv_sec,
+			snprintf(NULL, 0, "%ld", now.tv_nsec / 1000), now.tv_nsec / 1000);
+
+	}
+
+	if (strcasecmp(argv[0], "COMMAND") == 0 && argc > 2 && strcasecmp(argv[1], "INFO") == 0) {
+
+		if (mock_sendf(client, "*%d\r\n", argc - 2)) {return 1;}
+
+		for (count = 2; count < argc; count++) {
+
+			if (!mock_command_supported(argv[count])) {if (mock_send(client, "$-1\r\n", 5)) {return 1;} continue;}
+
+			if (mock_sendf(client, "*6\r\n$%zu\r\n%s\r\n:-1\r\n*0\r\n:0\r\n:0\r\n:0\r\n", strlen(argv[count]), argv[count])) {return 1;}
+
+		}
+
+		return 0;
+
+	}
+
+	// Unknown (including HELLO, so the module falls back to RESP2)
+	return mock_sendf(client, "-ERR unknown command '%s'\r\n", argv[0]);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will parse one command (RESP multibulk or       *
+ *              inline) from the start of the buffer into argv                *
+ * Returns    : Bytes consumed, 0 (incomplete), -1 (protocol error)           *
+ *                                                                            *
+ ******************************************************************************/
+static int mock_parse(const char *buffer, size_t length, char *args, char **argv, int *argc)
+{
+
+	// Declare Variables
+	const char *p = buffer, *end = buffer + length, *line;
+	char       *arg = args;
+	long        count, size;
+	int         element;
+
+	*argc = 0;
+
+	// Inline command
+	if (length > 0 && buffer[0] != '*') {
+
+		if ((line = memchr(buffer, '\n', length)) == NULL) {return 0;}
+
+		while (p < line) {
+
+			while (p < line && isspace((unsigned char)*p)) {p++;}
+
+			if (p == line) {break;}
+			if (*argc == MAX_MOCK_ARGS) {return -1;}
+
+			argv[(*argc)++] = arg;
+
+			while (p < line && !isspace((unsigned char)*p)) {*arg++ = *p++;}
+
+			*arg++ = '\0';
+
+		}
+
+		return (int)(line - buffer + 1);
+
+	}
+
+	// Multibulk header
+	if ((line = memchr(p, '\n', end - p)) == NULL) {return 0;}
+
+	count = strtol(p + 1, NULL, 10);
+
+	if (count < 1 || count > MAX_MOCK_ARGS) {return -1;}
+
+	p = line + 1;
+
+	for (element = 0; element < count; element++) {
+
+		if (p >= end) {return 0;}
+		if (*p != '$') {return -1;}
+		if ((line = memchr(p, '\n', end - p)) == NULL) {return 0;}
+
+		size = strtol(p + 1, NULL, 10);
+
+		if (size < 0 || size > MAX_LENGTH_MOCK_REQUEST) {return -1;}
+
+		p = line + 1;
+
+		if (end - p < size + 2) {return 0;}
+
+		argv[element] = arg;
+		memcpy(arg, p, size);
+		arg += size;
+		*arg++ = '\0';
+
+		p += size + 2;
+
+	}
+
+	*argc = (int)count;
+
+	return (int)(p - buffer);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will serve one client connection               *
+ * Returns    : NULL                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void *mock_client(void *arg)
+{
+
+	// Declare Variables
+	mock_client_t *client = arg;
+	char           buffer[MAX_LENGTH_MOCK_REQUEST], args[MAX_LENGTH_MOCK_REQUEST];
+	char          *argv[MAX_MOCK_ARGS];
+	size_t         length = 0;
+	ssize_t        received;
+	unsigned int   seed = (unsigned int)client->id;
+	int            argc, consumed;
+
+	while (!mock_stop) {
+
+		if ((received = read(client->fd, buffer + length, sizeof(buffer) - length)) <= 0) {
+
+			if (received < 0 && errno == EINTR) {continue;}
+
+			goto close;
+
+		}
+
+		length += received;
+
+		// Answer every complete command in the buffer
+		while (length > 0) {
+
+			if ((consumed = mock_parse(buffer, length, args, argv, &argc)) < 0) {
+
+				mock_sendf(client, "-ERR Protocol error\r\n");
+				goto close;
+
+			}
+
+			if (consumed == 0) {break;}
+
+			if (argc > 0 && mock_command(client, argc, argv, &seed)) {goto close;}
+
+			memmove(buffer, buffer + consumed, length - consumed);
+			length -= consumed;
+
+		}
+
+		// A command larger than the buffer
+		if (length == sizeof(buffer)) {
+
+			mock_sendf(client, "-ERR Protocol error: too big request\r\n");
+			goto close;
+
+		}
+
+	}
+
+close:
+
+	if (mock_config.verbose) {fprintf(stderr, "%s: Connection %lu closed after %lu commands\n", MOCK, client->id, client->commands);}
+
+	close(client->fd);
+	free(client);
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Prints the commands received                                  *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void mock_report()
+{
+
+	// Declare Variables
+	int count;
+
+	pthread_mutex_lock(&mock_lock);
+
+	printf("%lu connections, %lu commands, %.2f commands per connection (max %lu)\n", mock_connections, mock_commands,
+		mock_connections ? (double)mock_commands / mock_connections : 0.0, mock_connection_max);
+
+	for (count = 0; count < mock_counters_count; count++) {printf("  %-24s %lu\n", mock_counters[count].name, mock_counters[count].count);}
+
+	pthread_mutex_unlock(&mock_lock);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Stops the mock on SIGINT and SIGTERM                          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void mock_signal(int signal)
+{
+
+	mock_stop = signal;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Prints the usage                                              *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void mock_usage()
+{
+
+	fprintf(stderr,
+		"Usage: %s [-b bind] [-p port] [-r replies] [-a password] [-L ms] [-J ms] [-P bytes] [-D n] [-S n] [-v]\n"
+		"  -b  Address to listen on (default %s)\n"
+		"  -p  Port to listen on (default %d)\n"
+		"  -r  Directory of canned replies (default %s)\n"
+		"  -a  Password required by AUTH\n"
+		"  -L  Latency added to every reply in milliseconds\n"
+		"  -J  Random jitter added to the latency in milliseconds\n"
+		"  -P  Send replies in chunks of this many bytes (partial reads)\n"
+		"  -D  Disconnect instead of answering every n-th command\n"
+		"  -S  Stall instead of answering every n-th command\n"
+		"  -v  Log connections and injected faults\n",
+		MOCK, DEFAULT_MOCK_BIND, DEFAULT_MOCK_PORT, DEFAULT_MOCK_REPLIES);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will load the canned replies and serve clients  *
+ *              until interrupted, then print the commands received           *
+ * Returns    : EXIT_SUCCESS or EXIT_FAILURE                                  *
+ *                                                                            *
+ ******************************************************************************/
+int main(int argc, char **argv)
+{
+
+	// Declare Variables
+	const char        *bind_address = DEFAULT_MOCK_BIND, *replies = DEFAULT_MOCK_REPLIES;
+	int                port = DEFAULT_MOCK_PORT, option, listener, fd, on = 1;
+	struct sockaddr_in address;
+	struct sigaction   action;
+	struct pollfd      pfd;
+	pthread_t          thread;
+	pthread_attr_t     attr;
+	mock_client_t     *client;
+
+	memset(&mock_config, 0, sizeof(mock_config));
+
+	while ((option = getopt(argc, argv, "b:p:r:a:L:J:P:D:S:v")) != -1) {
+
+		switch (option) {
+			case 'b': bind_address = optarg; break;
+			case 'p': port = atoi(optarg); break;
+			case 'r': replies = optarg; break;
+			case 'a': mock_config.password = optarg; break;
+			case 'L': mock_config.latency = atoi(optarg); break;
+			case 'J': mock_config.jitter = atoi(optarg); break;
+			case 'P': mock_config.partial = atoi(optarg); break;
+			case 'D': mock_config.disconnect = atoi(optarg); break;
+			case 'S': mock_config.stall = atoi(optarg); break;
+			case 'v': mock_config.verbose = 1; break;
+			default: mock_usage(); return EXIT_FAILURE;
+		}
+
+	}
+
+	if (optind != argc || port < 1 || port > 65535 || mock_config.latency < 0 || mock_config.latency > MAX_MOCK_DELAY
+		|| mock_config.jitter < 0 || mock_config.jitter > MAX_MOCK_DELAY || mock_config.partial < 0 || mock_config.disconnect < 0 || mock_config.stall < 0) {
+
+		mock_usage();
+		return EXIT_FAILURE;
+
+	}
+
+	if (mock_replies_load(replies)) {return EXIT_FAILURE;}
+
+	// Stop on SIGINT and SIGTERM (without SA_RESTART, so poll returns)
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = mock_signal;
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGTERM, &action, NULL);
+	signal(SIGPIPE, SIG_IGN);
+
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port   = htons((unsigned short)port);
+
+	if (inet_pton(AF_INET, bind_address, &address.sin_addr) != 1) {
+
+		fprintf(stderr, "%s: Invalid bind address %s\n", MOCK, bind_address);
+		return EXIT_FAILURE;
+
+	}
+
+	if ((listener = socket(AF_INET, SOCK_STREAM, 0)) < 0 || setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0
+		|| bind(listener, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listener, 128) < 0) {
+
+		fprintf(stderr, "%s: Unable to listen on %s:%d (%s)\n", MOCK, bind_address, port, strerror(errno));
+		return EXIT_FAILURE;
+
+	}
+
+	fprintf(stderr, "%s: Listening on %s:%d with %d replies from %s\n", MOCK, bind_address, port, mock_replies_count, replies);
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+	pfd.fd     = listener;
+	pfd.events = POLLIN;
+
+	// Serve every connection on its own thread
+	while (!mock_stop) {
+
+		if (poll(&pfd, 1, 200) <= 0) {continue;}
+
+		if ((fd = accept(listener, NULL, NULL)) < 0) {continue;}
+
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+		if ((client = calloc(1, sizeof(mock_client_t))) == NULL) {close(fd); continue;}
+
+		pthread_mutex_lock(&mock_lock);
+		client->id = ++mock_connections;
+		mock_count_connections++;
+		pthread_mutex_unlock(&mock_lock);
+
+		client->fd = fd;
+
+		if (pthread_create(&thread, &attr, mock_client, client) != 0) {close(fd); free(client);}
+
+	}
+
+	close(listener);
+	mock_report();
+
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,96 @@
+/*
+**
+** libzbxredis - A Redis monitoring module for Zabbix
+** Copyright (C) 2016 - James Cook <james.cook000@gmail.com>
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+*/
+
+#ifndef ZBXREDIS_MOCK_H
+#define ZBXREDIS_MOCK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+// Default mock name
+#define MOCK "zbxredis_mock"
+
+// Define max lengths
+#define MAX_LENGTH_MOCK_REQUEST 65536
+#define MAX_LENGTH_MOCK_NAME 255
+#define MAX_LENGTH_MOCK_PATH 4096
+
+// Default values
+#define DEFAULT_MOCK_BIND "127.0.0.1"
+#define DEFAULT_MOCK_PORT 6390
+#define DEFAULT_MOCK_REPLIES "bench/replies/6.2"
+
+// Mock limits
+#define MAX_MOCK_ARGS 64
+#define MAX_MOCK_REPLIES 256
+#define MAX_MOCK_COMMANDS 64
+#define MAX_MOCK_DELAY 60000
+
+// Define a canned reply (replies/<command>_<arg>.resp is sent as is, .txt as a bulk string)
+typedef struct mock_reply {
+	char    name[MAX_LENGTH_MOCK_NAME];
+	char   *text;
+	char   *data;
+	size_t  length;
+} mock_reply_t;
+
+// Define the injected faults
+typedef struct mock_config {
+	const char *password;
+	int         latency;
+	int         jitter;
+	int         partial;
+	int         disconnect;
+	int         stall;
+	int         verbose;
+} mock_config_t;
+
+// Define a client connection
+typedef struct mock_client {
+	int           fd;
+	unsigned long id;
+	unsigned long commands;
+	int           authenticated;
+} mock_client_t;
+
+// Define the command counters
+typedef struct mock_counter {
+	char          name[MAX_LENGTH_MOCK_NAME];
+	unsigned long count;
+} mock_counter_t;
+
+#endif
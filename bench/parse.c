@@ -0,0 +1,489 @@
+/*
+**
+** libzbxredis - A Redis monitoring module for Zabbix
+** Copyright (C) 2016 - James Cook <james.cook000@gmail.com>
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+*/
+
+// Include bench and module headers
+#include "bench.h"
+#include "libzbxredis.h"
+
+// Parsers of the module under test
+static int              (*parse_info_value)(char *, char *, char *);
+static int              (*parse_get_value)(char *, char *, char *, char *);
+static void             (*parse_clients)(redis_clients_t *, char *);
+static void             (*parse_clients_clear)(redis_clients_t *);
+static redis_client_t * (*parse_clients_find)(redis_clients_t *, char *);
+static char *           (*parse_client_field)(redis_client_t *, char *);
+static void             (*parse_arena_reset)();
+
+// Modules built before the request arena have nothing to release between lookups
+static void parse_arena_none() {}
+
+// CLIENT LIST sizes benchmarked (scaled up from the 100 client capture)
+static const int parse_client_sizes[] = {100, 10000, 100000};
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Reads a corpus file, converting line feeds to CRLF as Redis   *
+ *              sends INFO                                                    *
+ * Returns    : Contents or NULL                                              *
+ *                                                                            *
+ ******************************************************************************/
+static char *parse_corpus_read(const char *path, int crlf, size_t *length)
+{
+
+	// Declare Variables
+	FILE   *file;
+	char   *text = NULL;
+	size_t  allocated = 0, used = 0;
+	int     c;
+
+	if ((file = fopen(path, "r")) == NULL) {
+
+		fprintf(stderr, "%s: Unable to open corpus %s (%s)\n", BENCH, path, strerror(errno));
+		return NULL;
+
+	}
+
+	while ((c = fgetc(file)) != EOF) {
+
+		if (used + 3 > allocated) {allocated = allocated ? allocated * 2 : 65536; text = zbx_realloc(text, allocated);}
+
+		if (crlf && c == '\n') {text[used++] = '\r';}
+
+		text[used++] = (char)c;
+
+	}
+
+	fclose(file);
+
+	if (text == NULL) {text = zbx_malloc(NULL, 1);}
+
+	text[used] = '\0';
+	*length = used;
+
+	return text;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Prints one result line                                        *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void parse_report(const char *corpus, const char *test, unsigned long long operations, unsigned long long bytes, unsigned long long elapsed)
+{
+
+	printf("%-24s %-20s %12llu %12.1f", corpus, test, operations, operations ? (double)elapsed / operations : 0.0);
+
+	// Lookups have no throughput
+	if (bytes > 0 && elapsed > 0) {printf(" %10.1f\n", bytes / (elapsed / 1e9) / 1e6);}
+	else {printf(" %10s\n", "-");}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will look up every field of an INFO reply       *
+ *              through redis_info_value, and every sub field of the multi    *
+ *              value lines (db0:keys=...) through redis_get_value            *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int parse_info(const char *directory, const char *name, int repeat)
+{
+
+	// Declare Variables
+	char                path[MAX_LENGTH_BENCH_LINE], value[MAX_LENGTH_KEY];
+	char               *text, *copy, *line, *end, *colon, *sub, *sub_end;
+	char               *fields[MAX_PARSE_FIELDS], *lines[MAX_PARSE_FIELDS], *data[MAX_PARSE_FIELDS];
+	char               *subfields[MAX_PARSE_FIELDS], *subdata[MAX_PARSE_FIELDS], *subline[MAX_PARSE_FIELDS];
+	size_t              length, scanned[MAX_PARSE_FIELDS];
+	unsigned long long  start, lookups, copies, bytes = 0;
+	int                 field_count = 0, line_count = 0, sub_count = 0, count, iteration, ret = 1;
+
+	zbx_snprintf(path, sizeof(path), "%s/%s", directory, name);
+
+	if ((text = parse_corpus_read(path, 1, &length)) == NULL) {return 1;}
+
+	copy = zbx_malloc(NULL, length + 1);
+
+	// Collect the single value fields, and the sub fields of multi value lines (db0:keys=1,expires=0)
+	for (line = text; *line != '\0' && field_count < MAX_PARSE_FIELDS; line = end + (*end != '\0')) {
+
+		if ((end = strchr(line, '\n')) == NULL) {end = line + strlen(line);}
+
+		if (*line == '#' || (colon = memchr(line, ':', end - line)) == NULL) {continue;}
+
+		fields[field_count] = zbx_malloc(NULL, colon - line + 1);
+		zbx_strlcpy(fields[field_count], line, colon - line + 1);
+
+		if (memchr(colon, '=', end - colon) == NULL) {scanned[field_count++] = end - text; continue;}
+
+		// The data of the multi value line
+		data[line_count] = zbx_malloc(NULL, end - colon);
+		zbx_strlcpy(data[line_count], colon + 1, end - colon);
+		if ((sub_end = strchr(data[line_count], '\r')) != NULL) {*sub_end = '\0';}
+
+		// Every field=value of the data
+		for (sub = data[line_count]; sub != NULL && sub_count < MAX_PARSE_FIELDS; sub = (sub_end = strchr(sub, ',')) != NULL ? sub_end + 1 : NULL) {
+
+			if ((colon = strchr(sub, '=')) == NULL || ((sub_end = strchr(sub, ',')) != NULL && sub_end < colon)) {continue;}
+
+			subfields[sub_count] = zbx_malloc(NULL, colon - sub + 1);
+			zbx_strlcpy(subfields[sub_count], sub, colon - sub + 1);
+			subline[sub_count]  = fields[field_count];
+			subdata[sub_count++] = data[line_count];
+
+		}
+
+		// The line name is kept for the sub field lookups
+		lines[line_count++] = fields[field_count];
+
+	}
+
+	// Check every field is found before timing
+	for (count = 0; count < field_count; count++) {
+
+		memcpy(copy, text, length + 1);
+
+		if (parse_info_value(copy, fields[count], value)) {
+
+			parse_arena_reset();
+
+			fprintf(stderr, "%s: %s field %s not found\n", BENCH, name, fields[count]);
+			goto out;
+
+		}
+
+		bytes += scanned[count];
+
+		parse_arena_reset();
+
+	}
+
+	// Time the copies alone, as redis_info_value splits the reply in place
+	start = bench_clock();
+	for (iteration = 0; iteration < repeat; iteration++) {for (count = 0; count < field_count; count++) {memcpy(copy, text, length + 1);}}
+	copies = bench_clock() - start;
+
+	start = bench_clock();
+	for (iteration = 0; iteration < repeat; iteration++) {for (count = 0; count < field_count; count++) {memcpy(copy, text, length + 1); parse_info_value(copy, fields[count], value); parse_arena_reset();}}
+	lookups = bench_clock() - start;
+
+	parse_report(name, "info.field", (unsigned long long)repeat * field_count, bytes * repeat, lookups > copies ? lookups - copies : 0);
+
+	// Multi value lookups
+	if (sub_count > 0) {
+
+		for (bytes = 0, count = 0; count < sub_count; count++) {bytes += strlen(subdata[count]);}
+
+		start = bench_clock();
+		for (iteration = 0; iteration < repeat * 10; iteration++) {for (count = 0; count < sub_count; count++) {parse_get_value(subline[count], subdata[count], subfields[count], value); parse_arena_reset();}}
+		lookups = bench_clock() - start;
+
+		parse_report(name, "info.multi_value", (unsigned long long)repeat * 10 * sub_count, bytes * repeat * 10, lookups);
+
+	}
+
+	ret = 0;
+
+out:
+
+	for (count = 0; count < field_count; count++) {zbx_free(fields[count]);}
+	for (count = 0; count < line_count; count++) {zbx_free(lines[count]); zbx_free(data[count]);}
+	for (count = 0; count < sub_count; count++) {zbx_free(subfields[count]);}
+
+	zbx_free(copy);
+	zbx_free(text);
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will scale the 100 client capture up to a       *
+ *              number of clients, giving every client a unique addr          *
+ * Returns    : CLIENT LIST text                                              *
+ *                                                                            *
+ ******************************************************************************/
+static char *parse_clients_scale(const char *capture, int clients, size_t *length)
+{
+
+	// Declare Variables
+	const char *line, *end, *addr, *port, *rest;
+	char       *text;
+	size_t      allocated = strlen(capture) * (clients / 100 + 1) + (size_t)clients * 32, used = 0;
+	int         count = 0, replica;
+
+	text = zbx_malloc(NULL, allocated);
+
+	for (replica = 0; count < clients; replica++) {
+
+		for (line = capture; *line != '\0' && count < clients; line = end + 1, count++) {
+
+			if ((end = strchr(line, '\n')) == NULL) {break;}
+
+			// Rewrite the id and addr fields
+			if ((addr = strstr(line, " addr=")) == NULL || addr > end || (rest = strchr(addr + 1, ' ')) == NULL || rest > end) {count--; continue;}
+			for (port = rest; port > addr && *port != ':'; port--);
+
+			used += zbx_snprintf(text + used, allocated - used, "id=%d addr=10.%d.%d.%d%.*s", count + 1, (replica >> 8) & 255, replica & 255,
+				(int)(count % 100) + 1, (int)(rest - port), port);
+
+			memcpy(text + used, rest, end - rest + 1);
+			used += end - rest + 1;
+
+		}
+
+	}
+
+	text[used] = '\0';
+	*length = used;
+
+	return text;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will parse CLIENT LIST at every size, then look *
+ *              up every client by addr and read one of its fields            *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int parse_client_list(const char *directory, int repeat)
+{
+
+	// Declare Variables
+	redis_clients_t     clients;
+	redis_client_t     *client;
+	char                path[MAX_LENGTH_BENCH_LINE], corpus[MAX_LENGTH_STRING];
+	char               *capture, *text, **addrs;
+	size_t              capture_length, length;
+	unsigned long long  start, elapsed;
+	int                 size, count, iteration, iterations, ret = 1;
+
+	zbx_snprintf(path, sizeof(path), "%s/client-list-100.txt", directory);
+
+	if ((capture = parse_corpus_read(path, 0, &capture_length)) == NULL) {return 1;}
+
+	memset(&clients, 0, sizeof(clients));
+
+	for (size = 0; size < (int)ARRSIZE(parse_client_sizes); size++) {
+
+		text = parse_clients_scale(capture, parse_client_sizes[size], &length);
+		zbx_snprintf(corpus, sizeof(corpus), "client-list-%d", parse_client_sizes[size]);
+
+		// Parse a similar number of clients at every size
+		iterations = repeat * 100 / parse_client_sizes[size] + 1;
+
+		start = bench_clock();
+		for (iteration = 0; iteration < iterations; iteration++) {parse_clients(&clients, text); parse_clients_clear(&clients);}
+		elapsed = bench_clock() - start;
+
+		parse_report(corpus, "clients.parse", (unsigned long long)iterations * parse_client_sizes[size], (unsigned long long)iterations * length, elapsed);
+
+		// Look up every client by addr, as redis.client.info does
+		parse_clients(&clients, text);
+
+		if (clients.client_count != parse_client_sizes[size]) {
+
+			fprintf(stderr, "%s: %s parsed %d clients\n", BENCH, corpus, clients.client_count);
+			parse_clients_clear(&clients);
+			zbx_free(text);
+			goto out;
+
+		}
+
+		addrs = zbx_malloc(NULL, sizeof(char *) * clients.client_count);
+
+		for (count = 0; count < clients.client_count; count++) {addrs[count] = zbx_strdup(NULL, clients.clients[count].addr);}
+
+		start = bench_clock();
+
+		for (iteration = 0; iteration < iterations; iteration++) {
+
+			for (count = 0; count < clients.client_count; count++) {
+
+				if ((client = parse_clients_find(&clients, addrs[count])) == NULL || parse_client_field(client, "cmd") == NULL) {
+
+					fprintf(stderr, "%s: %s client %s not found\n", BENCH, corpus, addrs[count]);
+					break;
+
+				}
+
+			}
+
+		}
+
+		elapsed = bench_clock() - start;
+
+		parse_report(corpus, "clients.lookup", (unsigned long long)iterations * clients.client_count, 0, elapsed);
+
+		for (count = 0; count < clients.client_count; count++) {zbx_free(addrs[count]);}
+
+		zbx_free(addrs);
+		parse_clients_clear(&clients);
+		zbx_free(text);
+
+	}
+
+	ret = 0;
+
+out:
+
+	zbx_free(capture);
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Selects the INFO files of the corpus for scandir              *
+ * Returns    : 1 (INFO corpus file), 0 (other)                               *
+ *                                                                            *
+ ******************************************************************************/
+static int parse_info_filter(const struct dirent *entry)
+{
+
+	return strncmp(entry->d_name, "info-", 5) == 0 && strstr(entry->d_name, ".txt") != NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Prints the usage                                              *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void parse_usage()
+{
+
+	fprintf(stderr,
+		"Usage: zbxredis_parse [-m module] [-d corpus] [-n repeat]\n"
+		"  -m  Module to load (default %s)\n"
+		"  -d  Corpus directory (default %s)\n"
+		"  -n  Repetitions of every lookup (default %d)\n",
+		DEFAULT_BENCH_MODULE, DEFAULT_PARSE_CORPUS, DEFAULT_PARSE_REPEAT);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will load the module and run its parsers over   *
+ *              the corpus, reporting ns per operation and MB/s               *
+ * Returns    : EXIT_SUCCESS or EXIT_FAILURE                                  *
+ *                                                                            *
+ ******************************************************************************/
+int main(int argc, char **argv)
+{
+
+	// Declare Variables
+	const char     *module = DEFAULT_BENCH_MODULE, *directory = DEFAULT_PARSE_CORPUS;
+	int             repeat = DEFAULT_PARSE_REPEAT, option, count, files, ret = EXIT_FAILURE;
+	struct dirent **entries = NULL;
+	void           *handle;
+	int           (*module_init)();
+	int           (*module_uninit)();
+
+	while ((option = getopt(argc, argv, "m:d:n:")) != -1) {
+
+		switch (option) {
+			case 'm': module = optarg; break;
+			case 'd': directory = optarg; break;
+			case 'n': repeat = atoi(optarg); break;
+			default: parse_usage(); return EXIT_FAILURE;
+		}
+
+	}
+
+	if (optind != argc || repeat < 1 || repeat > MAX_PARSE_REPEAT) {parse_usage(); return EXIT_FAILURE;}
+
+	// Load the module against the Zabbix symbols exported by the bench
+	if ((handle = dlopen(module, RTLD_NOW)) == NULL) {
+
+		fprintf(stderr, "%s: Unable to load module %s (%s)\n", BENCH, module, dlerror());
+		return EXIT_FAILURE;
+
+	}
+
+	*(void **)&module_init         = dlsym(handle, "zbx_module_init");
+	*(void **)&module_uninit       = dlsym(handle, "zbx_module_uninit");
+	*(void **)&parse_info_value    = dlsym(handle, "redis_info_value");
+	*(void **)&parse_get_value     = dlsym(handle, "redis_get_value");
+	*(void **)&parse_clients       = dlsym(handle, "redis_clients_parse");
+	*(void **)&parse_clients_clear = dlsym(handle, "redis_clients_clear");
+	*(void **)&parse_clients_find  = dlsym(handle, "redis_clients_find");
+	*(void **)&parse_client_field  = dlsym(handle, "redis_client_field");
+	*(void **)&parse_arena_reset   = dlsym(handle, "redis_arena_reset");
+
+	if (parse_arena_reset == NULL) {parse_arena_reset = parse_arena_none;}
+
+	if (module_init == NULL || parse_info_value == NULL || parse_get_value == NULL || parse_clients == NULL || parse_clients_clear == NULL
+		|| parse_clients_find == NULL || parse_client_field == NULL) {
+
+		fprintf(stderr, "%s: Module %s does not export the parsers\n", BENCH, module);
+		goto unload;
+
+	}
+
+	// Initialise the module
+	if (module_init() != ZBX_MODULE_OK) {
+
+		fprintf(stderr, "%s: Module %s failed to initialise\n", BENCH, module);
+		goto unload;
+
+	}
+
+	if ((files = scandir(directory, &entries, parse_info_filter, alphasort)) < 0) {
+
+		fprintf(stderr, "%s: Unable to read corpus %s (%s)\n", BENCH, directory, strerror(errno));
+		goto uninit;
+
+	}
+
+	printf("%-24s %-20s %12s %12s %10s\n", "corpus", "test", "operations", "ns/op", "MB/s");
+
+	for (ret = EXIT_SUCCESS, count = 0; count < files; count++) {
+
+		if (parse_info(directory, entries[count]->d_name, repeat)) {ret = EXIT_FAILURE;}
+
+		free(entries[count]);
+
+	}
+
+	free(entries);
+
+	if (parse_client_list(directory, repeat)) {ret = EXIT_FAILURE;}
+
+uninit:
+
+	if (module_uninit != NULL) {module_uninit();}
+
+unload:
+
+	dlclose(handle);
+
+	return ret;
+
+}
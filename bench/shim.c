@@ -0,0 +1,385 @@
+/*
+**
+** libzbxredis - A Redis monitoring module for Zabbix
+** Copyright (C) 2016 - James Cook <james.cook000@gmail.com>
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+*/
+
+/*
+** The module resolves these Zabbix symbols from zabbix_agentd at load time.
+** The bench exports its own versions of them so the module can be loaded
+** without an agent. They are declared through the Zabbix headers, so the
+** names follow whichever Zabbix version the bench is built against.
+** Helpers shared by the bench programs live here too.
+*/
+
+// Include bench header
+#include "bench.h"
+
+// Log level of the shimmed zabbix_log
+int bench_log_level = LOG_LEVEL_CRIT;
+
+// Zabbix 4.0+ checks the log level in the zabbix_log macro
+#ifdef ZBX_CHECK_LOG_LEVEL
+int zbx_log_level = LOG_LEVEL_CRIT;
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Returns a monotonic clock in nanoseconds                      *
+ * Returns    : Nanoseconds                                                   *
+ *                                                                            *
+ ******************************************************************************/
+unsigned long long bench_clock()
+{
+
+	// Declare Variables
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Writes a module log message to stderr                         *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void __zbx_zabbix_log(int level, const char *fmt, ...)
+{
+
+	// Declare Variables
+	va_list args;
+
+	// Only log messages at or below the bench log level (information once verbose)
+	if (level == LOG_LEVEL_INFORMATION ? bench_log_level < LOG_LEVEL_WARNING : level > bench_log_level) {return;}
+
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+
+	fputc('\n', stderr);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Formats a string into a fixed buffer                          *
+ * Returns    : Length written                                                *
+ *                                                                            *
+ ******************************************************************************/
+size_t zbx_snprintf(char *str, size_t count, const char *fmt, ...)
+{
+
+	// Declare Variables
+	va_list args;
+	int     length;
+
+	if (count == 0) {return 0;}
+
+	va_start(args, fmt);
+	length = vsnprintf(str, count, fmt, args);
+	va_end(args);
+
+	// Set return
+	if (length < 0) {str[0] = '\0'; return 0;}
+
+	return (size_t)length < count ? (size_t)length : count - 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Copies a string into a fixed buffer                           *
+ * Returns    : Length of the source string                                   *
+ *                                                                            *
+ ******************************************************************************/
+size_t zbx_strlcpy(char *dst, const char *src, size_t siz)
+{
+
+	// Declare Variables
+	size_t length = strlen(src);
+
+	if (siz == 0) {return length;}
+
+	if (length < siz) {memcpy(dst, src, length + 1);}
+	else {memcpy(dst, src, siz - 1); dst[siz - 1] = '\0';}
+
+	return length;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Allocates memory, aborting when out of memory                 *
+ * Returns    : Allocated memory                                              *
+ *                                                                            *
+ ******************************************************************************/
+void *zbx_malloc2(const char *filename, int line, void *old, size_t size)
+{
+
+	// Declare Variables
+	void *ptr;
+
+	if ((ptr = malloc(size ? size : 1)) == NULL) {
+
+		fprintf(stderr, "%s: Out of memory at [%s:%d]\n", BENCH, filename, line);
+		exit(EXIT_FAILURE);
+
+	}
+
+	return ptr;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Reallocates memory, aborting when out of memory               *
+ * Returns    : Reallocated memory                                            *
+ *                                                                            *
+ ******************************************************************************/
+void *zbx_realloc2(const char *filename, int line, void *old, size_t size)
+{
+
+	// Declare Variables
+	void *ptr;
+
+	if ((ptr = realloc(old, size ? size : 1)) == NULL) {
+
+		fprintf(stderr, "%s: Out of memory at [%s:%d]\n", BENCH, filename, line);
+		exit(EXIT_FAILURE);
+
+	}
+
+	return ptr;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Duplicates a string, freeing the old one                      *
+ * Returns    : Duplicated string                                             *
+ *                                                                            *
+ ******************************************************************************/
+char *zbx_strdup2(const char *filename, int line, char *old, const char *str)
+{
+
+	// Declare Variables
+	char   *ptr;
+	size_t  length = strlen(str);
+
+	free(old);
+
+	ptr = zbx_malloc2(filename, line, NULL, length + 1);
+	memcpy(ptr, str, length + 1);
+
+	return ptr;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Inserts text at the JSON write offset, ahead of the closing   *
+ *              brackets that keep the buffer valid JSON at all times         *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_json_insert(struct zbx_json *j, const char *text, size_t length)
+{
+
+	// Grow the buffer
+	if (j->buffer_size + length + 1 > j->buffer_allocated) {
+
+		while (j->buffer_size + length + 1 > j->buffer_allocated) {j->buffer_allocated *= 2;}
+
+		j->buffer = zbx_realloc(j->buffer, j->buffer_allocated);
+
+	}
+
+	memmove(j->buffer + j->buffer_offset + length, j->buffer + j->buffer_offset, j->buffer_size - j->buffer_offset + 1);
+	memcpy(j->buffer + j->buffer_offset, text, length);
+
+	j->buffer_size   += length;
+	j->buffer_offset += length;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Inserts a quoted and escaped JSON string                      *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_json_quote(struct zbx_json *j, const char *value)
+{
+
+	// Declare Variables
+	char escape[8];
+
+	bench_json_insert(j, "\"", 1);
+
+	for (; *value != '\0'; value++) {
+
+		switch (*value) {
+
+			case '"':  bench_json_insert(j, "\\\"", 2); break;
+			case '\\': bench_json_insert(j, "\\\\", 2); break;
+			case '\n': bench_json_insert(j, "\\n", 2); break;
+			case '\r': bench_json_insert(j, "\\r", 2); break;
+			case '\t': bench_json_insert(j, "\\t", 2); break;
+			default:
+
+				if ((unsigned char)*value < 0x20) {
+
+					snprintf(escape, sizeof(escape), "\\u%04x", (unsigned char)*value);
+					bench_json_insert(j, escape, 6);
+
+				} else {bench_json_insert(j, value, 1);}
+
+		}
+
+	}
+
+	bench_json_insert(j, "\"", 1);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Inserts the separator and name ahead of a JSON value          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void bench_json_name(struct zbx_json *j, const char *name)
+{
+
+	if (j->status == ZBX_JSON_COMMA) {bench_json_insert(j, ",", 1);}
+
+	if (name != NULL) {bench_json_quote(j, name); bench_json_insert(j, ":", 1);}
+
+	j->status = ZBX_JSON_COMMA;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Initialises a JSON object                                     *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void zbx_json_init(struct zbx_json *j, size_t allocate)
+{
+
+	j->buffer_allocated = allocate > 16 ? allocate : 16;
+	j->buffer           = zbx_malloc(NULL, j->buffer_allocated);
+
+	strcpy(j->buffer, "{}");
+
+	j->buffer_size   = 2;
+	j->buffer_offset = 1;
+	j->status        = ZBX_JSON_EMPTY;
+	j->level         = 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Opens a named (or anonymous) object                           *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void zbx_json_addobject(struct zbx_json *j, const char *name)
+{
+
+	bench_json_name(j, name);
+	bench_json_insert(j, "{}", 2);
+
+	j->buffer_offset--;
+	j->status = ZBX_JSON_EMPTY;
+	j->level++;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Opens a named (or anonymous) array                            *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void zbx_json_addarray(struct zbx_json *j, const char *name)
+{
+
+	bench_json_name(j, name);
+	bench_json_insert(j, "[]", 2);
+
+	j->buffer_offset--;
+	j->status = ZBX_JSON_EMPTY;
+	j->level++;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Adds a named value of the given type                          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void zbx_json_addstring(struct zbx_json *j, const char *name, const char *string, zbx_json_type_t type)
+{
+
+	bench_json_name(j, name);
+
+	if (string == NULL || type == ZBX_JSON_TYPE_NULL) {bench_json_insert(j, "null", 4);}
+	else if (type == ZBX_JSON_TYPE_STRING) {bench_json_quote(j, string);}
+	else {bench_json_insert(j, string, strlen(string));}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Closes the innermost open object or array                     *
+ * Returns    : SUCCEED or FAIL (only the outer object is open)               *
+ *                                                                            *
+ ******************************************************************************/
+int zbx_json_close(struct zbx_json *j)
+{
+
+	if (j->level == 1) {return FAIL;}
+
+	j->buffer_offset++;
+	j->status = ZBX_JSON_COMMA;
+	j->level--;
+
+	return SUCCEED;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Frees a JSON object                                           *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void zbx_json_free(struct zbx_json *j)
+{
+
+	zbx_free(j->buffer);
+
+}
@@ -33,6 +33,7 @@ static ZBX_METRIC keys[] =
 {
 	// Redis Item Keys
 	{"libzbxredis.version",			0,		libzbxredis_version,			NULL},
+	{"libzbxredis.stats",			CF_HAVEPARAMS,	libzbxredis_stats,			"calls"},
 	{"redis.session.status",		CF_HAVEPARAMS,	redis_session_status,			",,,,"},
 	{"redis.session.duration",		CF_HAVEPARAMS,	redis_session_duration,			",,,,"},
 	{"redis.command.supported",		CF_HAVEPARAMS,	redis_command_supported,		",,,,,PING"},
@@ -42,6 +43,7 @@ static ZBX_METRIC keys[] =
 	{"redis.database.info",			CF_HAVEPARAMS,	redis_database_info,			",,,,,string,db0,keys,"},
 	{"redis.slave.discovery",		CF_HAVEPARAMS,	redis_slave_discovery,			",,,,"},
 	{"redis.slave.info",			CF_HAVEPARAMS,	redis_slave_info,			",,,,,string,slave0,ip,"},
+	{"redis.replication.lag",		CF_HAVEPARAMS,	redis_replication_lag,			",,,,127.0.0.1:6380,bytes"},
 	{"redis.ping",				CF_HAVEPARAMS,	redis_ping,				",,,,"},
 	{"redis.time",				CF_HAVEPARAMS,	redis_time,				",,,,"},
 	{"redis.lastsave",			CF_HAVEPARAMS,	redis_lastsave,				",,,,"},
@@ -49,8 +51,14 @@ static ZBX_METRIC keys[] =
 	{"redis.keyspace.hit.ratio",		CF_HAVEPARAMS,	redis_keyspace_hit_ratio,		",,,,"},
 	{"redis.slowlog.length",		CF_HAVEPARAMS,	redis_slowlog_length,			",,,,"},
 	{"redis.config",			CF_HAVEPARAMS,	redis_config,				",,,,string,logfile,"},
-	{"redis.client.discovery",		CF_HAVEPARAMS,	redis_client_discovery,			",,,,"},
+	{"redis.memory.stats",			CF_HAVEPARAMS,	redis_memory_stats,			",,,,integer,dataset.bytes,"},
+	{"redis.memory.doctor",			CF_HAVEPARAMS,	redis_memory_doctor,			",,,"},
+	{"redis.keys.bigkeys",			CF_HAVEPARAMS,	redis_keys_bigkeys,			",,,,0,,,"},
+	{"redis.keys.ttl.histogram",		CF_HAVEPARAMS,	redis_keys_ttl_histogram,		",,,,0,,"},
+	{"redis.client.discovery",		CF_HAVEPARAMS,	redis_client_discovery,			",,,,,,,,"},
 	{"redis.client.info",			CF_HAVEPARAMS,	redis_client_info,			",,,,,string,clientname,addr"},
+	{"redis.client.group.discovery",	CF_HAVEPARAMS,	redis_client_group_discovery,		",,,,name"},
+	{"redis.client.aggregate",		CF_HAVEPARAMS,	redis_client_aggregate,			",,,,all,,count"},
 	{"redis.key.exists",			CF_HAVEPARAMS,	redis_key_exists,			",,,,,key-a"},
 	{"redis.key.ttl",			CF_HAVEPARAMS,	redis_key_ttl,				",,,,,key-a"},
 	{"redis.key.pttl",			CF_HAVEPARAMS,	redis_key_pttl,				",,,,,key-a"},
@@ -67,17 +75,159 @@ static ZBX_METRIC keys[] =
 	{"redis.key.list.exists",		CF_HAVEPARAMS,	redis_key_list_exists,			",,,,,key-a"},
 	{"redis.key.list.get",			CF_HAVEPARAMS,	redis_key_list_get,			",,,,,key-a,element-a,"},
 	{"redis.key.list.length",		CF_HAVEPARAMS,	redis_key_list_length,			",,,,,key-a"},
+	{"redis.key.set.count",			CF_HAVEPARAMS,	redis_key_set_count,			",,,,,key-a"},
+	{"redis.key.zset.count",		CF_HAVEPARAMS,	redis_key_zset_count,			",,,,,key-a"},
+	{"redis.key.zset.range.count",		CF_HAVEPARAMS,	redis_key_zset_range_count,		",,,,,key-a,-inf,+inf"},
+	{"redis.key.stream.length",		CF_HAVEPARAMS,	redis_key_stream_length,		",,,,,key-a"},
+	{"redis.key.mget",			CF_HAVEPARAMS,	redis_key_mget,				",,,,0,key-a|key-b"},
+	{"redis.key.hash.mget",			CF_HAVEPARAMS,	redis_key_hash_mget,			",,,,0,key-a,field-a|field-b"},
+	{"redis.key.hash.json",			CF_HAVEPARAMS,	redis_key_hash_json,			",,,,0,key-a,"},
+	{"redis.stream.group.discovery",	CF_HAVEPARAMS,	redis_stream_group_discovery,		",,,,0,key-a"},
+	{"redis.stream.group.info",		CF_HAVEPARAMS,	redis_stream_group_info,		",,,,0,integer,key-a,group-a,lag,"},
+	{"redis.stream.consumer.discovery",	CF_HAVEPARAMS,	redis_stream_consumer_discovery,	",,,,0,key-a"},
+	{"redis.stream.consumer.info",		CF_HAVEPARAMS,	redis_stream_consumer_info,		",,,,0,integer,key-a,group-a,consumer-a,idle,"},
+	{"redis.pubsub.channel.discovery",	CF_HAVEPARAMS,	redis_pubsub_channel_discovery,		",,,,*"},
+	{"redis.pubsub.channel.subscribers",	CF_HAVEPARAMS,	redis_pubsub_channel_subscribers,	",,,,channel-a,*"},
+	{"redis.pubsub.channel.count",		CF_HAVEPARAMS,	redis_pubsub_channel_count,		",,,,*"},
+	{"redis.pubsub.patterns",		CF_HAVEPARAMS,	redis_pubsub_patterns,			",,,"},
+	{"redis.events.rate",			CF_HAVEPARAMS,	redis_events_rate,			",,,,expired,"},
+	{"redis.events.count",			CF_HAVEPARAMS,	redis_events_count,			",,,,expired,"},
 
 	// Null terminator
 	{NULL}
 };
 
-// Define compiled regular expressions
-regex_t regexCompiled_INFO;
-regex_t regexCompiled_INFO_MULTI_VALUE;
-regex_t regexCompiled_INFO_SINGLE_VALUE;
-regex_t regexCompiled_INFO_SLAVE;
-regex_t regexCompiled_INFO_DATABASE;
+// Define sentinel master cache (one entry per sentinel target)
+typedef struct {
+	char          target[MAX_LENGTH_PARAM];
+	char          master_host[MAX_LENGTH_STRING];
+	char          master_port[MAX_LENGTH_PARAM];
+	redisContext *subscription;
+} redis_sentinel_t;
+
+static redis_sentinel_t redis_sentinels[MAX_SENTINEL_TARGETS];
+static int              redis_sentinels_next = 0;
+static pthread_mutex_t  redis_sentinels_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Define module statistics (shared with the forked agent processes, every key is dispatched through redis_stats_dispatch)
+typedef struct {
+	const char   *name;
+	size_t        offset;
+} redis_stats_metric_t;
+
+static redis_stats_t                redis_stats_local;
+static redis_stats_t               *redis_stats = &redis_stats_local;
+static int                        (*redis_stats_handlers[MAX_STATS_KEYS])();
+static int                          redis_stats_index[STATS_INDEX_SIZE];
+static const unsigned long long     redis_stats_bounds[STATS_LATENCY_BUCKETS - 1] = {1000, 10000, 100000, 1000000, 10000000};
+static redisReplyObjectFunctions   *redis_stats_reader = NULL;
+static redisReplyObjectFunctions    redis_stats_functions;
+static pthread_mutex_t              redis_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+#ifdef HAVE_REDIS_CONTEXT_FUNCS
+static const redisContextFuncs     *redis_stats_io = NULL;
+static redisContextFuncs            redis_stats_funcs;
+#endif
+
+static const redis_stats_metric_t redis_stats_globals[] = {
+	{"sessions",		offsetof(redis_stats_t, sessions)},
+	{"session.errors",	offsetof(redis_stats_t, session_errors)},
+	{"session.time",	offsetof(redis_stats_t, session_time)},
+	{"commands",		offsetof(redis_stats_t, commands)},
+	{"replies",		offsetof(redis_stats_t, replies)},
+	{"bytes.read",		offsetof(redis_stats_t, bytes_read)},
+	{"bytes.written",	offsetof(redis_stats_t, bytes_written)},
+	{"io.time",		offsetof(redis_stats_t, io_time)},
+	{"cache.hits",		offsetof(redis_stats_t, cache_hits)},
+	{"cache.misses",	offsetof(redis_stats_t, cache_misses)},
+	{"breaker.opens",	offsetof(redis_stats_t, breaker_opens)},
+	{"breaker.rejects",	offsetof(redis_stats_t, breaker_rejects)},
+	{"resolves",		offsetof(redis_stats_t, resolves)},
+	{"resolve.errors",	offsetof(redis_stats_t, resolve_errors)},
+	{"resolve.time",	offsetof(redis_stats_t, resolve_time)}
+};
+
+static const redis_stats_metric_t redis_stats_key_metrics[] = {
+	{"calls",		offsetof(redis_stats_key_t, calls)},
+	{"errors",		offsetof(redis_stats_key_t, errors)},
+	{"time",		offsetof(redis_stats_key_t, time)},
+	{"latency.1ms",		offsetof(redis_stats_key_t, latency[0])},
+	{"latency.10ms",	offsetof(redis_stats_key_t, latency[1])},
+	{"latency.100ms",	offsetof(redis_stats_key_t, latency[2])},
+	{"latency.1s",		offsetof(redis_stats_key_t, latency[3])},
+	{"latency.10s",		offsetof(redis_stats_key_t, latency[4])},
+	{"latency.inf",		offsetof(redis_stats_key_t, latency[5])}
+};
+
+#define REDIS_STATS_ADD(field, value) __atomic_add_fetch(&redis_stats->field,(value),__ATOMIC_RELAXED)
+
+// Define named targets (loaded from the module configuration, indexed by name)
+static redis_target_t redis_targets[MAX_TARGETS];
+static int            redis_targets_count = 0;
+static int            redis_targets_index[TARGET_INDEX_SIZE];
+
+// Define reply cache (one entry per server, port and command, an entry may own replies to further commands about
+// every element of its reply so that they are evicted together)
+typedef struct {
+	char          target[MAX_LENGTH_KEY];
+	time_t        expires;
+	redisReply   *reply;
+	redisReply  **children;
+	size_t        child_count;
+} redis_cache_t;
+
+static redis_cache_t redis_cache[MAX_CACHE_ENTRIES];
+static int           redis_cache_next = 0;
+
+// Define big key sampler states (shared with the forked agent processes, guarded by a robust mutex)
+static redis_bigkeys_table_t  redis_bigkeys_local = {.lock = PTHREAD_MUTEX_INITIALIZER};
+static redis_bigkeys_table_t *redis_bigkeys = &redis_bigkeys_local;
+
+// Define SCAN cursors of incremental samplers (shared with the forked agent processes, guarded by a robust mutex)
+static redis_scan_cursors_t  redis_scan_cursors_local = {.lock = PTHREAD_MUTEX_INITIALIZER};
+static redis_scan_cursors_t *redis_scan_cursors = &redis_scan_cursors_local;
+
+// Define client tables (one entry per server and port)
+static redis_clients_t redis_clients[MAX_CLIENT_TABLES];
+static int             redis_clients_next = 0;
+
+// Define delimiter scanning (the delimiter class of every byte)
+static const unsigned char  redis_scan_classes[256] = {['\n'] = SCAN_NEWLINE, ['\r'] = SCAN_RETURN, [':'] = SCAN_COLON, ['='] = SCAN_EQUALS, [','] = SCAN_COMMA, [' '] = SCAN_SPACE};
+
+// Define client aggregates (one entry per server and port)
+static redis_client_summary_t redis_client_summaries[MAX_CLIENT_TABLES];
+static int                    redis_client_summaries_next = 0;
+
+// Define replication states (shared with the forked agent processes so the offset samples are too, guarded by a robust mutex)
+static redis_replications_t  redis_replications_local = {.lock = PTHREAD_MUTEX_INITIALIZER};
+static redis_replications_t *redis_replications = &redis_replications_local;
+
+// Define keyspace event listeners (the counters are shared with forked agent processes, the threads and subscriptions are not,
+// the subscriptions are published by the listeners so that a process forked while subscribed closes its copy)
+static redis_events_t   *redis_events = NULL;
+static int               redis_events_targets = 0;
+static int               redis_events_stop = 0;
+static pid_t             redis_events_owner = 0;
+static pthread_t         redis_events_threads[MAX_EVENT_TARGETS];
+static int               redis_events_started[MAX_EVENT_TARGETS];
+static redisContext     *redis_events_subscriptions[MAX_EVENT_TARGETS];
+static const char       *redis_event_names[EVENT_TYPES] = {"expired", "evicted", "set"};
+
+// Define request arena of this thread (reset by redis_stats_dispatch once a handler returns)
+static __thread redis_arena_block_t *redis_arena_first = NULL;
+static __thread redis_arena_block_t *redis_arena_last = NULL;
+
+// Define servers that have refused HELLO 3 (host:port), so that RESP3 is not offered to them again
+static char             redis_hello_unsupported[MAX_HELLO_TARGETS][MAX_LENGTH_STRING];
+static int              redis_hello_unsupported_next = 0;
+static pthread_mutex_t  redis_hello_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Define circuit breakers (shared with the forked agent processes, guarded by a robust mutex)
+static redis_breakers_t  redis_breakers_local = {.lock = PTHREAD_MUTEX_INITIALIZER};
+static redis_breakers_t *redis_breakers = &redis_breakers_local;
+
+// Define host resolution cache (shared with the forked agent processes, guarded by a robust mutex)
+static redis_resolves_t  redis_resolves_local = {.lock = PTHREAD_MUTEX_INITIALIZER};
+static redis_resolves_t *redis_resolves = &redis_resolves_local;
 
 /******************************************************************************
  *                                                                            *
@@ -104,55 +254,36 @@ int zbx_module_init() {
 	// log version on startup
 	zabbix_log(LOG_LEVEL_INFORMATION,"Module (%s): Initialising",MODULE);
 
-	// Compile regular expression and fail if so
-	if (regcomp(&regexCompiled_INFO,REGEX_MATCH_INFO,REG_EXTENDED)) {
-
-		// Log message
-		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Compile regular expression failed ([%s])",MODULE,REGEX_MATCH_INFO);
-
-		return ZBX_MODULE_FAIL;
-
-	}
-
-	// Compile regular expression and fail if so
-	if (regcomp(&regexCompiled_INFO_DATABASE,REGEX_MATCH_INFO_DATABASE,REG_EXTENDED)) {
-
-		// Log message
-		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Compile regular expression failed ([%s])",MODULE,REGEX_MATCH_INFO_DATABASE);
-
-		return ZBX_MODULE_FAIL;
+	// Dispatch every key through the module statistics
+	redis_stats_start();
 
-	}
+	// Share the circuit breakers of unreachable targets between the agent processes
+	redis_breakers_start();
 
-	// Compile regular expression and fail if so
-	if (regcomp(&regexCompiled_INFO_MULTI_VALUE,REGEX_MATCH_INFO_MULTI_VALUE,REG_EXTENDED)) {
+	// Share the addresses of resolved host names between the agent processes
+	redis_resolves_start();
 
-		// Log message
-		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Compile regular expression failed ([%s])",MODULE,REGEX_MATCH_INFO_MULTI_VALUE);
+	// Share the big key sampler states between the agent processes
+	redis_bigkeys_start();
 
-		return ZBX_MODULE_FAIL;
+	// Share the SCAN cursors of the incremental samplers between the agent processes
+	redis_scan_cursors_start();
 
-	}
+	// Share the replication offset samples between the agent processes
+	redis_replications_start();
 
-	// Compile regular expression and fail if so
-	if (regcomp(&regexCompiled_INFO_SINGLE_VALUE,REGEX_MATCH_INFO_SINGLE_VALUE,REG_EXTENDED)) {
+	// Load any named targets (a failure to read the configuration fails the module)
+	if (redis_targets_load()) {
 
 		// Log message
-		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Compile regular expression failed ([%s])",MODULE,REGEX_MATCH_INFO_SINGLE_VALUE);
+		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Configuration file could not be read",MODULE);
 
 		return ZBX_MODULE_FAIL;
 
 	}
 
-	// Compile regular expression and fail if so
-	if (regcomp(&regexCompiled_INFO_SLAVE,REGEX_MATCH_INFO_SLAVE,REG_EXTENDED)) {
-
-		// Log message
-		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Compile regular expression failed ([%s])",MODULE,REGEX_MATCH_INFO_SLAVE);
-
-		return ZBX_MODULE_FAIL;
-
-	}
+	// Start any keyspace event listeners (a failure only disables the event keys)
+	redis_events_start();
 
 	// Return success
 	return ZBX_MODULE_OK;
@@ -167,12 +298,38 @@ int zbx_module_init() {
  ******************************************************************************/
 int zbx_module_uninit() { 
 
-	// Free compiled regex
-	regfree(&regexCompiled_INFO);
-	regfree(&regexCompiled_INFO_DATABASE);
-	regfree(&regexCompiled_INFO_MULTI_VALUE);
-	regfree(&regexCompiled_INFO_SINGLE_VALUE);
-	regfree(&regexCompiled_INFO_SLAVE);
+	// Close any sentinel subscriptions
+	redis_sentinel_free();
+
+	// Free any cached replies
+	redis_cache_free();
+
+	// Free any big key sampler states
+	redis_bigkeys_free();
+
+	// Free any SCAN cursors
+	redis_scan_cursors_free();
+
+	// Free any replication states
+	redis_replications_free();
+
+	// Free any client tables
+	redis_clients_free();
+
+	// Stop any keyspace event listeners
+	redis_events_free();
+
+	// Free the circuit breakers
+	redis_breakers_free();
+
+	// Free the host resolution cache
+	redis_resolves_free();
+
+	// Free the module statistics
+	redis_stats_free();
+
+	// Free the request arena
+	redis_arena_free();
 
 	// log version on startup
 	zabbix_log(LOG_LEVEL_INFORMATION,"Module (%s): Uninitialising",MODULE);
@@ -208,52 +365,216 @@ ZBX_METRIC *zbx_module_item_list() {
 
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will take memory from the request arena of the  *
+ *              thread (the memory lasts until the handler returns)           *
+ * Returns    : Memory                                                        *
+ *                                                                            *
+ ******************************************************************************/
+void * redis_arena_alloc(size_t size)
+{
+
+	// Declare Variables
+	redis_arena_block_t *block;
+	size_t               block_size;
+	char                *memory;
+
+	// Align the size
+	size = (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+
+	// If the last block is full then chain another
+	if (redis_arena_last == NULL || redis_arena_last->used + size > redis_arena_last->size) {
+
+		block_size = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE;
+
+		block       = zbx_malloc(NULL, sizeof(redis_arena_block_t) + block_size);
+		block->next = NULL;
+		block->size = block_size;
+		block->used = 0;
+
+		if (redis_arena_first == NULL) {redis_arena_first = block;} else {redis_arena_last->next = block;}
+
+		redis_arena_last = block;
+
+	}
+
+	// Take the memory
+	memory = (char *)(redis_arena_last + 1) + redis_arena_last->used;
+
+	redis_arena_last->used += size;
+
+	return memory;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : These functions will copy text into the request arena         *
+ * Returns    : Terminated copy                                               *
+ *                                                                            *
+ ******************************************************************************/
+char * redis_arena_slice(const char *text, size_t length)
+{
+
+	// Declare Variables
+	char *copy = redis_arena_alloc(length + 1);
+
+	memcpy(copy, text, length);
+	copy[length] = '\0';
+
+	return copy;
+
+}
+
+char * redis_arena_strdup(const char *text)
+{
+
+	return redis_arena_slice(text, strlen(text));
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will take an empty string with room for length  *
+ *              characters from the request arena                             *
+ * Returns    : Empty string                                                  *
+ *                                                                            *
+ ******************************************************************************/
+char * redis_arena_string(size_t length)
+{
+
+	// Declare Variables
+	char *text = redis_arena_alloc(length + 1);
+
+	*text = '\0';
+
+	return text;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will format a message into the request arena    *
+ * Returns    : Message                                                       *
+ *                                                                            *
+ ******************************************************************************/
+char * redis_arena_printf(const char *format, ...)
+{
+
+	// Declare Variables
+	va_list  args;
+	int      length;
+	char    *text;
+
+	// Measure the message
+	va_start(args, format);
+	length = vsnprintf(NULL, 0, format, args);
+	va_end(args);
+
+	if (length < 0) {length = 0;}
+
+	// Format the message
+	text = redis_arena_alloc(length + 1);
+
+	va_start(args, format);
+	vsnprintf(text, length + 1, format, args);
+	va_end(args);
+
+	return text;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will release everything taken from the request  *
+ *              arena (the first block is kept for the next request)          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_arena_reset()
+{
+
+	// Declare Variables
+	redis_arena_block_t *block, *next;
+
+	if (redis_arena_first == NULL) {return;}
+
+	// Free the chained blocks
+	for (block = redis_arena_first->next; block != NULL; block = next) {
+
+		next = block->next;
+		zbx_free(block);
+
+	}
+
+	redis_arena_first->next = NULL;
+	redis_arena_first->used = 0;
+	redis_arena_last        = redis_arena_first;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the request arena of the thread       *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_arena_free()
+{
+
+	redis_arena_reset();
+
+	zbx_free(redis_arena_first);
+
+	redis_arena_last = NULL;
+
+}
+
 /********************************************************************************************************
  *                                                                                                      *
  * Function   : This function will construct a complete zabbix key including parameters from a request  *
- * Returns    : 0 (success), 1 (failure)                                                                *
+ *              in the request arena                                                                    *
+ * Returns    : Zabbix key                                                                              *
  *                                                                                                      *
  ********************************************************************************************************/
-int zbx_key_gen(AGENT_REQUEST *request, char *zbx_key)
+char * zbx_key_gen(AGENT_REQUEST *request)
 {
 
 	// Declare Variables
-	int count = 0;
-
-	// Initialise string
-	zbx_strlcpy(zbx_key,"",sizeof(zbx_key));
+	int     count = 0;
+	size_t  length;
+	char   *zbx_key, *next;
 
-	// Append keyname
-	strcat(zbx_key,request->key);
+	// Measure the key (name[param,param])
+	length = strlen(request->key);
 
-	// Ammend params if present
-	if(request->nparam) {
+	for (count = 0; count < request->nparam; count++) {length += strlen(request->params[count]) + 1;}
 
-		// Open the parameters
-		strcat(zbx_key,"[");
+	if (request->nparam) {length++;}
 
-		// For every parameter
-		for(count=0;count<request->nparam;count++) {
+	next = zbx_key = redis_arena_alloc(length + 1);
 
-			// If there are more parameters then append a comma
-			if(count) {
+	// Append keyname
+	next = stpcpy(next,request->key);
 
-				strcat(zbx_key,",");
+	// Ammend params if present
+	for (count = 0; count < request->nparam; count++) {
 
-			}
+		// Open the parameters or separate them with a comma
+		*next++ = (count) ? ',' : '[';
 
-			// Append the parameter
-			strcat(zbx_key,request->params[count]);
+		// Append the parameter
+		next = stpcpy(next,request->params[count]);
 
-		}
+	}
 
-		// Close the parameters
-		strcat(zbx_key,"]");
+	// Close the parameters
+	if (request->nparam) {*next++ = ']';}
 
-	}
+	*next = '\0';
 
-	// Return success
-	return 0;
+	return zbx_key;
 
 }
 
@@ -276,7 +597,7 @@ int zbx_ret_fail(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, c
        	SET_MSG_RESULT(result,strdup(zbx_msg));
 
 	// If the reply needs to be cleaned up
-	if (redisR != NULL) {freeReplyObject(redisR);}
+	if (redisR != NULL) {redis_reply_free(redisR);}
 
 	// Return success
 	return 0;
@@ -302,7 +623,7 @@ int zbx_ret_string(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key,
 	SET_STR_RESULT(result,zbx_strdup(NULL,value));
 
 	// If the reply needs to be cleaned up
-	if (redisR != NULL) {freeReplyObject(redisR);}
+	if (redisR != NULL) {redis_reply_free(redisR);}
 
 	// Return success
 	return 0;
@@ -318,11 +639,11 @@ int zbx_ret_string(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key,
 int zbx_ret_string_convert(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, char *value, char *datatype, redisReply *redisR)
 {
 
-	// For integer keys
-	if (strcmp(datatype,"integer") == 0) {zbx_ret_integer(result, ret, log_level, zbx_key, atoi(value), redisR);}
+	// For integer keys (parsed as 64 bit to avoid truncating large counters)
+	if (strcmp(datatype,"integer") == 0) {zbx_ret_integer(result, ret, log_level, zbx_key, strtoull(value,NULL,10), redisR);}
 
 	// For double keys
-	if (strcmp(datatype,"float") == 0) {zbx_ret_float(result, ret, log_level, zbx_key, atof(value), redisR);}
+	if (strcmp(datatype,"float") == 0) {zbx_ret_float(result, ret, log_level, zbx_key, strtod(value,NULL), redisR);}
 
 	// For string keys
 	if (strcmp(datatype,"string") == 0) {zbx_ret_string(result, ret, log_level, zbx_key, value, redisR);}
@@ -335,6 +656,61 @@ int zbx_ret_string_convert(AGENT_RESULT *result, int *ret, int log_level, char *
 
 }
 
+/*************************************************************
+ *                                                           *
+ * Function   : This function will set the return and log    *
+ *              from a reply element, using the native type  *
+ *              of integer and double replies                *
+ * Returns    : 0 (success), 1 (failure)                     *
+ *                                                           *
+ *************************************************************/
+int zbx_ret_reply_convert(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, redisReply *value, char *datatype, redisReply *redisR)
+{
+
+	// Declare Variables
+	char value_text[MAX_LENGTH_STRING];
+
+	// For integer replies
+	if (value->type == REDIS_REPLY_INTEGER) {
+
+		// Set return without a string round trip
+		if (strcmp(datatype,"integer") == 0) {return zbx_ret_integer(result, ret, log_level, zbx_key, value->integer, redisR);}
+		if (strcmp(datatype,"float") == 0)   {return zbx_ret_float(result, ret, log_level, zbx_key, (double)value->integer, redisR);}
+
+		// Form the text
+		zbx_snprintf(value_text,MAX_LENGTH_STRING,"%lld",value->integer);
+
+		return zbx_ret_string(result, ret, log_level, zbx_key, value_text, redisR);
+
+	}
+
+#ifdef HAVE_REDIS_RESP3
+
+	// For double replies (RESP3)
+	if (value->type == REDIS_REPLY_DOUBLE) {
+
+		// If the double can not be held by an unsigned 64 bit integer (negative, out of range, infinite or NaN all fail the test)
+		if (strcmp(datatype,"integer") == 0 && ! (value->dval >= 0 && value->dval < 18446744073709551616.0)) {return zbx_ret_fail(result, ret, log_level, zbx_key, "Redis value is not an unsigned integer", redisR);}
+
+		// Set return without a string round trip
+		if (strcmp(datatype,"integer") == 0) {return zbx_ret_integer(result, ret, log_level, zbx_key, (unsigned long long)value->dval, redisR);}
+		if (strcmp(datatype,"float") == 0)   {return zbx_ret_float(result, ret, log_level, zbx_key, value->dval, redisR);}
+
+	}
+
+	// For boolean replies (RESP3)
+	if (value->type == REDIS_REPLY_BOOL) {return zbx_ret_string_convert(result, ret, log_level, zbx_key, value->integer ? "1" : "0", datatype, redisR);}
+
+#endif
+
+	// For nil replies
+	if (value->type == REDIS_REPLY_NIL || value->str == NULL) {return zbx_ret_fail(result, ret, log_level, zbx_key, "Redis value does not exist", redisR);}
+
+	// For string replies
+	return zbx_ret_string_convert(result, ret, log_level, zbx_key, value->str, datatype, redisR);
+
+}
+
 /*************************************************************
  *                                                           *
  * Function   : This function will set the return and log    *
@@ -354,7 +730,7 @@ int zbx_ret_text(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, c
 	SET_STR_RESULT(result,zbx_strdup(NULL,value));
 
 	// If the reply needs to be cleaned up
-	if (redisR != NULL) {freeReplyObject(redisR);}
+	if (redisR != NULL) {redis_reply_free(redisR);}
 
 	// Return success
 	return 0;
@@ -380,7 +756,7 @@ int zbx_ret_integer(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key
 	SET_UI64_RESULT(result,value);
 
 	// If the reply needs to be cleaned up
-	if (redisR != NULL) {freeReplyObject(redisR);}
+	if (redisR != NULL) {redis_reply_free(redisR);}
 
 	// Return success
 	return 0;
@@ -393,7 +769,7 @@ int zbx_ret_integer(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key
  * Returns    : 0 (success), 1 (failure)                     *
  *                                                           *
  *************************************************************/
-int zbx_ret_float(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, float value, redisReply *redisR)
+int zbx_ret_float(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, double value, redisReply *redisR)
 {
 
 	// Set return
@@ -406,7 +782,7 @@ int zbx_ret_float(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key,
 	SET_DBL_RESULT(result,value);
 
 	// If the reply needs to be cleaned up
-	if (redisR != NULL) {freeReplyObject(redisR);}
+	if (redisR != NULL) {redis_reply_free(redisR);}
 
 	// Return success
 	return 0;
@@ -427,7 +803,6 @@ int libzbxredis_version(AGENT_REQUEST *request, AGENT_RESULT *result)
 	// Declare Variables
 	int         ret = SYSINFO_RET_FAIL;
 	const char  *__function_name = "libzbxredis_version";
-	char         zbx_msg[MAX_LENGTH_MSG] = "";
 
 	// Log message 
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
@@ -445,369 +820,5790 @@ int libzbxredis_version(AGENT_REQUEST *request, AGENT_RESULT *result)
 
 }
 
-/*************************************************************
- *                                                           *
- * Function   : This function will validate standard params  *
- * Returns    : 0 (valid), 1 (invalid)                       *
- *                                                           *
- *************************************************************/
-int validate_param_count(AGENT_RESULT *result, char *zbx_key, int param_count, int nparam, char *condition)
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get a monotonic clock in microseconds      *
+ * Returns    : Microseconds                                                  *
+ *                                                                            *
+ ******************************************************************************/
+unsigned long long redis_stats_clock()
 {
 
-	// Declar variables
-	char zbx_msg[MAX_LENGTH_MSG] = "";
+	// Declare Variables
+	struct timespec now;
 
-	// If the condition is !=
-	if (strcmp(condition,"!=") == 0 && param_count != nparam) {
+	clock_gettime(CLOCK_MONOTONIC, &now);
 
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Invalid parameter count specified, expected %d received %d",param_count,nparam);
+	return (unsigned long long)now.tv_sec * 1000000 + now.tv_nsec / 1000;
 
-		goto param_count_invalid;
+}
 
-	}
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the index of a key in the key list    *
+ * Returns    : Index (success), -1 (failure)                                 *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_stats_key(const char *key)
+{
 
-param_count_valid:
+	// Declare Variables
+	unsigned int slot;
+	int          count;
 
-	return 0;
+	slot = redis_hash(key, strlen(key)) % STATS_INDEX_SIZE;
 
-param_count_invalid:
+	for (count = 0; count < STATS_INDEX_SIZE && redis_stats_index[slot] != 0; count++, slot = (slot + 1) % STATS_INDEX_SIZE) {
 
-        // Log message
-        zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+		if (strcmp(keys[redis_stats_index[slot] - 1].key,key) == 0) {return redis_stats_index[slot] - 1;}
 
-        // Set message
-        SET_MSG_RESULT(result,strdup(zbx_msg));
+	}
 
-	return 1;
+	return -1;
 
 }
 
-/*************************************************************
- *                                                           *
- * Function   : This function will validate standard params  *
- * Returns    : 0 (valid), 1 (invalid)                       *
- *                                                           *
- *************************************************************/
-int validate_param(AGENT_RESULT *result,char *zbx_key, char *param, char *value, char *value_default, int allow_empty, int min, int max)
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will run the handler of a key and count its     *
+ *              calls, errors and latency (every key is dispatched through    *
+ *              here once redis_stats_start has run)                          *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_stats_dispatch(AGENT_REQUEST *request, AGENT_RESULT *result)
 {
 
-	// Declare variables
-	char zbx_msg[MAX_LENGTH_MSG] = "";
+	// Declare Variables
+	int                 index, ret, bucket;
+	unsigned long long  started, elapsed;
+	redis_stats_key_t  *stats;
 
-	// If the value is empty and there is a default value
-	if (strlen(value) == 0 && strlen(value_default) > 0) {
+	// If the key is not known (the agent only calls listed keys)
+	if ((index = redis_stats_key(request->key)) == -1) {return SYSINFO_RET_FAIL;}
 
-		// Set the value to default
-		zbx_strlcpy(value,value_default,MAX_LENGTH_PARAM);
+	// Run the handler
+	started = redis_stats_clock();
+	ret     = redis_stats_handlers[index](request, result);
+	elapsed = redis_stats_clock() - started;
 
-	}
+	// Release the keys, messages and fields the handler took from the request arena
+	redis_arena_reset();
 
-	// If the value is empty and thats not allowed
-	if (strlen(value) == 0 && ! allow_empty) {
+	// Find the latency bucket
+	for (bucket = 0; bucket < STATS_LATENCY_BUCKETS - 1 && elapsed > redis_stats_bounds[bucket]; bucket++) {}
 
-		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"%s must not be empty",param);
+	// Count the call
+	stats = &redis_stats->keys[index];
 
-		goto param_invalid;
+	__atomic_add_fetch(&stats->calls,1,__ATOMIC_RELAXED);
+	__atomic_add_fetch(&stats->time,elapsed,__ATOMIC_RELAXED);
+	__atomic_add_fetch(&stats->latency[bucket],1,__ATOMIC_RELAXED);
 
-	}
+	if (ret != SYSINFO_RET_OK) {__atomic_add_fetch(&stats->errors,1,__ATOMIC_RELAXED);}
 
-	// If there is a minimum required
-	if (min > 0 && atol(value) < min) {
+	return ret;
 
-		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"%s must be an integer greater than or equal to %lld",param,min);
+}
 
-		goto param_invalid;
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will take memory for an object of a reply from  *
+ *              the arena of its top level reply, which starts the arena      *
+ *              (expected is the size of its first block)                     *
+ * Returns    : Memory (success), NULL (failure)                              *
+ *                                                                            *
+ ******************************************************************************/
+static void * redis_reply_take(const redisReadTask *task, size_t size, size_t expected)
+{
 
-	}
+	// Declare Variables
+	const redisReadTask *root;
+	redis_arena_block_t *first, *block;
+	size_t               block_size;
+	char                *memory;
 
-	// If there is a maximum required
-	if (max > 0 && atol(value) > max) {
+	// Align the size
+	size = (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
 
-		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"%s must be an integer less than or equal to %lld",param,max);
+	// If the object is the top level reply then its arena starts with it
+	if (task->parent == NULL) {
 
-		goto param_invalid;
+		block_size = (expected > MAX_REPLY_ARENA_BLOCK_SIZE) ? MAX_REPLY_ARENA_BLOCK_SIZE : expected;
+		block_size = (block_size < size) ? size : block_size;
 
-	}
+		if ((first = malloc(sizeof(redis_arena_block_t) + block_size)) == NULL) {return NULL;}
 
-	// For specific parameters that required specific values
-	if (strcmp(param,"Datatype") == 0) {
+		first->next = NULL;
+		first->size = block_size;
+		first->used = size;
 
-		// Validate value contents
-		if (strcmp(value,"integer") != 0 &&
-		    strcmp(value,"float") != 0 &&
-		    strcmp(value,"string") != 0 &&
-		    strcmp(value,"text") != 0) {
+		return first + 1;
 
-			// Form message
-			zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"%s must be an integer,float,string,text",param);
+	}
 
-			goto param_invalid;
+	// Find the arena of the top level reply
+	for (root = task; root->parent != NULL; root = root->parent) {}
 
-		}
+	first = (redis_arena_block_t *)root->obj - 1;
 
-	}
+	// Take from the newest block (chained straight after the first) or chain a larger one
+	block = (first->next != NULL) ? first->next : first;
 
-param_valid:
+	if (block->used + size > block->size) {
 
-	return 0;
+		block_size = (block->size * 2 > MAX_REPLY_ARENA_BLOCK_SIZE) ? MAX_REPLY_ARENA_BLOCK_SIZE : block->size * 2;
+		block_size = (block_size < size) ? size : block_size;
+
+		if ((block = malloc(sizeof(redis_arena_block_t) + block_size)) == NULL) {return NULL;}
+
+		block->next = first->next;
+		block->size = block_size;
+		block->used = 0;
+		first->next = block;
+
+	}
+
+	memory = (char *)(block + 1) + block->used;
+
+	block->used += size;
+
+	return memory;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will create a reply object in the arena of its  *
+ *              top level reply with room for its string or elements after it *
+ *              and add it to its parent                                      *
+ * Returns    : Reply object (success), NULL (failure)                        *
+ *                                                                            *
+ ******************************************************************************/
+static redisReply * redis_reply_object(const redisReadTask *task, size_t extra, size_t expected)
+{
+
+	// Declare Variables
+	size_t      size = (sizeof(redisReply) + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+	redisReply *redisR, *parent;
+
+	if ((redisR = redis_reply_take(task, size + extra, size + expected)) == NULL) {return NULL;}
+
+	memset(redisR, 0, sizeof(redisReply));
+	redisR->type = task->type;
+
+	// Add the object to its parent
+	if (task->parent != NULL) {
+
+		parent = task->parent->obj;
+		parent->element[task->idx] = redisR;
+
+	}
+
+	return redisR;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will copy the string of a reply object into the *
+ *              room after it                                                 *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_reply_copy(redisReply *redisR, char *str, size_t len)
+{
+
+	redisR->str = (char *)redisR + ((sizeof(redisReply) + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1));
+	redisR->len = len;
+
+	memcpy(redisR->str, str, len);
+	redisR->str[len] = '\0';
+
+}
+
+#ifdef HAVE_REDIS_RESP3
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will check whether an object is part of a push  *
+ *              (pushes are built with the hiredis defaults, as hiredis frees *
+ *              them itself once its push callback has run)                   *
+ * Returns    : 1 (push), 0 (reply)                                           *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_reply_pushed(const redisReadTask *task)
+{
+
+	// Find the top level reply
+	while (task->parent != NULL) {task = task->parent;}
+
+	return (task->type == REDIS_REPLY_PUSH);
+
+}
+
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : These functions will create the objects of a reply in an      *
+ *              arena of its own, in place of the hiredis defaults that       *
+ *              allocate and free every object and string one by one         *
+ * Returns    : Reply object (success), NULL (failure)                        *
+ *                                                                            *
+ ******************************************************************************/
+static void * redis_reply_string(const redisReadTask *task, char *str, size_t len)
+{
+
+	// Declare Variables
+	redisReply *redisR;
+
+#ifdef HAVE_REDIS_RESP3
+	if (redis_reply_pushed(task)) {return redis_stats_reader->createString(task, str, len);}
+#endif
+
+	if ((redisR = redis_reply_object(task, len + 1, len + 1)) == NULL) {return NULL;}
+
+#ifdef HAVE_REDIS_RESP3
+
+	// Verbatim strings start with their format (txt:)
+	if (task->type == REDIS_REPLY_VERB && len >= 4) {
+
+		memcpy(redisR->vtype, str, 3);
+		redisR->vtype[3] = '\0';
+
+		redis_reply_copy(redisR, str + 4, len - 4);
+
+		return redisR;
+
+	}
+
+#endif
+
+	redis_reply_copy(redisR, str, len);
+
+	return redisR;
+
+}
+
+static void * redis_reply_array(const redisReadTask *task, size_t elements)
+{
+
+	// Declare Variables
+	redisReply *redisR;
+	size_t      size = elements * sizeof(redisReply *);
+
+#ifdef HAVE_REDIS_RESP3
+	if (redis_reply_pushed(task)) {return redis_stats_reader->createArray(task, elements);}
+#endif
+
+	// Make room in the first block for the elements and their objects too
+	if ((redisR = redis_reply_object(task, size, size + elements * (sizeof(redisReply) + REPLY_ARENA_ELEMENT_SIZE) + REPLY_ARENA_BLOCK_SIZE)) == NULL) {return NULL;}
+
+	if (elements > 0) {
+
+		redisR->element = (redisReply **)((char *)redisR + ((sizeof(redisReply) + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1)));
+		memset(redisR->element, 0, size);
+
+	}
+
+	redisR->elements = elements;
+
+	return redisR;
+
+}
+
+static void * redis_reply_integer(const redisReadTask *task, long long value)
+{
+
+	// Declare Variables
+	redisReply *redisR;
+
+#ifdef HAVE_REDIS_RESP3
+	if (redis_reply_pushed(task)) {return redis_stats_reader->createInteger(task, value);}
+#endif
+
+	if ((redisR = redis_reply_object(task, 0, 0)) == NULL) {return NULL;}
+
+	redisR->integer = value;
+
+	return redisR;
+
+}
+
+static void * redis_reply_nil(const redisReadTask *task)
+{
+
+	// Declare Variables
+	redisReply *redisR;
+
+#ifdef HAVE_REDIS_RESP3
+	if (redis_reply_pushed(task)) {return redis_stats_reader->createNil(task);}
+#endif
+
+	if ((redisR = redis_reply_object(task, 0, 0)) == NULL) {return NULL;}
+
+	// Nil bulk strings and arrays are read as tasks of their own type
+	redisR->type = REDIS_REPLY_NIL;
+
+	return redisR;
+
+}
+
+#ifdef HAVE_REDIS_RESP3
+
+static void * redis_reply_double(const redisReadTask *task, double value, char *str, size_t len)
+{
+
+	// Declare Variables
+	redisReply *redisR;
+
+	if (redis_reply_pushed(task)) {return redis_stats_reader->createDouble(task, value, str, len);}
+
+	if ((redisR = redis_reply_object(task, len + 1, len + 1)) == NULL) {return NULL;}
+
+	redisR->dval = value;
+	redis_reply_copy(redisR, str, len);
+
+	return redisR;
+
+}
+
+static void * redis_reply_bool(const redisReadTask *task, int value)
+{
+
+	// Declare Variables
+	redisReply *redisR;
+
+	if (redis_reply_pushed(task)) {return redis_stats_reader->createBool(task, value);}
+
+	if ((redisR = redis_reply_object(task, 0, 0)) == NULL) {return NULL;}
+
+	redisR->integer = (value != 0);
+
+	return redisR;
+
+}
+
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free a top level reply of a module context *
+ *              and every object in it at once                                *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_reply_free(redisReply *redisR)
+{
+
+	// Declare Variables
+	redis_arena_block_t *block, *next;
+
+	if (redisR == NULL) {return;}
+
+#ifdef HAVE_REDIS_RESP3
+
+	// Pushes are built with the hiredis defaults
+	if (redisR->type == REDIS_REPLY_PUSH) {freeReplyObject(redisR); return;}
+
+#endif
+
+	// Free the blocks of the arena (the reply is at the start of the first)
+	for (block = (redis_arena_block_t *)redisR - 1; block != NULL; block = next) {
+
+		next = block->next;
+		free(block);
+
+	}
+
+}
+
+static void redis_reply_free_object(void *reply) {redis_reply_free(reply);}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : These functions will count every top level reply read and     *
+ *              then build the reply in an arena of its own                   *
+ * Returns    : Reply object                                                  *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_stats_reply(const redisReadTask *task)
+{
+
+	if (task->parent == NULL) {REDIS_STATS_ADD(replies, 1);}
+
+}
+
+static void * redis_stats_string(const redisReadTask *task, char *str, size_t len)    {redis_stats_reply(task); return redis_reply_string(task, str, len);}
+static void * redis_stats_array(const redisReadTask *task, size_t elements)           {redis_stats_reply(task); return redis_reply_array(task, elements);}
+static void * redis_stats_integer(const redisReadTask *task, long long value)         {redis_stats_reply(task); return redis_reply_integer(task, value);}
+static void * redis_stats_nil(const redisReadTask *task)                              {redis_stats_reply(task); return redis_reply_nil(task);}
+
+#ifdef HAVE_REDIS_RESP3
+static void * redis_stats_double(const redisReadTask *task, double value, char *str, size_t len) {redis_stats_reply(task); return redis_reply_double(task, value, str, len);}
+static void * redis_stats_bool(const redisReadTask *task, int value)                             {redis_stats_reply(task); return redis_reply_bool(task, value);}
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : These functions will send (or pipeline) a command with        *
+ *              hiredis and count it, every command of the module is sent     *
+ *              through them                                                  *
+ * Returns    : Reply or REDIS_OK (success), NULL or REDIS_ERR (failure)      *
+ *                                                                            *
+ ******************************************************************************/
+void * redis_command_send(redisContext *redisC, const char *format, ...)
+{
+
+	// Declare Variables
+	va_list  args;
+	void    *redisR;
+
+	REDIS_STATS_ADD(commands, 1);
+
+	va_start(args, format);
+	redisR = redisvCommand(redisC, format, args);
+	va_end(args);
+
+	return redisR;
+
+}
+
+void * redis_command_send_argv(redisContext *redisC, int argc, const char **argv, const size_t *argvlen)
+{
+
+	REDIS_STATS_ADD(commands, 1);
+
+	return redisCommandArgv(redisC, argc, argv, argvlen);
+
+}
+
+int redis_command_append(redisContext *redisC, const char *format, ...)
+{
+
+	// Declare Variables
+	va_list  args;
+	int      ret;
+
+	REDIS_STATS_ADD(commands, 1);
+
+	va_start(args, format);
+	ret = redisvAppendCommand(redisC, format, args);
+	va_end(args);
+
+	return ret;
+
+}
+
+int redis_command_append_argv(redisContext *redisC, int argc, const char **argv, const size_t *argvlen)
+{
+
+	REDIS_STATS_ADD(commands, 1);
+
+	return redisAppendCommandArgv(redisC, argc, argv, argvlen);
+
+}
+
+#ifdef HAVE_REDIS_CONTEXT_FUNCS
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : These functions will time and count the socket reads and      *
+ *              writes of a context with the hiredis defaults                 *
+ * Returns    : Bytes read or written (success), -1 (failure)                 *
+ *                                                                            *
+ ******************************************************************************/
+static ssize_t redis_stats_read(redisContext *redisC, char *buffer, size_t length)
+{
+
+	// Declare Variables
+	unsigned long long  started = redis_stats_clock();
+	ssize_t             bytes;
+
+	bytes = redis_stats_io->read(redisC, buffer, length);
+
+	REDIS_STATS_ADD(io_time, redis_stats_clock() - started);
+
+	if (bytes > 0) {REDIS_STATS_ADD(bytes_read, bytes);}
+
+	return bytes;
+
+}
+
+static ssize_t redis_stats_write(redisContext *redisC)
+{
+
+	// Declare Variables
+	unsigned long long  started = redis_stats_clock();
+	ssize_t             bytes;
+
+	bytes = redis_stats_io->write(redisC);
+
+	REDIS_STATS_ADD(io_time, redis_stats_clock() - started);
+
+	if (bytes > 0) {REDIS_STATS_ADD(bytes_written, bytes);}
+
+	return bytes;
+
+}
+
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will wrap the reply and socket functions of a   *
+ *              context (once, the first thread to get the lock wraps them)   *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_stats_wrap(redisContext *redisC)
+{
+
+	pthread_mutex_lock(&redis_stats_lock);
+
+	// Keep the reply functions of the first context
+	if (redis_stats_reader == NULL) {
+
+		redis_stats_functions = *redisC->reader->fn;
+
+		redis_stats_functions.createString  = redis_stats_string;
+		redis_stats_functions.createArray   = redis_stats_array;
+		redis_stats_functions.createInteger = redis_stats_integer;
+		redis_stats_functions.createNil     = redis_stats_nil;
+#ifdef HAVE_REDIS_RESP3
+		redis_stats_functions.createDouble  = redis_stats_double;
+		redis_stats_functions.createBool    = redis_stats_bool;
+#endif
+		redis_stats_functions.freeObject    = redis_reply_free_object;
+
+#ifdef HAVE_REDIS_CONTEXT_FUNCS
+
+		// Keep the socket functions of the first context
+		redis_stats_funcs = *redisC->funcs;
+
+		redis_stats_funcs.read  = redis_stats_read;
+		redis_stats_funcs.write = redis_stats_write;
+
+		__atomic_store_n(&redis_stats_io,redisC->funcs,__ATOMIC_RELEASE);
+
+#endif
+
+		// Publish the reply functions last, once both tables are complete
+		__atomic_store_n(&redis_stats_reader,redisC->reader->fn,__ATOMIC_RELEASE);
+
+	}
+
+	pthread_mutex_unlock(&redis_stats_lock);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will instrument a context so that its replies,  *
+ *              bytes and socket time are counted (the hiredis defaults are   *
+ *              kept from the first context and wrapped, the wrapped tables   *
+ *              are only published once they are complete)                    *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_stats_context(redisContext *redisC)
+{
+
+	// Wrap the hiredis defaults of the first context (other threads may be opening their first context too)
+	if (__atomic_load_n(&redis_stats_reader,__ATOMIC_ACQUIRE) == NULL) {redis_stats_wrap(redisC);}
+
+	// Count the replies and build them in arenas (only contexts with the default reply functions)
+	if (redisC->reader->fn == __atomic_load_n(&redis_stats_reader,__ATOMIC_ACQUIRE)) {redisC->reader->fn = &redis_stats_functions;}
+
+#ifdef HAVE_REDIS_CONTEXT_FUNCS
+
+	// Count the socket reads and writes (only contexts with the default socket functions)
+	if (redisC->funcs == __atomic_load_n(&redis_stats_io,__ATOMIC_ACQUIRE)) {redisC->funcs = &redis_stats_funcs;}
+
+#endif
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will allocate the module statistics in memory   *
+ *              shared with the forked agent processes and dispatch every key *
+ *              through redis_stats_dispatch                                  *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_stats_start()
+{
+
+	// Declare Variables
+	unsigned int slot;
+	int          count, probe;
+
+	// Allocate the statistics in memory shared with the forked agent processes
+	redis_stats = mmap(NULL, sizeof(redis_stats_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	// If the allocation failed then only this process is counted
+	if (redis_stats == MAP_FAILED) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Statistics could not be shared (%s)",MODULE,strerror(errno));
+
+		redis_stats = &redis_stats_local;
+
+	}
+
+	memset(redis_stats, 0, sizeof(redis_stats_t));
+
+	// Dispatch every key through the statistics
+	for (count = 0; count < MAX_STATS_KEYS && keys[count].key != NULL; count++) {
+
+		// Index the key by name
+		slot = redis_hash(keys[count].key, strlen(keys[count].key)) % STATS_INDEX_SIZE;
+
+		for (probe = 0; probe < STATS_INDEX_SIZE && redis_stats_index[slot] != 0; probe++) {slot = (slot + 1) % STATS_INDEX_SIZE;}
+
+		redis_stats_index[slot] = count + 1;
+
+		// Replace the handler
+		redis_stats_handlers[count] = keys[count].function;
+		keys[count].function = redis_stats_dispatch;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the module statistics                 *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_stats_free()
+{
+
+	// If the statistics are shared
+	if (redis_stats != NULL && redis_stats != &redis_stats_local) {munmap(redis_stats, sizeof(redis_stats_t));}
+
+	redis_stats = &redis_stats_local;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will add a set of statistics to a JSON object   *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_stats_json(struct zbx_json *j, const redis_stats_metric_t *metrics, int metric_count, void *stats)
+{
+
+	// Declare Variables
+	char value[MAX_LENGTH_STRING];
+	int  count;
+
+	for (count = 0; count < metric_count; count++) {
+
+		zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",__atomic_load_n((unsigned long long *)((char *)stats + metrics[count].offset),__ATOMIC_RELAXED));
+		zbx_json_addstring(j, (char *)metrics[count].name, value, ZBX_JSON_TYPE_INT);
+
+	}
+
+}
+
+/**********************************************************************************************
+ *                                                                                            *
+ * Custom Key            : libzbxredis.stats[metric,key]                                      *
+ *                                                                                            *
+ * Function              : Gets the statistics of the module across every agent process       *
+ * Parameters [metric]   : Metric to return (blank for every metric as JSON)                  *
+ *                           sessions,session.errors,session.time,commands,replies,           *
+ *                           bytes.read,bytes.written,io.time,cache.hits,cache.misses,        *
+ *                           breaker.opens,breaker.rejects,resolves,resolve.errors,           *
+ *                           resolve.time - module wide                                       *
+ *                           calls,errors,time,latency.1ms,latency.10ms,latency.100ms,        *
+ *                           latency.1s,latency.10s,latency.inf - per key                     *
+ * Parameters [key]      : Key to return a per key metric of (blank for every key)            *
+ * Returns               : 0 (success),1 (failure)                                            *
+ *                                                                                            *
+ * Times are in microseconds. Time spent in a handler that is not resolve.time, session.time   *
+ * or io.time is spent by the module (ie parsing).                                            *
+ *                                                                                            *
+ **********************************************************************************************/
+int libzbxredis_stats(AGENT_REQUEST *request, AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char         *__function_name = "libzbxredis_stats";
+	int                 ret = SYSINFO_RET_FAIL;
+	char               *zbx_key, *zbx_msg;
+	char               *param_metric, *param_key;
+	struct zbx_json     j;
+	unsigned long long  value = 0;
+	int                 count, index;
+	size_t              metric;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, 2, request->nparam, ">")) {return ret;}
+
+	// Assign parameters
+	param_metric = strisnull(get_rparam(request,0)) ? "" : get_rparam(request,0);
+	param_key    = strisnull(get_rparam(request,1)) ? "" : get_rparam(request,1);
+
+	// If every metric is wanted
+	if (strlen(param_metric) == 0) {
+
+		// Initialise JSON
+		zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+		// Add the module wide metrics
+		redis_stats_json(&j, redis_stats_globals, ARRSIZE(redis_stats_globals), redis_stats);
+
+		// Add the metrics of every key that has been called
+		zbx_json_addobject(&j,"keys");
+
+		for (count = 0; count < MAX_STATS_KEYS && keys[count].key != NULL; count++) {
+
+			if (__atomic_load_n(&redis_stats->keys[count].calls,__ATOMIC_RELAXED) == 0) {continue;}
+
+			zbx_json_addobject(&j,keys[count].key);
+			redis_stats_json(&j, redis_stats_key_metrics, ARRSIZE(redis_stats_key_metrics), &redis_stats->keys[count]);
+			zbx_json_close(&j);
+
+		}
+
+		zbx_json_close(&j);
+
+		// Set return
+		zbx_ret_text(result, &ret, LOG_LEVEL_DEBUG, zbx_key, j.buffer, NULL);
+
+		// Free the json
+		zbx_json_free(&j);
+
+		goto out;
+
+	}
+
+	// If the metric is module wide
+	for (metric = 0; metric < ARRSIZE(redis_stats_globals); metric++) {
+
+		if (strcmp(redis_stats_globals[metric].name,param_metric) != 0) {continue;}
+
+		// Set return
+		zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, __atomic_load_n((unsigned long long *)((char *)redis_stats + redis_stats_globals[metric].offset),__ATOMIC_RELAXED), NULL);
+
+		goto out;
+
+	}
+
+	// If the metric is per key
+	for (metric = 0; metric < ARRSIZE(redis_stats_key_metrics); metric++) {
+
+		if (strcmp(redis_stats_key_metrics[metric].name,param_metric) != 0) {continue;}
+
+		// If the key is not known
+		if (strlen(param_key) > 0 && (index = redis_stats_key(param_key)) == -1) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("Key (%s) is not a key of the module",param_key);
+
+			// Set return
+			zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, NULL);
+
+			goto out;
+
+		}
+
+		// Sum the metric of the key (or every key)
+		for (index = (strlen(param_key) > 0) ? index : 0; index < MAX_STATS_KEYS && keys[index].key != NULL; index++) {
+
+			value += __atomic_load_n((unsigned long long *)((char *)&redis_stats->keys[index] + redis_stats_key_metrics[metric].offset),__ATOMIC_RELAXED);
+
+			if (strlen(param_key) > 0) {break;}
+
+		}
+
+		// Set return
+		zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, value, NULL);
+
+		goto out;
+
+	}
+
+	// Form message
+	zbx_msg = redis_arena_printf("Metric (%s) is not a statistic of the module",param_metric);
+
+	// Set return
+	zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, NULL);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/*************************************************************
+ *                                                           *
+ * Function   : This function will validate standard params  *
+ * Returns    : 0 (valid), 1 (invalid)                       *
+ *                                                           *
+ *************************************************************/
+int validate_param_count(AGENT_RESULT *result, char *zbx_key, int param_count, int nparam, char *condition)
+{
+
+	// Declar variables
+	char *zbx_msg = "";
+
+	// If the condition is !=
+	if (strcmp(condition,"!=") == 0 && param_count != nparam) {
+
+		zbx_msg = redis_arena_printf("Invalid parameter count specified, expected %d received %d",param_count,nparam);
+
+		goto param_count_invalid;
+
+	}
+
+	// If the condition is > (optional parameters may be left off the end)
+	if (strcmp(condition,">") == 0 && nparam > param_count) {
+
+		zbx_msg = redis_arena_printf("Invalid parameter count specified, expected at most %d received %d",param_count,nparam);
+
+		goto param_count_invalid;
+
+	}
+
+	// If the condition is <
+	if (strcmp(condition,"<") == 0 && nparam < param_count) {
+
+		zbx_msg = redis_arena_printf("Invalid parameter count specified, expected at least %d received %d",param_count,nparam);
+
+		goto param_count_invalid;
+
+	}
+
+param_count_valid:
+
+	return 0;
+
+param_count_invalid:
+
+        // Log message
+        zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+        // Set message
+        SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	return 1;
+
+}
+
+/*************************************************************
+ *                                                           *
+ * Function   : This function will validate standard params  *
+ * Returns    : 0 (valid), 1 (invalid)                       *
+ *                                                           *
+ *************************************************************/
+int validate_param(AGENT_RESULT *result,char *zbx_key, char *param, char *value, char *value_default, int allow_empty, int min, int max)
+{
+
+	// Declare variables
+	char *zbx_msg = "";
+
+	// If the value is empty and there is a default value
+	if (strlen(value) == 0 && strlen(value_default) > 0) {
+
+		// Set the value to default
+		zbx_strlcpy(value,value_default,MAX_LENGTH_PARAM);
+
+	}
+
+	// If the value is empty and thats not allowed
+	if (strlen(value) == 0 && ! allow_empty) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("%s must not be empty",param);
+
+		goto param_invalid;
+
+	}
+
+	// If there are bounds the value must be an integer
+	if ((min >= 0 || max > 0) && strlen(value) > 0 && strspn(value + (*value == '-'),"0123456789") != strlen(value + (*value == '-'))) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("%s must be an integer",param);
+
+		goto param_invalid;
+
+	}
+
+	// If there is a minimum required
+	if (min >= 0 && atol(value) < min) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("%s must be an integer greater than or equal to %d",param,min);
+
+		goto param_invalid;
+
+	}
+
+	// If there is a maximum required
+	if (max > 0 && atol(value) > max) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("%s must be an integer less than or equal to %d",param,max);
+
+		goto param_invalid;
+
+	}
+
+	// For specific parameters that required specific values
+	if (strcmp(param,"Datatype") == 0) {
+
+		// Validate value contents
+		if (strcmp(value,"integer") != 0 &&
+		    strcmp(value,"float") != 0 &&
+		    strcmp(value,"string") != 0 &&
+		    strcmp(value,"text") != 0) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("%s must be an integer,float,string,text",param);
+
+			goto param_invalid;
+
+		}
+
+	}
+
+param_valid:
+
+	return 0;
+
+param_invalid:
+
+        // Log message
+        zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+        // Set message
+        SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	return 1;
+
+}
+
+/*************************************************************
+ *                                                           *
+ * Function   : This function will split a list parameter    *
+ *              in place into arguments                      *
+ * Returns    : Argument count (success), -1 (failure)       *
+ *                                                           *
+ *************************************************************/
+int split_param(AGENT_RESULT *result, char *zbx_key, char *param, char *value, char separator, const char **argv, int max)
+{
+
+	// Declare variables
+	char *zbx_msg = "";
+	char *next;
+	int   argc = 0;
+
+	// Split every argument
+	while (value != NULL) {
+
+		// If there are too many arguments
+		if (argc == max) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("%s must not contain more than %d values",param,max);
+
+			goto param_invalid;
+
+		}
+
+		// Terminate the argument
+		if ((next = strchr(value,separator)) != NULL) {*next++ = '\0';}
+
+		// If the argument is empty
+		if (*value == '\0') {
+
+			// Form message
+			zbx_msg = redis_arena_printf("%s must not contain empty values",param);
+
+			goto param_invalid;
+
+		}
+
+		argv[argc++] = value;
+		value = next;
+
+	}
+
+	return argc;
 
 param_invalid:
 
-        // Log message
-        zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+        // Log message
+        zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+        // Set message
+        SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	return -1;
+
+}
+
+/*************************************************************
+ *                                                           *
+ * Function   : This function confirm redis command support  *
+ * Returns    : 0 (supported), 1 (unsupported)               *
+ *                                                           *
+ *************************************************************/
+int redis_command_is_supported(redisContext *redisC, char *command, char *zbx_key, char **zbx_msg)
+{
+
+	// Declare variables
+	redisReply *redisR;
+
+	// Run the redis command
+	redisR = redis_command_send(redisC,"COMMAND INFO %s",command);
+
+	// If the connection is lost
+	if(redisR == NULL) {goto error_connection_lost;}
+
+	// If the reply is not valid
+	if (redis_reply_valid(redisR->type,REDIS_REPLY_ARRAY,"COMMAND INFO",zbx_key,zbx_msg) == 1) {goto error_free_reply;}
+
+	// If the command is supported
+	if (redisR->element[0]->elements) {
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+		// Return supported
+		return 0;
+
+	}
+
+	// Form message
+	*zbx_msg = redis_arena_printf("Required redis command (%s) is not supported by the redis server",command);
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// Return unsupported
+	return 1;
+
+error_connection_lost:
+
+	// Form message
+	*zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+	goto error;
+
+error_free_reply:
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+error:
+
+        // Log message
+        zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,*zbx_msg,zbx_key);
+
+out:
+
+	// Return unsupported
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will return a reply if one can be read from a   *
+ *              redis connection within the timeout, without blocking on it   *
+ * Returns    : 1 (reply), 0 (no reply), -1 (connection failure)             *
+ *                                                                            *
+ ******************************************************************************/
+int redis_reply_pending(redisContext *redisC, int timeout_ms, redisReply **redisRptr)
+{
+
+	// Declare Variables
+	struct pollfd   redisPoll;
+	void           *reply = NULL;
+
+	// Initialise the reply
+	*redisRptr = NULL;
+
+	// If a reply has already been buffered then return it
+	if (redisGetReplyFromReader(redisC,&reply) == REDIS_ERR) {return -1;}
+	if (reply != NULL) {*redisRptr = reply; return 1;}
+
+	// Wait for the socket to become readable
+	redisPoll.fd = redisC->fd;
+	redisPoll.events = POLLIN;
+	redisPoll.revents = 0;
+
+	// If the poll failed
+	if (poll(&redisPoll,1,timeout_ms) < 0) {return (errno == EINTR) ? 0 : -1;}
+
+	// If there is nothing to read
+	if ((redisPoll.revents & (POLLIN | POLLHUP | POLLERR)) == 0) {return 0;}
+
+	// Read what is available (a closed connection is reported as an error)
+	if (redisBufferRead(redisC) == REDIS_ERR) {return -1;}
+
+	// Parse a reply from what has been read
+	if (redisGetReplyFromReader(redisC,&reply) == REDIS_ERR) {return -1;}
+
+	// Assign the reply
+	*redisRptr = reply;
+
+	return (reply != NULL) ? 1 : 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will split a sentinel target of the form        *
+ *              sentinel://host:port/mastername into its parts                *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_sentinel_parse(char *redis_server, char *sentinel_host, char *sentinel_port, char *master_name)
+{
+
+	// Declare Variables
+	char   *address, *name, *port;
+
+	// Skip the prefix
+	address = redis_server + strlen(REDIS_SENTINEL_PREFIX);
+
+	// The master name follows the last slash
+	if ((name = strrchr(address,'/')) == NULL || strisnull(name + 1)) {return 1;}
+
+	// Copy the master name and the sentinel address
+	zbx_strlcpy(master_name,name + 1,MAX_LENGTH_PARAM);
+	zbx_strlcpy(sentinel_host,address,MIN(name - address + 1,MAX_LENGTH_STRING));
+
+	// The port is optional
+	zbx_strlcpy(sentinel_port,DEFAULT_SENTINEL_PORT,MAX_LENGTH_PARAM);
+
+	// If a port has been given
+	if ((port = strrchr(sentinel_host,':')) != NULL) {
+
+		// Copy the port and terminate the host
+		zbx_strlcpy(sentinel_port,port + 1,MAX_LENGTH_PARAM);
+		*port = '\0';
+
+	}
+
+	// If either part is missing
+	if (strisnull(sentinel_host) || atol(sentinel_port) < MIN_REDIS_PORT || atol(sentinel_port) > MAX_REDIS_PORT) {return 1;}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will close a sentinel cache entry               *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_sentinel_close(redis_sentinel_t *sentinel)
+{
+
+	// Close the subscription
+	if (sentinel->subscription != NULL) {redisFree(sentinel->subscription);}
+
+	// Forget the master
+	sentinel->subscription = NULL;
+	sentinel->master_host[0] = '\0';
+	sentinel->master_port[0] = '\0';
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will ask a sentinel for the current master and  *
+ *              subscribe to its failover notifications                       *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_sentinel_resolve(redis_sentinel_t *sentinel, struct timeval timeout, char **zbx_msg)
+{
+
+	// Declare Variables
+	char            sentinel_host[MAX_LENGTH_STRING], sentinel_port[MAX_LENGTH_PARAM], master_name[MAX_LENGTH_PARAM];
+	redisContext   *redisC = NULL;
+	redisReply     *redisR = NULL;
+
+	// Parse the target
+	if (redis_sentinel_parse(sentinel->target, sentinel_host, sentinel_port, master_name)) {
+
+		// Form message
+		*zbx_msg = redis_arena_printf("Redis sentinel target invalid (expected %shost:port/mastername)",REDIS_SENTINEL_PREFIX);
+
+		return 1;
+
+	}
+
+	// Subscribe first so that a failover between the lookup and the subscription is not missed
+	sentinel->subscription = redisConnectWithTimeout(sentinel_host,atol(sentinel_port),timeout);
+
+	// If the subscription connection failed
+	if (sentinel->subscription == NULL || sentinel->subscription->err) {goto error_sentinel_connection;}
+
+	// Count the replies of the subscription and build them in arenas
+	redis_stats_context(sentinel->subscription);
+
+	// Subscribe to failover notifications
+	redisR = redis_command_send(sentinel->subscription,"SUBSCRIBE +switch-master");
+
+	// If the subscription failed
+	if (redisR == NULL || redisR->type != REDIS_REPLY_ARRAY) {goto error_sentinel_connection;}
+
+	// Free the reply
+	redis_reply_free(redisR);
+	redisR = NULL;
+
+	// Connect for the lookup
+	redisC = redisConnectWithTimeout(sentinel_host,atol(sentinel_port),timeout);
+
+	// If the lookup connection failed
+	if (redisC == NULL || redisC->err) {goto error_sentinel_connection;}
+
+	// Count the replies of the lookup and build them in arenas
+	redis_stats_context(redisC);
+
+	// Ask for the current master
+	redisR = redis_command_send(redisC,"SENTINEL get-master-addr-by-name %s",master_name);
+
+	// If the connection is lost
+	if (redisR == NULL) {goto error_sentinel_connection;}
+
+	// If the sentinel does not monitor the master
+	if (redisR->type != REDIS_REPLY_ARRAY || redisR->elements != 2) {
+
+		// Form message
+		*zbx_msg = redis_arena_printf("Redis sentinel does not know master (%s)",master_name);
+
+		goto error;
+
+	}
+
+	// Cache the master
+	zbx_strlcpy(sentinel->master_host,redisR->element[0]->str,MAX_LENGTH_STRING);
+	zbx_strlcpy(sentinel->master_port,redisR->element[1]->str,MAX_LENGTH_PARAM);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Sentinel target (%s) resolved to master (%s:%s)",MODULE,sentinel->target,sentinel->master_host,sentinel->master_port);
+
+	// Free the reply and lookup connection
+	redis_reply_free(redisR);
+	redisFree(redisC);
+
+	return 0;
+
+error_sentinel_connection:
+
+	// Form message
+	*zbx_msg = redis_arena_printf("Redis sentinel connection failed (%s:%s)",sentinel_host,sentinel_port);
+
+error:
+
+	// Free the reply and lookup connection
+	if (redisR != NULL) {redis_reply_free(redisR);}
+	if (redisC != NULL) {redisFree(redisC);}
+
+	// Forget the master
+	redis_sentinel_close(sentinel);
+
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will apply any failover notifications that have *
+ *              arrived on a sentinel subscription                            *
+ * Returns    : 0 (cache still valid), 1 (cache invalid)                      *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_sentinel_refresh(redis_sentinel_t *sentinel)
+{
+
+	// Declare Variables
+	char            sentinel_host[MAX_LENGTH_STRING], sentinel_port[MAX_LENGTH_PARAM], master_name[MAX_LENGTH_PARAM];
+	char            switch_name[MAX_LENGTH_PARAM], switch_host[MAX_LENGTH_STRING], switch_port[MAX_LENGTH_PARAM];
+	redisReply     *redisR;
+	int             pending;
+
+	// Without a subscription failovers can not be seen
+	if (sentinel->subscription == NULL || strisnull(sentinel->master_host)) {return 1;}
+
+	// Parse the target
+	if (redis_sentinel_parse(sentinel->target, sentinel_host, sentinel_port, master_name)) {return 1;}
+
+	// Read every notification that has arrived
+	while ((pending = redis_reply_pending(sentinel->subscription, 0, &redisR)) == 1) {
+
+		// Notifications are [message, +switch-master, "name oldip oldport newip newport"]
+		if (redisR->type == REDIS_REPLY_ARRAY && redisR->elements == 3 && redisR->element[2]->type == REDIS_REPLY_STRING) {
+
+			// If the notification is for this master
+			if (sscanf(redisR->element[2]->str,"%254s %*s %*s %254s %254s",switch_name,switch_host,switch_port) == 3 && strcmp(switch_name,master_name) == 0) {
+
+				// Log message
+				zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Sentinel target (%s) switched master to (%s:%s)",MODULE,sentinel->target,switch_host,switch_port);
+
+				// Cache the new master
+				zbx_strlcpy(sentinel->master_host,switch_host,MAX_LENGTH_STRING);
+				zbx_strlcpy(sentinel->master_port,switch_port,MAX_LENGTH_PARAM);
+
+			}
+
+		}
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+	}
+
+	// If the subscription has been lost
+	if (pending == -1) {
+
+		// Forget the master
+		redis_sentinel_close(sentinel);
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the cache entry of a sentinel target, *
+ *              taking the next entry if it is not cached (the lock must be   *
+ *              held)                                                         *
+ * Returns    : Cache entry                                                   *
+ *                                                                            *
+ ******************************************************************************/
+static redis_sentinel_t * redis_sentinel_entry(char *redis_server)
+{
+
+	// Declare Variables
+	redis_sentinel_t *sentinel;
+	int               count;
+
+	// Find the cache entry for the target
+	for (count = 0; count < MAX_SENTINEL_TARGETS; count++) {
+
+		if (strcmp(redis_sentinels[count].target,redis_server) == 0) {return &redis_sentinels[count];}
+
+	}
+
+	// Reuse the next entry
+	sentinel = &redis_sentinels[redis_sentinels_next];
+	redis_sentinels_next = (redis_sentinels_next + 1) % MAX_SENTINEL_TARGETS;
+
+	// Reset the entry
+	redis_sentinel_close(sentinel);
+	zbx_strlcpy(sentinel->target,redis_server,MAX_LENGTH_PARAM);
+
+	return sentinel;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the current master of a sentinel       *
+ *              target, using the cached address until a failover or a        *
+ *              connection error (the sentinel is asked without holding the   *
+ *              lock, the answer is then published to the cache)              *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_sentinel_master(char *redis_server, struct timeval timeout, char *master_host, char *master_port, char **zbx_msg)
+{
+
+	// Declare Variables
+	redis_sentinel_t *sentinel, resolved;
+
+	// Lock the cache (the keyspace event listeners open sessions too)
+	pthread_mutex_lock(&redis_sentinels_lock);
+
+	// Find the cache entry for the target
+	sentinel = redis_sentinel_entry(redis_server);
+
+	// If the cached master is still valid
+	if (! redis_sentinel_refresh(sentinel)) {
+
+		// Copy the master
+		zbx_strlcpy(master_host,sentinel->master_host,MAX_LENGTH_STRING);
+		zbx_strlcpy(master_port,sentinel->master_port,MAX_LENGTH_PARAM);
+
+		pthread_mutex_unlock(&redis_sentinels_lock);
+
+		return 0;
+
+	}
+
+	// Copy the target
+	memset(&resolved, 0, sizeof(redis_sentinel_t));
+	zbx_strlcpy(resolved.target,sentinel->target,MAX_LENGTH_PARAM);
+
+	pthread_mutex_unlock(&redis_sentinels_lock);
+
+	// Ask the sentinel
+	if (redis_sentinel_resolve(&resolved, timeout, zbx_msg)) {return 1;}
+
+	pthread_mutex_lock(&redis_sentinels_lock);
+
+	// Publish the master (the entry may have been resolved or reused since, any subscription it holds is replaced)
+	sentinel = redis_sentinel_entry(redis_server);
+	redis_sentinel_close(sentinel);
+	*sentinel = resolved;
+
+	// Copy the master
+	zbx_strlcpy(master_host,sentinel->master_host,MAX_LENGTH_STRING);
+	zbx_strlcpy(master_port,sentinel->master_port,MAX_LENGTH_PARAM);
+
+	pthread_mutex_unlock(&redis_sentinels_lock);
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will forget the cached master of a sentinel     *
+ *              target (ie after a connection error)                          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_sentinel_invalidate(char *redis_server)
+{
+
+	// Declare Variables
+	int count;
+
+	pthread_mutex_lock(&redis_sentinels_lock);
+
+	// Find the cache entry for the target
+	for (count = 0; count < MAX_SENTINEL_TARGETS; count++) {
+
+		if (strcmp(redis_sentinels[count].target,redis_server) == 0) {redis_sentinel_close(&redis_sentinels[count]);}
+
+	}
+
+	pthread_mutex_unlock(&redis_sentinels_lock);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will close every sentinel cache entry           *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_sentinel_free()
+{
+
+	// Declare Variables
+	int count;
+
+	pthread_mutex_lock(&redis_sentinels_lock);
+
+	// Close every entry
+	for (count = 0; count < MAX_SENTINEL_TARGETS; count++) {redis_sentinel_close(&redis_sentinels[count]);}
+
+	pthread_mutex_unlock(&redis_sentinels_lock);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will check whether a server has refused HELLO 3 *
+ * Returns    : 0 (not refused), 1 (refused)                                  *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_hello_refused(char *redis_host, char *redis_port, int remember)
+{
+
+	// Declare Variables
+	char   redis_address[MAX_LENGTH_STRING];
+	int    count, refused = 0;
+
+	// Form the address
+	zbx_snprintf(redis_address,MAX_LENGTH_STRING,"%s:%s",redis_host,redis_port);
+
+	// Lock the table (the keyspace event listeners open sessions too)
+	pthread_mutex_lock(&redis_hello_lock);
+
+	// If the server has already refused
+	for (count = 0; count < MAX_HELLO_TARGETS && ! refused; count++) {
+
+		if (strcmp(redis_hello_unsupported[count],redis_address) == 0) {refused = 1;}
+
+	}
+
+	// If the refusal is to be remembered
+	if (remember && ! refused) {
+
+		zbx_strlcpy(redis_hello_unsupported[redis_hello_unsupported_next],redis_address,MAX_LENGTH_STRING);
+		redis_hello_unsupported_next = (redis_hello_unsupported_next + 1) % MAX_HELLO_TARGETS;
+
+		refused = 1;
+
+	}
+
+	pthread_mutex_unlock(&redis_hello_lock);
+
+	return refused;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will hash a string (FNV-1a)                     *
+ * Returns    : Hash                                                          *
+ *                                                                            *
+ ******************************************************************************/
+unsigned int redis_hash(const char *value, size_t length)
+{
+
+	// Declare Variables
+	unsigned int hash = 2166136261U;
+	size_t       count;
+
+	for (count = 0; count < length; count++) {hash = (hash ^ (unsigned char)value[count]) * 16777619U;}
+
+	return hash;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will add a name to a set of names held in the   *
+ *              request arena (the set has room for half of its slots)        *
+ * Returns    : 0 (added), 1 (already in the set or the set is full)          *
+ *                                                                            *
+ ******************************************************************************/
+int redis_names_add(char **names, size_t slots, const char *name, size_t length)
+{
+
+	// Declare Variables
+	unsigned int hash;
+	size_t       count;
+	char       **slot;
+
+	// Hash the name
+	hash = redis_hash(name, length);
+
+	// Probe from the hashed slot
+	for (count = 0; count < slots; count++) {
+
+		slot = &names[(hash + count) % slots];
+
+		// If the slot is free then the name has not been seen
+		if (*slot == NULL) {*slot = redis_arena_slice(name, length); return 0;}
+
+		// If the slot holds the name
+		if (strncmp(*slot,name,length) == 0 && (*slot)[length] == '\0') {return 1;}
+
+	}
+
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will trim the white space around a string       *
+ * Returns    : Trimmed string                                                *
+ *                                                                            *
+ ******************************************************************************/
+static char * redis_targets_trim(char *value)
+{
+
+	// Declare Variables
+	char *end;
+
+	while (isspace((unsigned char)*value)) {value++;}
+
+	for (end = value + strlen(value); end > value && isspace((unsigned char)end[-1]); end--) {}
+
+	*end = '\0';
+
+	return value;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will check a named target and index it          *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_targets_add(redis_target_t *target)
+{
+
+	// Declare Variables
+	unsigned int slot;
+	int          count;
+
+	// If the target is invalid
+	if (strisnull(target->server) || atol(target->port) < MIN_REDIS_PORT || atol(target->port) > MAX_REDIS_PORT
+	 || atol(target->timeout) < MIN_REDIS_TIMEOUT || atol(target->timeout) > MAX_REDIS_TIMEOUT
+	 || target->cache_ttl < MIN_CACHE_TTL || target->cache_ttl > MAX_CACHE_TTL) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Target (%c%s) is invalid and has been ignored",MODULE,REDIS_TARGET_PREFIX,target->name);
+
+		return 1;
+
+	}
+
+	// Index the target by name (open addressing, the index is twice the size of the targets)
+	slot = redis_hash(target->name, strlen(target->name)) % TARGET_INDEX_SIZE;
+
+	for (count = 0; count < TARGET_INDEX_SIZE; count++, slot = (slot + 1) % TARGET_INDEX_SIZE) {
+
+		// If the slot is free
+		if (redis_targets_index[slot] == 0) {redis_targets_index[slot] = (target - redis_targets) + 1; break;}
+
+		// If the name is already defined
+		if (strcmp(redis_targets[redis_targets_index[slot] - 1].name,target->name) == 0) {
+
+			// Log message
+			zabbix_log(LOG_LEVEL_ERR,"Module (%s): Target (%c%s) is defined more than once and has been ignored",MODULE,REDIS_TARGET_PREFIX,target->name);
+
+			return 1;
+
+		}
+
+	}
+
+	redis_targets_count++;
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will load the named targets of the module       *
+ *              configuration file (LIBZBXREDIS_CONFIG or the default path),  *
+ *              a missing file is not an error                                *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_targets_load()
+{
+
+	// Declare Variables
+	char            line[MAX_LENGTH_LINE], *path, *field, *value, *end;
+	FILE           *config;
+	redis_target_t *target = NULL;
+	int             line_number = 0;
+
+	// Get the configuration file
+	path = getenv(TARGETS_CONFIG_ENV);
+
+	if (strisnull(path)) {path = DEFAULT_TARGETS_CONFIG;}
+
+	// If there is no configuration file
+	if ((config = fopen(path,"r")) == NULL) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Configuration file (%s) not loaded (%s)",MODULE,path,strerror(errno));
+
+		return (errno == ENOENT) ? 0 : 1;
+
+	}
+
+	// Process every line
+	while (fgets(line,MAX_LENGTH_LINE,config) != NULL) {
+
+		line_number++;
+
+		field = redis_targets_trim(line);
+
+		// If the line is empty or a comment
+		if (*field == '\0' || *field == '#' || *field == ';') {continue;}
+
+		// If the line starts a target ([name])
+		if (*field == '[' && (end = strchr(field,']')) != NULL) {
+
+			// Add the previous target
+			if (target != NULL && redis_targets_add(target)) {memset(target, 0, sizeof(redis_target_t));}
+
+			// If there is no room for the target
+			if (redis_targets_count == MAX_TARGETS) {
+
+				// Log message
+				zabbix_log(LOG_LEVEL_ERR,"Module (%s): Configuration file (%s) defines more than %d targets",MODULE,path,MAX_TARGETS);
+
+				target = NULL;
+
+				break;
+
+			}
+
+			// Start the target with the defaults
+			*end = '\0';
+			target = &redis_targets[redis_targets_count];
+
+			zbx_strlcpy(target->name,redis_targets_trim(field + 1),MAX_LENGTH_PARAM);
+			zbx_strlcpy(target->server,DEFAULT_REDIS_SERVER,MAX_LENGTH_STRING);
+			zbx_strlcpy(target->port,DEFAULT_REDIS_PORT,MAX_LENGTH_PARAM);
+			zbx_strlcpy(target->timeout,DEFAULT_REDIS_TIMEOUT,MAX_LENGTH_PARAM);
+			zbx_strlcpy(target->password,DEFAULT_REDIS_PASS,MAX_LENGTH_PARAM);
+			target->cache_ttl = REDIS_CACHE_TTL;
+			target->events    = 0;
+
+			continue;
+
+		}
+
+		// If the line is not a setting of a target (field = value)
+		if (target == NULL || (value = strchr(field,'=')) == NULL) {
+
+			// Log message
+			zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Configuration file (%s) line %d ignored",MODULE,path,line_number);
+
+			continue;
+
+		}
+
+		// Split the setting
+		*value++ = '\0';
+		field = redis_targets_trim(field);
+		value = redis_targets_trim(value);
+
+		// Set the setting
+		if      (strcmp(field,"server") == 0)    {zbx_strlcpy(target->server,value,MAX_LENGTH_STRING);}
+		else if (strcmp(field,"port") == 0)      {zbx_strlcpy(target->port,value,MAX_LENGTH_PARAM);}
+		else if (strcmp(field,"timeout") == 0)   {zbx_strlcpy(target->timeout,value,MAX_LENGTH_PARAM);}
+		else if (strcmp(field,"password") == 0)  {zbx_strlcpy(target->password,value,MAX_LENGTH_PARAM);}
+		else if (strcmp(field,"cache_ttl") == 0) {target->cache_ttl = atoi(value);}
+		else if (strcmp(field,"events") == 0)    {target->events = (strcmp(value,"yes") == 0 || strcmp(value,"1") == 0);}
+		else {
+
+			// Log message
+			zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Configuration file (%s) line %d has an unknown setting (%s)",MODULE,path,line_number,field);
+
+		}
+
+	}
+
+	// Add the last target
+	if (target != NULL && redis_targets_add(target)) {memset(target, 0, sizeof(redis_target_t));}
+
+	fclose(config);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_INFORMATION,"Module (%s): Configuration file (%s) loaded with %d targets",MODULE,path,redis_targets_count);
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find a named target                        *
+ * Returns    : Target (success), NULL (failure)                              *
+ *                                                                            *
+ ******************************************************************************/
+redis_target_t * redis_target_find(char *name)
+{
+
+	// Declare Variables
+	unsigned int slot;
+	int          count;
+
+	// If there are no targets
+	if (redis_targets_count == 0) {return NULL;}
+
+	slot = redis_hash(name, strlen(name)) % TARGET_INDEX_SIZE;
+
+	for (count = 0; count < TARGET_INDEX_SIZE && redis_targets_index[slot] != 0; count++, slot = (slot + 1) % TARGET_INDEX_SIZE) {
+
+		if (strcmp(redis_targets[redis_targets_index[slot] - 1].name,name) == 0) {return &redis_targets[redis_targets_index[slot] - 1];}
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will resolve a named target (@name) given as    *
+ *              the server of a request into the settings of the target,      *
+ *              any port, timeout or password given is kept (the settings     *
+ *              point into the target, NULL for settings the key does not     *
+ *              use)                                                          *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_target_resolve(AGENT_RESULT *result, char *zbx_key, char **redis_server, char **redis_port, char **redis_timeout, char **redis_password, int *cache_ttl)
+{
+
+	// Declare Variables
+	char           *zbx_msg = "";
+	redis_target_t *target;
+
+	// Requests without a named target use the default cache ttl
+	if (cache_ttl != NULL) {*cache_ttl = REDIS_CACHE_TTL;}
+
+	// If the server is not a named target
+	if (*redis_server == NULL || (*redis_server)[0] != REDIS_TARGET_PREFIX) {return 0;}
+
+	// If the target is not defined
+	if ((target = redis_target_find(*redis_server + 1)) == NULL) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Target (%s) is not defined in the module configuration",*redis_server);
+
+		// Log message
+		zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+		// Set message
+		SET_MSG_RESULT(result,strdup(zbx_msg));
+
+		return 1;
+
+	}
+
+	// Use the settings of the target that have not been given
+	*redis_server = target->server;
+
+	if (redis_port != NULL && strisnull(*redis_port))         {*redis_port = target->port;}
+	if (redis_timeout != NULL && strisnull(*redis_timeout))   {*redis_timeout = target->timeout;}
+	if (redis_password != NULL && strisnull(*redis_password)) {*redis_password = target->password;}
+
+	// Use the cache ttl of the target
+	if (cache_ttl != NULL) {*cache_ttl = target->cache_ttl;}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will set up the lock of a table in shared       *
+ *              memory, a robust mutex so that a process that dies holding    *
+ *              it does not leave the other processes waiting forever         *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_shared_lock_init(pthread_mutex_t *lock)
+{
+
+	// Declare Variables
+	pthread_mutexattr_t attr;
+	int                 ret = 1;
+
+	if (pthread_mutexattr_init(&attr) != 0) {return 1;}
+
+	if (pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) == 0 && pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST) == 0
+	 && pthread_mutex_init(lock, &attr) == 0) {ret = 0;}
+
+	pthread_mutexattr_destroy(&attr);
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will lock or unlock a table in shared memory    *
+ *              (the lock is the first member of the table, if its holder     *
+ *              died the entries may be half written so the table is emptied) *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_shared_lock(pthread_mutex_t *lock, size_t size, int acquire)
+{
+
+	// If the lock is to be released
+	if (! acquire) {pthread_mutex_unlock(lock); return;}
+
+	// If the process holding the lock died
+	if (pthread_mutex_lock(lock) == EOWNERDEAD) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Shared table recovered from a process that died holding its lock",MODULE);
+
+		memset((char *)lock + sizeof(pthread_mutex_t), 0, size - sizeof(pthread_mutex_t));
+
+		pthread_mutex_consistent(lock);
+
+	}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will allocate the circuit breakers in memory    *
+ *              shared with the forked agent processes                        *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_breakers_start()
+{
+
+	// Allocate the circuit breakers in memory shared with the forked agent processes
+	redis_breakers = mmap(NULL, sizeof(redis_breakers_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	// If the allocation failed then every process keeps circuit breakers of its own
+	if (redis_breakers == MAP_FAILED) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Circuit breakers could not be shared (%s)",MODULE,strerror(errno));
+
+		redis_breakers = &redis_breakers_local;
+
+		return 1;
+
+	}
+
+	memset(redis_breakers, 0, sizeof(redis_breakers_t));
+
+	// If the lock could not be shared then every process keeps circuit breakers of its own
+	if (redis_shared_lock_init(&redis_breakers->lock)) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Circuit breakers could not be shared (Lock not supported)",MODULE);
+
+		munmap(redis_breakers, sizeof(redis_breakers_t));
+		redis_breakers = &redis_breakers_local;
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the circuit breakers                  *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_breakers_free()
+{
+
+	// If the circuit breakers are shared
+	if (redis_breakers != NULL && redis_breakers != &redis_breakers_local) {munmap(redis_breakers, sizeof(redis_breakers_t));}
+
+	redis_breakers = &redis_breakers_local;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the circuit breaker of a target (the  *
+ *              lock must be held)                                            *
+ * Returns    : Circuit breaker (found), NULL (not found)                     *
+ *                                                                            *
+ ******************************************************************************/
+static redis_breaker_t * redis_breaker_find(char *target)
+{
+
+	// Declare Variables
+	int count;
+
+	for (count = 0; count < MAX_BREAKER_TARGETS; count++) {
+
+		if (redis_breakers->targets[count].failures > 0 && strcmp(redis_breakers->targets[count].target,target) == 0) {return &redis_breakers->targets[count];}
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will check whether the circuit breaker of a     *
+ *              target is open, once the backoff has expired a single probe   *
+ *              is let through for up to the timeout of the session           *
+ * Returns    : 0 (closed), 1 (open, the last error is set)                   *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_breaker_open(char *target, int timeout, char **zbx_msg)
+{
+
+	// Declare Variables
+	redis_breaker_t *breaker;
+	time_t           now = time(NULL);
+	int              ret = 0, next = 0;
+	char             error[MAX_LENGTH_STRING];
+
+	redis_shared_lock(&redis_breakers->lock, sizeof(redis_breakers_t), 1);
+
+	// If the target has not failed often enough to open the circuit breaker
+	if ((breaker = redis_breaker_find(target)) == NULL || breaker->failures < BREAKER_FAILURES) {goto out;}
+
+	// If the backoff has expired and no other probe is in flight then let this session probe the target
+	if (breaker->open_until <= now && breaker->probe_until <= now) {breaker->probe_until = now + timeout + 1; goto out;}
+
+	// Take a copy of the error (the message is formed once the lock has been released)
+	zbx_strlcpy(error,breaker->error,MAX_LENGTH_STRING);
+	next = (int)((breaker->open_until > now) ? breaker->open_until - now : breaker->probe_until - now);
+
+	ret = 1;
+
+out:
+
+	redis_shared_lock(&redis_breakers->lock, sizeof(redis_breakers_t), 0);
+
+	// Form message
+	if (ret) {*zbx_msg = redis_arena_printf("%s (Circuit breaker open, next attempt in %ds)",error,next);}
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will count a target that could not be reached   *
+ *              and open its circuit breaker after BREAKER_FAILURES in a row  *
+ *              (failures while it is open do not extend the backoff)         *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_breaker_failed(char *target, char *zbx_msg)
+{
+
+	// Declare Variables
+	redis_breaker_t *breaker;
+	time_t           now = time(NULL);
+	int              count, backoff = 0, failures = 0;
+
+	redis_shared_lock(&redis_breakers->lock, sizeof(redis_breakers_t), 1);
+
+	// If the target has no circuit breaker then take a free entry (or the oldest)
+	if ((breaker = redis_breaker_find(target)) == NULL) {
+
+		for (count = 0; count < MAX_BREAKER_TARGETS && redis_breakers->targets[count].failures > 0; count++) {}
+
+		if (count == MAX_BREAKER_TARGETS) {count = redis_breakers->next; redis_breakers->next = (redis_breakers->next + 1) % MAX_BREAKER_TARGETS;}
+
+		breaker = &redis_breakers->targets[count];
+		memset(breaker, 0, sizeof(redis_breaker_t));
+		zbx_strlcpy(breaker->target,target,MAX_LENGTH_STRING);
+
+	}
+
+	// Keep the error to fail fast with
+	breaker->failures++;
+	zbx_strlcpy(breaker->error,zbx_msg,MAX_LENGTH_STRING);
+
+	// If the circuit breaker opens (or the probe after the backoff failed) then back off, twice as long as the last time
+	if (breaker->failures >= BREAKER_FAILURES && breaker->open_until <= now) {
+
+		breaker->backoff     = (breaker->backoff == 0) ? BREAKER_BACKOFF : MIN(breaker->backoff * 2, MAX_BREAKER_BACKOFF);
+		breaker->open_until  = now + breaker->backoff;
+		breaker->probe_until = 0;
+
+		// Take a copy of the backoff (logged once the lock has been released)
+		backoff  = breaker->backoff;
+		failures = breaker->failures;
+
+	}
+
+	redis_shared_lock(&redis_breakers->lock, sizeof(redis_breakers_t), 0);
+
+	// If the circuit breaker opened
+	if (backoff > 0) {
+
+		REDIS_STATS_ADD(breaker_opens, 1);
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Circuit breaker of %s open for %ds after %d failures (%s)",MODULE,target,backoff,failures,zbx_msg);
+
+	}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will close the circuit breaker of a target that *
+ *              has been reached                                              *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_breaker_passed(char *target)
+{
+
+	// Declare Variables
+	redis_breaker_t *breaker;
+	int              closed = 0;
+
+	redis_shared_lock(&redis_breakers->lock, sizeof(redis_breakers_t), 1);
+
+	// If the target has a circuit breaker
+	if ((breaker = redis_breaker_find(target)) != NULL) {
+
+		closed = (breaker->failures >= BREAKER_FAILURES);
+
+		memset(breaker, 0, sizeof(redis_breaker_t));
+
+	}
+
+	redis_shared_lock(&redis_breakers->lock, sizeof(redis_breakers_t), 0);
+
+	// Log message
+	if (closed) {zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Circuit breaker of %s closed",MODULE,target);}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will allocate the host resolution cache in      *
+ *              memory shared with the forked agent processes                 *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_resolves_start()
+{
+
+	// Allocate the cache in memory shared with the forked agent processes
+	redis_resolves = mmap(NULL, sizeof(redis_resolves_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	// If the allocation failed then every process resolves for itself
+	if (redis_resolves == MAP_FAILED) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Host resolution cache could not be shared (%s)",MODULE,strerror(errno));
+
+		redis_resolves = &redis_resolves_local;
+
+		return 1;
+
+	}
+
+	memset(redis_resolves, 0, sizeof(redis_resolves_t));
+
+	// If the lock could not be shared then every process resolves for itself
+	if (redis_shared_lock_init(&redis_resolves->lock)) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Host resolution cache could not be shared (Lock not supported)",MODULE);
+
+		munmap(redis_resolves, sizeof(redis_resolves_t));
+		redis_resolves = &redis_resolves_local;
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the host resolution cache             *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_resolves_free()
+{
+
+	// If the cache is shared
+	if (redis_resolves != NULL && redis_resolves != &redis_resolves_local) {munmap(redis_resolves, sizeof(redis_resolves_t));}
+
+	redis_resolves = &redis_resolves_local;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the cache entry of a host name (the   *
+ *              lock must be held)                                            *
+ * Returns    : Cache entry (found), NULL (not found)                         *
+ *                                                                            *
+ ******************************************************************************/
+static redis_resolve_t * redis_resolve_find(char *redis_host)
+{
+
+	// Declare Variables
+	int count;
+
+	for (count = 0; count < MAX_RESOLVE_HOSTS; count++) {
+
+		if (strcmp(redis_resolves->hosts[count].host,redis_host) == 0) {return &redis_resolves->hosts[count];}
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will resolve a host name into its IPv4 and      *
+ *              IPv6 addresses (IPv4 first, as hiredis does) through the      *
+ *              host resolution cache, an expired host is resolved by one     *
+ *              process while the others use the last addresses, which are    *
+ *              also kept while the resolver fails, the time spent resolving  *
+ *              is added to resolve_time                                      *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_resolve(char *redis_host, char *redis_address, unsigned long long *resolve_time, char **zbx_msg)
+{
+
+	// Declare Variables
+	char                last_address[INET6_ADDRSTRLEN] = "";
+	char                addresses[MAX_RESOLVE_ADDRESSES][INET6_ADDRSTRLEN];
+	unsigned char       numeric[sizeof(struct in6_addr)];
+	struct addrinfo     hints, *resolved = NULL, *next;
+	redis_resolve_t    *entry;
+	time_t              now = time(NULL);
+	unsigned long long  started, elapsed;
+	int                 error, address_count = 0, count, family;
+
+	// If the host is an address already
+	if (inet_pton(AF_INET, redis_host, numeric) == 1 || inet_pton(AF_INET6, redis_host, numeric) == 1) {
+
+		zbx_strlcpy(redis_address,redis_host,INET6_ADDRSTRLEN);
+
+		return 0;
+
+	}
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 1);
+
+	// If the host has been resolved (the addresses are kept even once they have expired)
+	if ((entry = redis_resolve_find(redis_host)) != NULL && entry->address_count > 0) {
+
+		zbx_strlcpy(last_address,entry->addresses[entry->current],INET6_ADDRSTRLEN);
+
+		// If the addresses have not expired (or another process is resolving the host again)
+		if (entry->expires > now || entry->refreshing_until > now) {
+
+			zbx_strlcpy(redis_address,last_address,INET6_ADDRSTRLEN);
+
+			redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 0);
+
+			return 0;
+
+		}
+
+		// Resolve the host again in this process (the mark lapses should this process not finish)
+		entry->refreshing_until = now + RESOLVE_RETRY;
+
+	}
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 0);
+
+	// Resolve the host (without the lock, the resolver may take up to its own timeout)
+	started = redis_stats_clock();
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family   = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	error = getaddrinfo(redis_host, NULL, &hints, &resolved);
+
+	// Count the resolution
+	elapsed = redis_stats_clock() - started;
+	*resolve_time += elapsed;
+
+	REDIS_STATS_ADD(resolves, 1);
+	REDIS_STATS_ADD(resolve_time, elapsed);
+
+	// If the host has been resolved then keep every address (the IPv4 addresses first, in the order hiredis would try them)
+	if (error == 0) {
+
+		for (family = AF_INET; family != 0; family = (family == AF_INET) ? AF_INET6 : 0) {
+
+			for (next = resolved; next != NULL && address_count < MAX_RESOLVE_ADDRESSES; next = next->ai_next) {
+
+				if (next->ai_family != family) {continue;}
+
+				if (family == AF_INET)  {inet_ntop(AF_INET, &((struct sockaddr_in *)next->ai_addr)->sin_addr, addresses[address_count], INET6_ADDRSTRLEN);}
+				if (family == AF_INET6) {inet_ntop(AF_INET6, &((struct sockaddr_in6 *)next->ai_addr)->sin6_addr, addresses[address_count], INET6_ADDRSTRLEN);}
+
+				// If the address is not a duplicate
+				for (count = 0; count < address_count && strcmp(addresses[count],addresses[address_count]) != 0; count++) {}
+
+				if (count == address_count) {address_count++;}
+
+			}
+
+		}
+
+		freeaddrinfo(resolved);
+
+		// If no address was usable
+		if (address_count == 0) {error = EAI_NONAME;}
+
+	}
+
+	// If the host could not be resolved
+	if (error != 0) {
+
+		REDIS_STATS_ADD(resolve_errors, 1);
+
+		// If the host has never been resolved
+		if (strlen(last_address) == 0) {
+
+			// Form message
+			*zbx_msg = redis_arena_printf("Redis server could not be resolved (%s)",gai_strerror(error));
+
+			return 1;
+
+		}
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Host %s could not be resolved (%s), the last address %s is used",MODULE,redis_host,gai_strerror(error),last_address);
+
+	}
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 1);
+
+	// If the host is not cached then take the next entry
+	if ((entry = redis_resolve_find(redis_host)) == NULL) {
+
+		entry = &redis_resolves->hosts[redis_resolves->next];
+		redis_resolves->next = (redis_resolves->next + 1) % MAX_RESOLVE_HOSTS;
+
+		memset(entry, 0, sizeof(redis_resolve_t));
+		zbx_strlcpy(entry->host,redis_host,MAX_LENGTH_STRING);
+
+	}
+
+	// Keep the addresses (the address in use is kept in use if it is still one of them)
+	if (error == 0) {
+
+		for (count = 0, entry->current = 0; count < address_count; count++) {
+
+			if (strcmp(addresses[count],last_address) == 0) {entry->current = count;}
+
+			zbx_strlcpy(entry->addresses[count],addresses[count],INET6_ADDRSTRLEN);
+
+		}
+
+		entry->address_count = address_count;
+
+	}
+
+	// If the entry was taken by another host while the resolver failed then keep the last address
+	if (entry->address_count == 0) {zbx_strlcpy(entry->addresses[0],last_address,INET6_ADDRSTRLEN); entry->address_count = 1;}
+
+	// The last addresses are only retried a little later while the resolver fails
+	entry->expires          = now + ((error == 0) ? RESOLVE_TTL : RESOLVE_RETRY);
+	entry->refreshing_until = 0;
+
+	zbx_strlcpy(redis_address,entry->addresses[entry->current],INET6_ADDRSTRLEN);
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 0);
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will move a host name on to its next address   *
+ *              after a connection error (unless another process has already  *
+ *              moved it on from the address)                                 *
+ * Returns    : Number of addresses of the host (0 if it is not cached)       *
+ *                                                                            *
+ ******************************************************************************/
+int redis_resolve_next(char *redis_host, char *redis_address)
+{
+
+	// Declare Variables
+	redis_resolve_t *entry;
+	int              address_count = 0;
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 1);
+
+	if ((entry = redis_resolve_find(redis_host)) != NULL && entry->address_count > 0) {
+
+		if (strcmp(entry->addresses[entry->current],redis_address) == 0) {entry->current = (entry->current + 1) % entry->address_count;}
+
+		address_count = entry->address_count;
+
+	}
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 0);
+
+	return address_count;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will expire the cached addresses of a host name *
+ *              (ie once every address has failed, the host may have moved),  *
+ *              the addresses are kept in case the resolver fails             *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_resolve_invalidate(char *redis_host)
+{
+
+	// Declare Variables
+	redis_resolve_t *entry;
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 1);
+
+	if ((entry = redis_resolve_find(redis_host)) != NULL) {entry->expires = 0;}
+
+	redis_shared_lock(&redis_resolves->lock, sizeof(redis_resolves_t), 0);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will set the timeout of the next attempt of a   *
+ *              session to what is left of the timeout of the item            *
+ * Returns    : 0 (time left), 1 (timeout used up)                            *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_session_remaining(unsigned long long started, unsigned long long budget, struct timeval *timeout)
+{
+
+	// Declare Variables
+	unsigned long long elapsed = redis_stats_clock() - started;
+
+	// If the timeout of the item is used up
+	if (elapsed >= budget) {return 1;}
+
+	// Set Timeout
+	timeout->tv_sec = (budget - elapsed) / 1000000;
+	timeout->tv_usec = (budget - elapsed) % 1000000;
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will create a redis session on a redis server,  *
+ *              failing fast while the circuit breaker of the server is open  *
+ *              (unless the session is to probe the server regardless)        *
+ * Returns    : Context (success), NULL (failure)                             *
+ *                                                                            *
+ ******************************************************************************/
+static redisContext * redis_session_connect(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int probe)
+{
+
+	// Declare Variables
+	char           *zbx_msg = "";
+	char            redis_host[MAX_LENGTH_STRING], redis_host_port[MAX_LENGTH_PARAM], redis_target[MAX_LENGTH_STRING];
+	char            redis_address[INET6_ADDRSTRLEN];
+	int             redis_sentinel = 0, redis_retry = 0, redis_unreachable = 0, redis_tried = 0;
+	redisReply     *redisR;
+	redisContext   *redisC = NULL;
+	struct timeval  timeout;
+	unsigned long long started = redis_stats_clock(), resolve_time = 0, budget;
+
+	// Set Timeout (every attempt of the session shares the timeout of the item)
+	timeout.tv_sec = atol(redis_timeout);
+	timeout.tv_usec = 0;
+	budget = (unsigned long long)timeout.tv_sec * 1000000;
+
+	// Form the circuit breaker target
+	zbx_snprintf(redis_target,MAX_LENGTH_STRING,"%s:%s",redis_server,redis_port);
+
+	// If the circuit breaker of the server is open then fail fast with the last error
+	if (! probe && redis_breaker_open(redis_target, timeout.tv_sec, &zbx_msg)) {
+
+		// Count the rejected session
+		REDIS_STATS_ADD(breaker_rejects, 1);
+
+		goto session_rejected;
+
+	}
+
+	// If the server is a sentinel target then the master is looked up
+	if (strncmp(redis_server,REDIS_SENTINEL_PREFIX,strlen(REDIS_SENTINEL_PREFIX)) == 0) {redis_sentinel = 1;}
+
+session_connect:
+
+	// Set the address to connect
+	if (! redis_sentinel) {
+
+		zbx_strlcpy(redis_host,redis_server,MAX_LENGTH_STRING);
+		zbx_strlcpy(redis_host_port,redis_port,MAX_LENGTH_PARAM);
+
+	}
+
+	// Get the current master of a sentinel target
+	if (redis_sentinel && redis_session_remaining(started, budget, &timeout)) {goto error_timeout;}
+	if (redis_sentinel && redis_sentinel_master(redis_server, timeout, redis_host, redis_host_port, &zbx_msg)) {redis_unreachable = 1; goto session_invalid;}
+
+session_resolve:
+
+	// Resolve the host through the host resolution cache (the resolver counts against the timeout too)
+	if (redis_session_remaining(started, budget, &timeout)) {goto error_timeout;}
+	if (redis_resolve(redis_host, redis_address, &resolve_time, &zbx_msg)) {redis_unreachable = 1; goto session_invalid;}
+
+	// Attempt the connection with what is left of the timeout
+	if (redis_session_remaining(started, budget, &timeout)) {goto error_timeout;}
+	redisC = redisConnectWithTimeout(redis_address,atol(redis_host_port),timeout);
+
+	// If there was an error connecting
+	if (redisC == NULL || redisC->err) {
+
+		// Try the next address of the host while there is one this session has not tried
+		if (++redis_tried < redis_resolve_next(redis_host, redis_address) && redis_stats_clock() - started < budget) {redisFree(redisC); redisC = NULL; goto session_resolve;}
+
+		// The host may have moved so resolve it again next time
+		redis_resolve_invalidate(redis_host);
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis connection failed (Unknown)");
+
+		// If there is an error message
+		if (redisC != NULL && redisC->err) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("Redis connection failed (%s)",redisC->errstr);
+
+		}
+
+		// A cached sentinel master may be stale so ask the sentinel again (once, while there is time left)
+		if (redis_sentinel && ! redis_retry && redis_stats_clock() - started < budget) {
+
+			// Forget the master
+			redis_sentinel_invalidate(redis_server);
+
+			// Free the context
+			redisFree(redisC);
+			redisC = NULL;
+
+			redis_retry = 1;
+			redis_tried = 0;
+
+			goto session_connect;
+
+		}
+
+		redis_unreachable = 1;
+
+		goto session_invalid;
+
+	}
+
+	// Count the replies, bytes and socket time of the session
+	redis_stats_context(redisC);
+
+#ifdef HAVE_REDIS_RESP3
+
+	// Redis 6+ negotiates RESP3, authenticates and names the session in a single round trip
+	if (! redis_hello_refused(redis_host, redis_host_port, 0)) {
+
+		// Say hello (We want to set the client name in order to exclude from client discovery)
+		if (strlen(redis_password) == 0) {redisR = redis_command_send(redisC,"HELLO 3 SETNAME %s",MODULE);}
+		if (strlen(redis_password) > 0)  {redisR = redis_command_send(redisC,"HELLO 3 AUTH default %s SETNAME %s",redis_password,MODULE);}
+
+		// If the connection is lost
+		if(redisR == NULL) {goto error_connection_lost;}
+
+		// If the session has been negotiated
+		if (redisR->type != REDIS_REPLY_ERROR) {
+
+			// Free the reply
+			redis_reply_free(redisR);
+
+			goto session_valid;
+
+		}
+
+		// If the authentication failed
+		if (strncmp(redisR->str,"WRONGPASS",9) == 0 || strncmp(redisR->str,"NOAUTH",6) == 0) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("Redis authentication failed");
+
+			// Free the reply
+			redis_reply_free(redisR);
+
+			goto session_invalid;
+
+		}
+
+		// Older servers do not know HELLO (or RESP3) so remember that and use RESP2
+		redis_hello_refused(redis_host, redis_host_port, 1);
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+	}
+
+#endif
+
+	// Authenticate with blank password (The assumption is that there could be a blank password)
+	if (strlen(redis_password) == 0) {redisR = redis_command_send(redisC,"AUTH ''");}
+	if (strlen(redis_password) > 0)  {redisR = redis_command_send(redisC,"AUTH %s",redis_password);}
+
+	// If the connection is lost
+	if(redisR == NULL) {goto error_connection_lost;}
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// Test whether authentication has been successful
+	redisR = redis_command_send(redisC,"ECHO Authentication-Test");
+
+	// If the connection is lost
+	if(redisR == NULL) {goto error_connection_lost;}
+
+	// If the authentication failed
+	if (strcmp(redisR->str,"NOAUTH Authentication required.") == 0) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis authentication failed");
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+		goto session_invalid;
+
+	}
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// We want to set the client name in order to exclude from client discovery
+	redisR = redis_command_send(redisC,"CLIENT SETNAME %s",MODULE);
+
+	// If the connection is lost
+	if(redisR == NULL) {goto error_connection_lost;}
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	goto session_valid;
+
+error_timeout:
+
+	// Form message
+	zbx_msg = redis_arena_printf("Redis connection failed (Timeout after %s seconds)",redis_timeout);
+
+	redis_unreachable = 1;
+
+	goto session_invalid;
+
+error_connection_lost:
+
+	// Form message
+	zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+	redis_unreachable = 1;
+
+	goto session_invalid;
+
+session_valid:
+
+	// Count the session (the time spent resolving is counted as resolve.time)
+	REDIS_STATS_ADD(sessions, 1);
+	REDIS_STATS_ADD(session_time, redis_stats_clock() - started - resolve_time);
+
+	// Close the circuit breaker of the server
+	redis_breaker_passed(redis_target);
+
+	return redisC;
+
+session_invalid:
+
+	// Count the failed session (the time spent resolving is counted as resolve.time)
+	REDIS_STATS_ADD(session_errors, 1);
+	REDIS_STATS_ADD(session_time, redis_stats_clock() - started - resolve_time);
+
+	// Count a server that could not be reached towards its circuit breaker (a server refusing the password was reached)
+	if (redis_unreachable)   {redis_breaker_failed(redis_target, zbx_msg);}
+	if (! redis_unreachable) {redis_breaker_passed(redis_target);}
+
+	// Free the context
+	redisFree(redisC);
+
+session_rejected:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will create a redis session on a redis server   *
+ * Returns    : Context (success), NULL (failure)                             *
+ *                                                                            *
+ ******************************************************************************/
+redisContext * redis_session(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password)
+{
+
+	return redis_session_connect(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password, 0);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will create a redis session on a redis server   *
+ *              even while its circuit breaker is open (the real state of the *
+ *              server is wanted), the outcome still opens or closes it       *
+ * Returns    : Context (success), NULL (failure)                             *
+ *                                                                            *
+ ******************************************************************************/
+redisContext * redis_session_probe(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password)
+{
+
+	return redis_session_connect(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password, 1);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will run a redis command and set the reply      *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_command(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, redisReply **redisRptr, char *command, char *param, int redisReplyType)
+{
+
+	// Declare Variables
+	char         *zbx_msg = "";
+	char          redisCmd[MAX_LENGTH_STRING];
+	redisReply   *redisR;
+
+	// If there are parameters
+	if (param != NULL) {zbx_snprintf(redisCmd,MAX_LENGTH_STRING,"%s %s",command,param);}
+
+	// If there are no parameters
+	if (param == NULL) {zbx_snprintf(redisCmd,MAX_LENGTH_STRING,"%s",command);}
+
+	// If the connection is lost
+	if (redisC == NULL || redisC->err) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+		goto command_invalid;
+
+	}
+
+	// Run the redis command
+	redisR = redis_command_send(redisC,redisCmd);
+
+	// If the connection is lost
+	if (redisR == NULL) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+		goto command_invalid;
+
+	}
+
+	// If the reply type is an error
+	if (redisR->type == REDIS_REPLY_ERROR) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis command error (%s)",redisR->str);
+
+		goto command_invalid;
+
+
+	}
+
+	// If the redis reply type is to be checked
+	if (redisReplyType == 9999) {goto command_valid;}
+
+	// If the reply is not valid
+	if (redis_reply_valid(redisR->type,redisReplyType,command,zbx_key,&zbx_msg) == 1) {goto command_invalid;}
+
+command_valid:
+
+	// Assign the reply
+	*redisRptr = redisR;
+
+	return 0;
+
+command_invalid:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get a cached reply if it has not expired   *
+ * Returns    : Reply (success), NULL (failure)                               *
+ *                                                                            *
+ ******************************************************************************/
+redisReply * redis_cache_get(char *redis_server, char *redis_port, char *command)
+{
+
+	// Declare Variables
+	char  *redis_target;
+	int    count;
+	time_t now = time(NULL);
+
+	// Form the target
+	redis_target = redis_arena_printf("%s:%s|%s",redis_server,redis_port,command);
+
+	// Find the cached reply
+	for (count = 0; count < MAX_CACHE_ENTRIES; count++) {
+
+		// If the entry does not match
+		if (redis_cache[count].reply == NULL || strcmp(redis_cache[count].target,redis_target) != 0) {continue;}
+
+		// If the entry has expired
+		if (redis_cache[count].expires <= now) {return NULL;}
+
+		return redis_cache[count].reply;
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get a reply owned by a cached reply (ie    *
+ *              the reply about one of its elements)                          *
+ * Returns    : Reply (success), NULL (failure)                               *
+ *                                                                            *
+ ******************************************************************************/
+redisReply * redis_cache_child(char *redis_server, char *redis_port, char *command, size_t index)
+{
+
+	// Declare Variables
+	char  *redis_target;
+	int    count;
+	time_t now = time(NULL);
+
+	// Form the target
+	redis_target = redis_arena_printf("%s:%s|%s",redis_server,redis_port,command);
+
+	// Find the cached reply
+	for (count = 0; count < MAX_CACHE_ENTRIES; count++) {
+
+		// If the entry does not match
+		if (redis_cache[count].reply == NULL || strcmp(redis_cache[count].target,redis_target) != 0) {continue;}
+
+		// If the entry has expired or has no such reply
+		if (redis_cache[count].expires <= now || index >= redis_cache[count].child_count) {return NULL;}
+
+		return redis_cache[count].children[index];
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the replies of a cache entry          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_cache_clear(redis_cache_t *entry)
+{
+
+	// Declare Variables
+	size_t count;
+
+	// Free the replies owned by the reply
+	for (count = 0; count < entry->child_count; count++) {if (entry->children[count] != NULL) {redis_reply_free(entry->children[count]);}}
+
+	zbx_free(entry->children);
+	entry->child_count = 0;
+
+	// Free the reply
+	if (entry->reply != NULL) {redis_reply_free(entry->reply);}
+
+	entry->reply = NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will cache a reply (The cache owns the reply)   *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_cache_set(char *redis_server, char *redis_port, char *command, redisReply *redisR, int ttl)
+{
+
+	redis_cache_set_children(redis_server, redis_port, command, redisR, NULL, 0, ttl);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will cache a reply along with the replies about *
+ *              its elements, which are evicted with it (The cache owns the   *
+ *              replies and the array of children)                            *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_cache_set_children(char *redis_server, char *redis_port, char *command, redisReply *redisR, redisReply **children, size_t child_count, int ttl)
+{
+
+	// Declare Variables
+	char  *redis_target;
+	int    count, slot = -1;
+
+	// Form the target
+	redis_target = redis_arena_printf("%s:%s|%s",redis_server,redis_port,command);
+
+	// Reuse the entry of the target if there is one
+	for (count = 0; count < MAX_CACHE_ENTRIES; count++) {
+
+		if (redis_cache[count].reply != NULL && strcmp(redis_cache[count].target,redis_target) == 0) {slot = count; break;}
+
+	}
+
+	// Otherwise take the next entry (the oldest entry is replaced when full)
+	if (slot == -1) {
+
+		slot = redis_cache_next;
+		redis_cache_next = (redis_cache_next + 1) % MAX_CACHE_ENTRIES;
+
+	}
+
+	// Free the previous replies
+	redis_cache_clear(&redis_cache[slot]);
+
+	// Set the entry
+	zbx_strlcpy(redis_cache[slot].target,redis_target,MAX_LENGTH_KEY);
+	redis_cache[slot].expires     = time(NULL) + ttl;
+	redis_cache[slot].reply       = redisR;
+	redis_cache[slot].children    = children;
+	redis_cache[slot].child_count = child_count;
+
+}
+
+/***********************************************************************************
+ *                                                                                 *
+ * Function   : This function will get a reply from the cache, or on a miss run    *
+ *              all of the commands in a single pipelined round trip and cache     *
+ *              every reply (commands are formatted by hiredis and must not        *
+ *              contain user input)                                                *
+ * Returns    : 0 (success), 1 (failure)                                           *
+ *                                                                                 *
+ ***********************************************************************************/
+int redis_cache_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, char **commands, int command_count, int command_index, int redisReplyType, redisReply **redisRptr)
+{
+
+	// Declare Variables
+	char         *zbx_msg = "";
+	int           count, ret = 0;
+	redisContext *redisC;
+	redisReply   *redisR;
+
+	// If the reply is cached
+	if ((*redisRptr = redis_cache_get(redis_server, redis_port, commands[command_index])) != NULL) {REDIS_STATS_ADD(cache_hits, 1); goto fetch_valid;}
+
+	REDIS_STATS_ADD(cache_misses, 1);
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password)) == NULL) {return 1;}
+
+	// Pipeline the commands
+	for (count = 0; count < command_count; count++) {redis_command_append(redisC,commands[count]);}
+
+	// Read every reply
+	for (count = 0; count < command_count; count++) {
+
+		// If the connection is lost
+		if (redisGetReply(redisC,(void **)&redisR) != REDIS_OK || redisR == NULL) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+			ret = 1;
+
+			break;
+
+		}
+
+		// If the reply type is an error (Errors are not cached)
+		if (redisR->type == REDIS_REPLY_ERROR) {
+
+			// Form message
+			if (count == command_index) {zbx_msg = redis_arena_printf("Redis command error (%s)",redisR->str);}
+
+			// Free the reply
+			redis_reply_free(redisR);
+
+			continue;
+
+		}
+
+		// Cache the reply
+		redis_cache_set(redis_server, redis_port, commands[count], redisR, cache_ttl);
+
+	}
+
+	// Free the context
+	redisFree(redisC);
+
+	// If the connection was lost
+	if (ret) {goto fetch_invalid;}
+
+	// If the reply was an error
+	if ((*redisRptr = redis_cache_get(redis_server, redis_port, commands[command_index])) == NULL) {goto fetch_invalid;}
+
+fetch_valid:
+
+	// If the redis reply type is to be checked
+	if (redisReplyType == 9999) {return 0;}
+
+	// If the reply is not valid
+	if (redis_reply_valid((*redisRptr)->type,redisReplyType,commands[command_index],zbx_key,&zbx_msg) == 1) {goto fetch_invalid;}
+
+	return 0;
+
+fetch_invalid:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	return 1;
+
+}
+
+/**********************************************************************************
+ *                                                                                *
+ * Function   : This function will get the consumer groups of a stream from the   *
+ *              cache, or on a miss run XINFO GROUPS and then pipeline XINFO      *
+ *              CONSUMERS for every group, caching the consumers with the groups  *
+ *              (evicted together) so that all group and consumer keys of a       *
+ *              stream are served by one fetch per poll                           *
+ * Returns    : 0 (success), 1 (failure)                                          *
+ *                                                                                *
+ **********************************************************************************/
+int redis_stream_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, char *database, char *stream, redisReply **redisRptr)
+{
+
+	// Declare Variables
+	char         *zbx_msg = "";
+	char         *redis_label;
+	int           ret = SYSINFO_RET_FAIL;
+	size_t        count;
+	redisContext *redisC;
+	redisReply   *redisR, *redisConsumers, *redisGroup;
+	redisReply  **redisChildren = NULL;
+
+	// Form the cache label (the label is only used to find the cache entry)
+	redis_label = redis_arena_printf("%s|XINFO GROUPS %s",database,stream);
+
+	// If the groups are cached
+	if ((*redisRptr = redis_cache_get(redis_server, redis_port, redis_label)) != NULL) {REDIS_STATS_ADD(cache_hits, 1); return 0;}
+
+	REDIS_STATS_ADD(cache_misses, 1);
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password)) == NULL) {return 1;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, database)) {goto fetch_out;}
+
+	// Get the groups
+	if ((redisR = redis_command_send(redisC,"XINFO GROUPS %s",stream)) == NULL) {goto fetch_lost;}
+
+	// If the reply type is an error (ie the stream does not exist)
+	if (redisR->type == REDIS_REPLY_ERROR) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis command error (%s)",redisR->str);
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+		goto fetch_invalid;
+
+	}
+
+	// If the reply is not valid
+	if (redis_reply_valid(redisR->type,REDIS_REPLY_ARRAY,"XINFO GROUPS",zbx_key,&zbx_msg) == 1) {redis_reply_free(redisR); goto fetch_invalid;}
+
+	// Pipeline the consumers of every group
+	for (count = 0; count < redisR->elements; count++) {
+
+		if ((redisGroup = redis_reply_map_value(redisR->element[count], "name")) == NULL || redisGroup->str == NULL) {continue;}
+
+		redis_command_append(redisC,"XINFO CONSUMERS %s %s",stream,redisGroup->str);
+
+	}
+
+	// Keep the consumers of every group by the index of the group
+	if (redisR->elements > 0) {redisChildren = zbx_malloc(NULL, sizeof(redisReply *) * redisR->elements); memset(redisChildren, 0, sizeof(redisReply *) * redisR->elements);}
+
+	for (count = 0; count < redisR->elements; count++) {
+
+		if ((redisGroup = redis_reply_map_value(redisR->element[count], "name")) == NULL || redisGroup->str == NULL) {continue;}
+
+		// If the connection is lost
+		if (redisGetReply(redisC,(void **)&redisConsumers) != REDIS_OK) {
+
+			// Free the replies
+			for (count = 0; count < redisR->elements; count++) {if (redisChildren[count] != NULL) {redis_reply_free(redisChildren[count]);}}
+			zbx_free(redisChildren);
+			redis_reply_free(redisR);
+
+			goto fetch_lost;
+
+		}
+
+		// If the reply type is an error (ie the group was deleted between the calls)
+		if (redisConsumers->type == REDIS_REPLY_ERROR) {redis_reply_free(redisConsumers); continue;}
+
+		redisChildren[count] = redisConsumers;
+
+	}
+
+	// Cache the groups with the consumers of every group (The cache owns the replies)
+	redis_label = redis_arena_printf("%s|XINFO GROUPS %s",database,stream);
+	redis_cache_set_children(redis_server, redis_port, redis_label, redisR, redisChildren, redisR->elements, cache_ttl);
+
+	// Assign the reply
+	*redisRptr = redisR;
+
+	// Free the context
+	redisFree(redisC);
+
+	return 0;
+
+fetch_lost:
+
+	// Form message
+	zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+fetch_invalid:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+fetch_out:
+
+	// Free the context
+	redisFree(redisC);
+
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the cached consumers of a stream group *
+ *              (cached with the groups by redis_stream_fetch)                *
+ * Returns    : Reply (success), NULL (failure)                               *
+ *                                                                            *
+ ******************************************************************************/
+redisReply * redis_stream_consumers(char *redis_server, char *redis_port, char *database, char *stream, char *group)
+{
+
+	// Declare Variables
+	char       *redis_label;
+	redisReply *redisR, *redisGroup;
+	size_t      count;
+
+	// Form the cache label
+	redis_label = redis_arena_printf("%s|XINFO GROUPS %s",database,stream);
+
+	// If the groups are not cached
+	if ((redisR = redis_cache_get(redis_server, redis_port, redis_label)) == NULL) {return NULL;}
+
+	// Find the group
+	for (count = 0; count < redisR->elements; count++) {
+
+		if ((redisGroup = redis_reply_map_value(redisR->element[count], "name")) == NULL || redisGroup->str == NULL) {continue;}
+
+		if (strcmp(redisGroup->str,group) == 0) {return redis_cache_child(redis_server, redis_port, redis_label, count);}
+
+	}
+
+	return NULL;
+
+}
+
+/**********************************************************************************
+ *                                                                                *
+ * Function   : This function will get the pub/sub channels matching a pattern    *
+ *              and their subscriber counts from the cache, or on a miss pipeline *
+ *              PUBSUB CHANNELS with PUBSUB NUMPAT and then batch PUBSUB NUMSUB   *
+ *              for every channel, caching every reply so that all pub/sub keys   *
+ *              of a pattern are served by one fetch per poll                     *
+ * Returns    : 0 (success), 1 (failure)                                          *
+ *                                                                                *
+ *********************************************************************************/
+int redis_pubsub_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, char *pattern, redisReply **channelsptr, redisReply **numsubptr)
+{
+
+	// Declare Variables
+	char          *zbx_msg = "";
+	char          *redis_label;
+	size_t         count;
+	redisContext  *redisC;
+	redisReply    *redisR, *redisNumpat, *redisNumsub = NULL;
+	const char   **argv;
+	size_t        *argvlen;
+
+	// Form the cache label (the label is only used to find the cache entry)
+	redis_label = redis_arena_printf("PUBSUB NUMSUB %s",pattern);
+	*numsubptr = redis_cache_get(redis_server, redis_port, redis_label);
+
+	// If the channels are cached (there are no subscriber counts when no channel matched)
+	redis_label = redis_arena_printf("PUBSUB CHANNELS %s",pattern);
+	if ((*channelsptr = redis_cache_get(redis_server, redis_port, redis_label)) != NULL && ((*channelsptr)->elements == 0 || *numsubptr != NULL)) {REDIS_STATS_ADD(cache_hits, 1); return 0;}
+
+	REDIS_STATS_ADD(cache_misses, 1);
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password)) == NULL) {return 1;}
+
+	// Pipeline the channels and the pattern count
+	redis_command_append(redisC,"PUBSUB CHANNELS %s",pattern);
+	redis_command_append(redisC,"PUBSUB NUMPAT");
+
+	// If the connection is lost
+	if (redisGetReply(redisC,(void **)&redisR) != REDIS_OK) {goto fetch_lost;}
+	if (redisGetReply(redisC,(void **)&redisNumpat) != REDIS_OK) {redis_reply_free(redisR); goto fetch_lost;}
+
+	// Cache the pattern count (Errors are not cached)
+	if (redisNumpat->type == REDIS_REPLY_INTEGER) {redis_cache_set(redis_server, redis_port, "PUBSUB NUMPAT", redisNumpat, cache_ttl);}
+	else                                          {redis_reply_free(redisNumpat);}
+
+	// If the reply type is an error (ie PUBSUB is not permitted)
+	if (redisR->type == REDIS_REPLY_ERROR) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis command error (%s)",redisR->str);
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+		goto fetch_invalid;
+
+	}
+
+	// If the reply is not valid
+	if (redis_reply_valid(redisR->type,REDIS_REPLY_ARRAY,"PUBSUB CHANNELS",zbx_key,&zbx_msg) == 1) {redis_reply_free(redisR); goto fetch_invalid;}
+
+	// If any channel matched
+	if (redisR->elements > 0) {
+
+		// Take the arguments from the request arena (PUBSUB NUMSUB channel [channel ...])
+		argv    = (const char **)redis_arena_alloc((redisR->elements + 2) * sizeof(char *));
+		argvlen = (size_t *)redis_arena_alloc((redisR->elements + 2) * sizeof(size_t));
+
+		argv[0] = "PUBSUB"; argvlen[0] = 6;
+		argv[1] = "NUMSUB"; argvlen[1] = 6;
+
+		for (count = 0; count < redisR->elements; count++) {
+
+			argv[count + 2]    = redisR->element[count]->str;
+			argvlen[count + 2] = redisR->element[count]->len;
+
+		}
+
+		// Get the subscriber counts of every channel in a single command
+		redisNumsub = redis_command_send_argv(redisC, (int)(redisR->elements + 2), argv, argvlen);
+
+		// If the connection is lost
+		if (redisNumsub == NULL) {redis_reply_free(redisR); goto fetch_lost;}
+
+		// If the reply is not valid
+		if (redis_reply_valid(redisNumsub->type,REDIS_REPLY_ARRAY,"PUBSUB NUMSUB",zbx_key,&zbx_msg) == 1) {redis_reply_free(redisNumsub); redis_reply_free(redisR); goto fetch_invalid;}
+
+		// Cache the subscriber counts (The cache owns the reply)
+		redis_label = redis_arena_printf("PUBSUB NUMSUB %s",pattern);
+		redis_cache_set(redis_server, redis_port, redis_label, redisNumsub, cache_ttl);
+
+	}
+
+	// Cache the channels (The cache owns the reply)
+	redis_label = redis_arena_printf("PUBSUB CHANNELS %s",pattern);
+	redis_cache_set(redis_server, redis_port, redis_label, redisR, cache_ttl);
+
+	// Assign the replies
+	*channelsptr = redisR;
+	*numsubptr   = redisNumsub;
+
+	// Free the context
+	redisFree(redisC);
+
+	return 0;
+
+fetch_lost:
+
+	// Form message
+	zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+fetch_invalid:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	// Free the context
+	redisFree(redisC);
+
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the subscriber count of a channel from *
+ *              a PUBSUB NUMSUB reply (channels without subscribers are not   *
+ *              listed by PUBSUB CHANNELS so they have no subscribers)        *
+ * Returns    : Subscriber count                                              *
+ *                                                                            *
+ *****************************************************************************/
+long long redis_pubsub_subscribers(redisReply *redisNumsub, char *channel)
+{
+
+	// Declare Variables
+	size_t count;
+
+	// If there are no subscriber counts
+#ifdef HAVE_REDIS_RESP3
+	if (redisNumsub == NULL || (redisNumsub->type != REDIS_REPLY_ARRAY && redisNumsub->type != REDIS_REPLY_MAP)) {return 0;}
+#else
+	if (redisNumsub == NULL || redisNumsub->type != REDIS_REPLY_ARRAY) {return 0;}
+#endif
+
+	// Find the channel (the reply is a flat array of channel and count pairs, or a map laid out the same way on RESP3)
+	for (count = 0; count + 1 < redisNumsub->elements; count += 2) {
+
+		if (redisNumsub->element[count]->str == NULL || strcmp(redisNumsub->element[count]->str,channel) != 0) {continue;}
+
+		return redisNumsub->element[count + 1]->integer;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free all cached replies                    *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_cache_free()
+{
+
+	// Declare Variables
+	int count;
+
+	// Free every reply
+	for (count = 0; count < MAX_CACHE_ENTRIES; count++) {redis_cache_clear(&redis_cache[count]);}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will allocate the big key sampler states in     *
+ *              memory shared with the forked agent processes                 *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_bigkeys_start()
+{
+
+	// Allocate the states in memory shared with the forked agent processes
+	redis_bigkeys = mmap(NULL, sizeof(redis_bigkeys_table_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	// If the allocation failed then every process samples on its own
+	if (redis_bigkeys == MAP_FAILED) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Big key sampler states could not be shared (%s)",MODULE,strerror(errno));
+
+		redis_bigkeys = &redis_bigkeys_local;
+
+		return 1;
+
+	}
+
+	memset(redis_bigkeys, 0, sizeof(redis_bigkeys_table_t));
+
+	// If the lock could not be shared then every process samples on its own
+	if (redis_shared_lock_init(&redis_bigkeys->lock)) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Big key sampler states could not be shared (Lock not supported)",MODULE);
+
+		munmap(redis_bigkeys, sizeof(redis_bigkeys_table_t));
+		redis_bigkeys = &redis_bigkeys_local;
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get a copy of the big key sampler state of *
+ *              a target, the copy lasts until the handler returns (the least *
+ *              recently created state is reused when full)                   *
+ * Returns    : State                                                         *
+ *                                                                            *
+ ******************************************************************************/
+redis_bigkeys_t * redis_bigkeys_get(char *redis_server, char *redis_port, char *database)
+{
+
+	// Declare Variables
+	char             redis_target[MAX_LENGTH_STRING];
+	int              count;
+	redis_bigkeys_t *bigkeys, *copy;
+
+	// Form the target
+	zbx_snprintf(redis_target,MAX_LENGTH_STRING,"%s:%s/%s",redis_server,redis_port,database);
+
+	// Take the copy from the request arena (the scan runs without holding the lock)
+	copy = redis_arena_alloc(sizeof(redis_bigkeys_t));
+
+	redis_shared_lock(&redis_bigkeys->lock, sizeof(redis_bigkeys_table_t), 1);
+
+	// Find the state of the target
+	for (count = 0; count < MAX_BIGKEYS_TARGETS && strcmp(redis_bigkeys->targets[count].target,redis_target) != 0; count++) {}
+
+	// If the target has no state then reset the next
+	if (count == MAX_BIGKEYS_TARGETS) {
+
+		bigkeys = &redis_bigkeys->targets[redis_bigkeys->next];
+		memset(bigkeys, 0, sizeof(redis_bigkeys_t));
+		zbx_strlcpy(bigkeys->target,redis_target,MAX_LENGTH_STRING);
+		zbx_strlcpy(bigkeys->cursor,"0",sizeof(bigkeys->cursor));
+		bigkeys->started = time(NULL);
+
+		// Move to the next state
+		redis_bigkeys->next = (redis_bigkeys->next + 1) % MAX_BIGKEYS_TARGETS;
+
+	} else {bigkeys = &redis_bigkeys->targets[count];}
+
+	memcpy(copy, bigkeys, sizeof(redis_bigkeys_t));
+
+	redis_shared_lock(&redis_bigkeys->lock, sizeof(redis_bigkeys_table_t), 0);
+
+	return copy;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will store the copy of a big key sampler state  *
+ *              once a batch has been scanned (a copy that another process    *
+ *              has already moved on from is dropped, its batch is scanned    *
+ *              again by the next poll)                                       *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_bigkeys_put(redis_bigkeys_t *bigkeys)
+{
+
+	// Declare Variables
+	int count;
+
+	redis_shared_lock(&redis_bigkeys->lock, sizeof(redis_bigkeys_table_t), 1);
+
+	// Find the state of the target
+	for (count = 0; count < MAX_BIGKEYS_TARGETS && strcmp(redis_bigkeys->targets[count].target,bigkeys->target) != 0; count++) {}
+
+	// If the state is the one the copy was taken from
+	if (count < MAX_BIGKEYS_TARGETS && redis_bigkeys->targets[count].steps + 1 == bigkeys->steps) {memcpy(&redis_bigkeys->targets[count], bigkeys, sizeof(redis_bigkeys_t));}
+
+	redis_shared_lock(&redis_bigkeys->lock, sizeof(redis_bigkeys_table_t), 0);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will restore the min heap order of the top-K    *
+ *              big keys from an element downwards                            *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_bigkeys_heap_down(redis_bigkey_t *heap, int heap_count, int element)
+{
+
+	// Declare Variables
+	int            child;
+	redis_bigkey_t swap;
+
+	// While the element has children
+	while ((child = element * 2 + 1) < heap_count) {
+
+		// Use the smaller child
+		if (child + 1 < heap_count && heap[child + 1].bytes < heap[child].bytes) {child++;}
+
+		// If the order is correct
+		if (heap[element].bytes <= heap[child].bytes) {break;}
+
+		// Swap the elements
+		swap = heap[element]; heap[element] = heap[child]; heap[child] = swap;
+		element = child;
+
+	}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will add a key to the top-K big key heap        *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_bigkeys_heap_add(redis_bigkeys_t *bigkeys, int topk, char *key, char *type, unsigned long long bytes)
+{
+
+	// Declare Variables
+	int            count, element;
+	unsigned int   hash;
+	redis_bigkey_t swap;
+
+	// If the heap is full and the key is not bigger than the smallest
+	if (bigkeys->heap_count >= topk && bytes <= bigkeys->heap[0].bytes) {return;}
+
+	// If the key is already held (SCAN may return a key more than once, held keys are truncated so the full name is hashed)
+	hash = redis_hash(key, strlen(key));
+
+	for (count = 0; count < bigkeys->heap_count; count++) {
+
+		if (bigkeys->heap[count].hash == hash && strncmp(bigkeys->heap[count].key,key,MAX_BIGKEYS_NAME - 1) == 0) {return;}
+
+	}
+
+	// If the heap is full then replace the smallest
+	if (bigkeys->heap_count >= topk) {
+
+		zbx_strlcpy(bigkeys->heap[0].key,key,MAX_BIGKEYS_NAME);
+		zbx_strlcpy(bigkeys->heap[0].type,type,sizeof(bigkeys->heap[0].type));
+		bigkeys->heap[0].bytes = bytes;
+		bigkeys->heap[0].hash  = hash;
+
+		redis_bigkeys_heap_down(bigkeys->heap, bigkeys->heap_count, 0);
+
+		return;
+
+	}
+
+	// Add the key at the end and move it upwards
+	element = bigkeys->heap_count++;
+	zbx_strlcpy(bigkeys->heap[element].key,key,MAX_BIGKEYS_NAME);
+	zbx_strlcpy(bigkeys->heap[element].type,type,sizeof(bigkeys->heap[element].type));
+	bigkeys->heap[element].bytes = bytes;
+	bigkeys->heap[element].hash  = hash;
+
+	while (element > 0 && bigkeys->heap[(element - 1) / 2].bytes > bigkeys->heap[element].bytes) {
+
+		swap = bigkeys->heap[element]; bigkeys->heap[element] = bigkeys->heap[(element - 1) / 2]; bigkeys->heap[(element - 1) / 2] = swap;
+		element = (element - 1) / 2;
+
+	}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Sort comparators for publishing (largest first)               *
+ * Returns    : <0, 0, >0                                                     *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_bigkeys_compare_key(const void *a, const void *b)
+{
+
+	// Declare Variables
+	const redis_bigkey_t *key_a = a, *key_b = b;
+
+	return (key_a->bytes < key_b->bytes) - (key_a->bytes > key_b->bytes);
+
+}
+
+static int redis_bigkeys_compare_prefix(const void *a, const void *b)
+{
+
+	// Declare Variables
+	const redis_bigkeys_prefix_t *prefix_a = a, *prefix_b = b;
+
+	return (prefix_a->bytes < prefix_b->bytes) - (prefix_a->bytes > prefix_b->bytes);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will publish a completed scan cycle and start   *
+ *              the next one                                                  *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_bigkeys_publish(redis_bigkeys_t *bigkeys)
+{
+
+	// Declare Variables
+	int                 count, prefix, samples;
+	double              scale;
+
+	// Publish the top-K big keys largest first
+	memcpy(bigkeys->top, bigkeys->heap, sizeof(redis_bigkey_t) * bigkeys->heap_count);
+	bigkeys->top_count = bigkeys->heap_count;
+	qsort(bigkeys->top, bigkeys->top_count, sizeof(redis_bigkey_t), redis_bigkeys_compare_key);
+
+	// Aggregate the reservoir by prefix
+	samples = MIN(bigkeys->keys, BIGKEYS_RESERVOIR_SIZE);
+	bigkeys->prefix_count = 0;
+
+	for (count = 0; count < samples; count++) {
+
+		// Find the prefix
+		for (prefix = 0; prefix < bigkeys->prefix_count; prefix++) {
+
+			if (strcmp(bigkeys->prefixes[prefix].prefix,bigkeys->reservoir[count].prefix) == 0) {break;}
+
+		}
+
+		// If the prefix is new
+		if (prefix == bigkeys->prefix_count) {
+
+			zbx_strlcpy(bigkeys->prefixes[prefix].prefix,bigkeys->reservoir[count].prefix,MAX_BIGKEYS_NAME);
+			bigkeys->prefixes[prefix].keys  = 0;
+			bigkeys->prefixes[prefix].bytes = 0;
+			bigkeys->prefix_count++;
+
+		}
+
+		bigkeys->prefixes[prefix].keys  += 1;
+		bigkeys->prefixes[prefix].bytes += bigkeys->reservoir[count].bytes;
+
+	}
+
+	// Scale the samples up to the keys scanned (every scanned key had the same chance of being sampled)
+	for (prefix = 0; prefix < bigkeys->prefix_count && samples > 0; prefix++) {
+
+		scale = (double)bigkeys->keys / samples;
+		bigkeys->prefixes[prefix].keys  = (unsigned long long)(bigkeys->prefixes[prefix].keys * scale);
+		bigkeys->prefixes[prefix].bytes = (unsigned long long)(bigkeys->prefixes[prefix].bytes * scale);
+
+	}
+
+	qsort(bigkeys->prefixes, bigkeys->prefix_count, sizeof(redis_bigkeys_prefix_t), redis_bigkeys_compare_prefix);
+
+	// Publish the totals
+	bigkeys->published_keys     = bigkeys->keys;
+	bigkeys->published_bytes    = bigkeys->bytes;
+	bigkeys->published          = time(NULL);
+	bigkeys->published_duration = bigkeys->published - bigkeys->started;
+	bigkeys->cycles++;
+
+	// Start the next cycle
+	bigkeys->heap_count = 0;
+	bigkeys->keys       = 0;
+	bigkeys->bytes      = 0;
+	bigkeys->started    = bigkeys->published;
+
+}
+
+/**********************************************************************************
+ *                                                                                *
+ * Function   : This function will scan the next batch of keys, size them with a  *
+ *              pipelined TYPE and MEMORY USAGE per key and update the sampler     *
+ * Returns    : 0 (success), 1 (failure)                                          *
+ *                                                                                *
+ **********************************************************************************/
+int redis_bigkeys_step(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, redis_bigkeys_t *bigkeys, int count, int samples, int topk)
+{
+
+	// Declare Variables
+	char               *zbx_msg = "";
+	redisReply         *redisR, *redisKeys, *redisType, *redisUsage;
+	size_t              element;
+	unsigned long long  sample;
+	char                prefix[MAX_BIGKEYS_NAME], *delimiter;
+
+	// Scan the next batch of keys
+	redisR = redis_command_send(redisC,"SCAN %s COUNT %d",bigkeys->cursor,count);
+
+	// If the connection is lost
+	if (redisR == NULL) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+		goto step_invalid;
+
+	}
+
+	// If the reply is not a cursor and batch of keys
+	if (redisR->type != REDIS_REPLY_ARRAY || redisR->elements != 2 || redisR->element[1]->type != REDIS_REPLY_ARRAY) {
+
+		// Form message
+		if (redisR->type == REDIS_REPLY_ERROR) {zbx_msg = redis_arena_printf("Redis command error (%s)",redisR->str);}
+		if (redisR->type != REDIS_REPLY_ERROR) {zbx_msg = redis_arena_printf("Redis command (SCAN) returned an unexpected reply");}
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+		goto step_invalid;
+
+	}
+
+	// Pipeline the type and memory usage of every key in the batch
+	redisKeys = redisR->element[1];
+
+	for (element = 0; element < redisKeys->elements; element++) {
+
+		redis_command_append(redisC,"TYPE %b",redisKeys->element[element]->str,(size_t)redisKeys->element[element]->len);
+		redis_command_append(redisC,"MEMORY USAGE %b SAMPLES %d",redisKeys->element[element]->str,(size_t)redisKeys->element[element]->len,samples);
+
+	}
+
+	// Read the replies of every key
+	for (element = 0; element < redisKeys->elements; element++) {
+
+		// If the connection is lost
+		if (redisGetReply(redisC,(void **)&redisType) != REDIS_OK) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+			// Free the reply
+			redis_reply_free(redisR);
+
+			goto step_invalid;
+
+		}
+
+		// If the connection is lost
+		if (redisGetReply(redisC,(void **)&redisUsage) != REDIS_OK) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+			// Free the replies
+			redis_reply_free(redisType);
+			redis_reply_free(redisR);
+
+			goto step_invalid;
+
+		}
+
+		// If the key could not be typed or sized (ie MEMORY is not supported or is denied by an ACL)
+		if (redisType->type == REDIS_REPLY_ERROR || redisUsage->type == REDIS_REPLY_ERROR) {
+
+			// Form message
+			zbx_msg = redis_arena_printf("Redis command error (%s)",(redisType->type == REDIS_REPLY_ERROR) ? redisType->str : redisUsage->str);
+
+			// Free the replies
+			redis_reply_free(redisType);
+			redis_reply_free(redisUsage);
+			redis_reply_free(redisR);
+
+			goto step_invalid;
+
+		}
+
+		// If the key has been sized (keys can expire between SCAN and MEMORY USAGE, which then replies nil)
+		if (redisUsage->type == REDIS_REPLY_INTEGER && redisType->str != NULL) {
+
+			// Set the prefix (keys without a delimiter share an empty prefix)
+			zbx_strlcpy(prefix,redisKeys->element[element]->str,MAX_BIGKEYS_NAME);
+			if ((delimiter = strchr(prefix,BIGKEYS_PREFIX_DELIMITER)) != NULL) {*delimiter = '\0';} else {prefix[0] = '\0';}
+
+			// Add the key to the reservoir (Algorithm R keeps a uniform sample of the cycle)
+			sample = bigkeys->keys < BIGKEYS_RESERVOIR_SIZE ? bigkeys->keys : (unsigned long long)random() % (bigkeys->keys + 1);
+
+			if (sample < BIGKEYS_RESERVOIR_SIZE) {
+
+				zbx_strlcpy(bigkeys->reservoir[sample].prefix,prefix,MAX_BIGKEYS_NAME);
+				bigkeys->reservoir[sample].bytes = redisUsage->integer;
+
+			}
+
+			// Add the key to the top-K heap
+			redis_bigkeys_heap_add(bigkeys, topk, redisKeys->element[element]->str, redisType->str, redisUsage->integer);
+
+			// Increment the totals
+			bigkeys->keys  += 1;
+			bigkeys->bytes += redisUsage->integer;
+
+		}
+
+		// Free the replies
+		redis_reply_free(redisType);
+		redis_reply_free(redisUsage);
+
+	}
+
+	// Move the cursor
+	zbx_strlcpy(bigkeys->cursor,redisR->element[0]->str,sizeof(bigkeys->cursor));
+	bigkeys->steps++;
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// If the scan cycle is complete
+	if (strcmp(bigkeys->cursor,"0") == 0) {redis_bigkeys_publish(bigkeys);}
+
+	return 0;
+
+step_invalid:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will form the JSON of the last complete cycle   *
+ *              (or of the cycle in progress if none has completed yet)       *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_bigkeys_json(redis_bigkeys_t *bigkeys, int topk, struct zbx_json *j)
+{
+
+	// Declare Variables
+	char            value[MAX_LENGTH_STRING];
+	int             count, complete = (bigkeys->cycles > 0);
+	redis_bigkey_t *top;
+	int             top_count;
+
+	// Use the cycle in progress until one has completed
+	top       = complete ? bigkeys->top : bigkeys->heap;
+	top_count = complete ? bigkeys->top_count : bigkeys->heap_count;
+
+	// Add the totals
+	zbx_json_addstring(j, "complete", complete ? "1" : "0", ZBX_JSON_TYPE_INT);
+	zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",bigkeys->cycles);
+	zbx_json_addstring(j, "cycles", value, ZBX_JSON_TYPE_INT);
+	zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",complete ? bigkeys->published_keys : bigkeys->keys);
+	zbx_json_addstring(j, "keys", value, ZBX_JSON_TYPE_INT);
+	zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",complete ? bigkeys->published_bytes : bigkeys->bytes);
+	zbx_json_addstring(j, "bytes", value, ZBX_JSON_TYPE_INT);
+	zbx_snprintf(value,MAX_LENGTH_STRING,"%lld",(long long)(complete ? bigkeys->published_duration : time(NULL) - bigkeys->started));
+	zbx_json_addstring(j, "duration", value, ZBX_JSON_TYPE_INT);
+
+	// Add the big keys
+	zbx_json_addarray(j, "bigkeys");
+
+	for (count = 0; count < top_count && count < topk; count++) {
+
+		zbx_json_addobject(j, NULL);
+		zbx_json_addstring(j, "key", top[count].key, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(j, "type", top[count].type, ZBX_JSON_TYPE_STRING);
+		zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",top[count].bytes);
+		zbx_json_addstring(j, "bytes", value, ZBX_JSON_TYPE_INT);
+		zbx_json_close(j);
+
+	}
+
+	zbx_json_close(j);
+
+	// Add the prefix estimates
+	zbx_json_addarray(j, "prefixes");
+
+	for (count = 0; complete && count < bigkeys->prefix_count && count < topk; count++) {
+
+		zbx_json_addobject(j, NULL);
+		zbx_json_addstring(j, "prefix", bigkeys->prefixes[count].prefix, ZBX_JSON_TYPE_STRING);
+		zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",bigkeys->prefixes[count].keys);
+		zbx_json_addstring(j, "keys", value, ZBX_JSON_TYPE_INT);
+		zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",bigkeys->prefixes[count].bytes);
+		zbx_json_addstring(j, "bytes", value, ZBX_JSON_TYPE_INT);
+		zbx_json_close(j);
+
+	}
+
+	zbx_json_close(j);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free all big key sampler states            *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_bigkeys_free()
+{
+
+	// If the states are shared
+	if (redis_bigkeys != NULL && redis_bigkeys != &redis_bigkeys_local) {munmap(redis_bigkeys, sizeof(redis_bigkeys_table_t));}
+
+	redis_bigkeys = &redis_bigkeys_local;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will allocate the SCAN cursors in memory shared *
+ *              with the forked agent processes                               *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_scan_cursors_start()
+{
+
+	// Allocate the cursors in memory shared with the forked agent processes
+	redis_scan_cursors = mmap(NULL, sizeof(redis_scan_cursors_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	// If the allocation failed then every process scans on its own
+	if (redis_scan_cursors == MAP_FAILED) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): SCAN cursors could not be shared (%s)",MODULE,strerror(errno));
+
+		redis_scan_cursors = &redis_scan_cursors_local;
+
+		return 1;
+
+	}
+
+	memset(redis_scan_cursors, 0, sizeof(redis_scan_cursors_t));
+
+	// If the lock could not be shared then every process scans on its own
+	if (redis_shared_lock_init(&redis_scan_cursors->lock)) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): SCAN cursors could not be shared (Lock not supported)",MODULE);
+
+		munmap(redis_scan_cursors, sizeof(redis_scan_cursors_t));
+		redis_scan_cursors = &redis_scan_cursors_local;
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get a copy of the SCAN cursor of a sampler *
+ *              target, the copy lasts until the handler returns (the oldest  *
+ *              cursor is reused when full)                                   *
+ * Returns    : Cursor                                                        *
+ *                                                                            *
+ ******************************************************************************/
+redis_scan_cursor_t * redis_scan_cursor_get(char *redis_server, char *redis_port, char *database, char *pattern)
+{
+
+	// Declare Variables
+	char                *redis_target;
+	int                  count;
+	redis_scan_cursor_t *scan, *copy;
+
+	// Form the target
+	redis_target = redis_arena_printf("%s:%s/%s|%s",redis_server,redis_port,database,pattern);
+
+	// Take the copy from the request arena (the scan runs without holding the lock)
+	copy = redis_arena_alloc(sizeof(redis_scan_cursor_t));
+
+	redis_shared_lock(&redis_scan_cursors->lock, sizeof(redis_scan_cursors_t), 1);
+
+	// Find the cursor of the target
+	for (count = 0; count < MAX_SCAN_CURSORS && strcmp(redis_scan_cursors->targets[count].target,redis_target) != 0; count++) {}
+
+	// If the target has no cursor then start a new one
+	if (count == MAX_SCAN_CURSORS) {
+
+		scan = &redis_scan_cursors->targets[redis_scan_cursors->next];
+		redis_scan_cursors->next = (redis_scan_cursors->next + 1) % MAX_SCAN_CURSORS;
+
+		zbx_strlcpy(scan->target,redis_target,MAX_LENGTH_KEY);
+		zbx_strlcpy(scan->cursor,"0",sizeof(scan->cursor));
+		scan->steps = 0;
+
+	} else {scan = &redis_scan_cursors->targets[count];}
+
+	memcpy(copy, scan, sizeof(redis_scan_cursor_t));
+
+	redis_shared_lock(&redis_scan_cursors->lock, sizeof(redis_scan_cursors_t), 0);
+
+	return copy;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will store the copy of a SCAN cursor once the   *
+ *              keys have been sampled (a copy that another process has       *
+ *              already moved on from is dropped)                             *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_scan_cursor_put(redis_scan_cursor_t *scan)
+{
+
+	// Declare Variables
+	int count;
+
+	redis_shared_lock(&redis_scan_cursors->lock, sizeof(redis_scan_cursors_t), 1);
+
+	// Find the cursor of the target
+	for (count = 0; count < MAX_SCAN_CURSORS && strcmp(redis_scan_cursors->targets[count].target,scan->target) != 0; count++) {}
+
+	// If the cursor is the one the copy was taken from
+	if (count < MAX_SCAN_CURSORS && redis_scan_cursors->targets[count].steps == scan->steps) {
+
+		zbx_strlcpy(redis_scan_cursors->targets[count].cursor,scan->cursor,sizeof(redis_scan_cursors->targets[count].cursor));
+		redis_scan_cursors->targets[count].steps++;
+
+	}
+
+	redis_shared_lock(&redis_scan_cursors->lock, sizeof(redis_scan_cursors_t), 0);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the SCAN cursors                      *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_scan_cursors_free()
+{
+
+	// If the cursors are shared
+	if (redis_scan_cursors != NULL && redis_scan_cursors != &redis_scan_cursors_local) {munmap(redis_scan_cursors, sizeof(redis_scan_cursors_t));}
+
+	redis_scan_cursors = &redis_scan_cursors_local;
+
+}
+
+/**********************************************************************************
+ *                                                                                *
+ * Function   : This function will sample keys and bucket their TTL, keys are     *
+ *              sampled with pipelined RANDOMKEY (no cursor) or by continuing an  *
+ *              incremental SCAN MATCH, then PTTL is pipelined for every key      *
+ * Returns    : 0 (success), 1 (failure)                                          *
+ *                                                                                *
+ **********************************************************************************/
+int redis_ttl_sample(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, char *cursor, char *pattern, int samples, unsigned long long *buckets)
+{
+
+	// Declare Variables
+	char               *zbx_msg = "";
+	redisReply        **redisReplies, **redisKeys, *redisR;
+	int                 replies = 0, keys = 0, count, ret = 0;
+	size_t              element;
+
+	// Allocate the replies and keys (a SCAN reply holds a batch of keys)
+	redisReplies = zbx_malloc(NULL, sizeof(redisReply *) * MAX(samples, MAX_TTL_SCAN_ROUNDS));
+	redisKeys    = zbx_malloc(NULL, sizeof(redisReply *) * samples);
+
+	// If the keys are sampled at random
+	if (cursor == NULL) {
+
+		// Pipeline the random keys
+		for (count = 0; count < samples; count++) {redis_command_append(redisC,"RANDOMKEY");}
+
+		// Read every random key
+		for (count = 0; count < samples; count++) {
+
+			// If the connection is lost
+			if (redisGetReply(redisC,(void **)&redisR) != REDIS_OK) {goto sample_lost;}
+
+			// Keep the reply
+			redisReplies[replies++] = redisR;
+
+			// If the database is empty
+			if (redisR->type != REDIS_REPLY_STRING) {continue;}
+
+			redisKeys[keys++] = redisR;
+
+		}
+
+	}
+
+	// If the keys are sampled by continuing the scan
+	while (cursor != NULL && keys < samples && replies < MAX_TTL_SCAN_ROUNDS) {
+
+		// Scan the next batch of keys
+		if ((redisR = redis_command_send(redisC,"SCAN %s MATCH %s COUNT %d",cursor,pattern,samples)) == NULL) {goto sample_lost;}
+
+		// Keep the reply
+		redisReplies[replies++] = redisR;
+
+		// If the reply is not a cursor and batch of keys
+		if (redisR->type != REDIS_REPLY_ARRAY || redisR->elements != 2 || redisR->element[1]->type != REDIS_REPLY_ARRAY) {
+
+			// Form message
+			if (redisR->type == REDIS_REPLY_ERROR) {zbx_msg = redis_arena_printf("Redis command error (%s)",redisR->str);}
+			if (redisR->type != REDIS_REPLY_ERROR) {zbx_msg = redis_arena_printf("Redis command (SCAN) returned an unexpected reply");}
+
+			goto sample_invalid;
+
+		}
+
+		// Add the keys of the batch
+		for (element = 0; element < redisR->element[1]->elements && keys < samples; element++) {redisKeys[keys++] = redisR->element[1]->element[element];}
+
+		// Move the cursor
+		zbx_strlcpy(cursor,redisR->element[0]->str,MAX_LENGTH_CURSOR);
+
+		// If the scan has wrapped around
+		if (strcmp(cursor,"0") == 0) {break;}
+
+	}
+
+	// Pipeline the TTL of every key
+	for (count = 0; count < keys; count++) {redis_command_append(redisC,"PTTL %b",redisKeys[count]->str,(size_t)redisKeys[count]->len);}
+
+	// Bucket every TTL
+	for (count = 0; count < keys; count++) {
+
+		// If the connection is lost
+		if (redisGetReply(redisC,(void **)&redisR) != REDIS_OK) {goto sample_lost;}
+
+		// Bucket the TTL (-1 no expiry, -2 the key has gone since it was sampled)
+		if (redisR->type == REDIS_REPLY_INTEGER) {
+
+			if (redisR->integer == -1)            {buckets[TTL_BUCKET_NO_EXPIRE]++;}
+			else if (redisR->integer < 0)         {buckets[TTL_BUCKET_MISSING]++;}
+			else if (redisR->integer < 60000)     {buckets[TTL_BUCKET_LT_1M]++;}
+			else if (redisR->integer < 3600000)   {buckets[TTL_BUCKET_LT_1H]++;}
+			else if (redisR->integer < 86400000)  {buckets[TTL_BUCKET_LT_1D]++;}
+			else                                  {buckets[TTL_BUCKET_GT_1D]++;}
+
+		}
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+	}
+
+	goto sample_out;
+
+sample_lost:
+
+	// Form message
+	zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+sample_invalid:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+	ret = 1;
+
+sample_out:
+
+	// Free the replies
+	for (count = 0; count < replies; count++) {redis_reply_free(redisReplies[count]);}
+
+	zbx_free(redisReplies);
+	zbx_free(redisKeys);
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : Sort comparator of clients by addr                            *
+ * Returns    : <0, 0, >0                                                     *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_clients_compare(const void *a, const void *b)
+{
+
+	// Declare Variables
+	const redis_client_t *client_a = a, *client_b = b;
+
+	return strcmp(client_a->addr,client_b->addr);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will release the clients of a client table      *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_clients_clear(redis_clients_t *clients)
+{
+
+	zbx_free(clients->text);
+	zbx_free(clients->clients);
+	clients->client_count = 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will parse a line of CLIENT LIST into a client  *
+ *              (the fields are split in place)                               *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_client_parse(redis_client_t *client, char *line, char *line_end)
+{
+
+	// Declare Variables
+	char   *field, *field_end, *value;
+	size_t  length;
+
+	// Initialise the client
+	memset(client, 0, sizeof(redis_client_t));
+	client->fields = line;
+	client->addr = client->name = client->flags = client->cmd = "";
+
+	// Process every field (field=value separated by spaces)
+	for (field = line; field <= line_end; field = field_end + 1) {
+
+		// Terminate the field
+		field_end = redis_scan(field, line_end, SCAN_SPACE);
+		*field_end = '\0';
+
+		client->field_count++;
+
+		// If the field has no value
+		if ((value = redis_scan(field, field_end, SCAN_EQUALS)) == field_end) {continue;}
+		length = value++ - field;
+
+		// Index the fields used for lookups and aggregates (the length of the name is compared first)
+		if (length == 4 && memcmp(field,"addr",4) == 0)    {client->addr = value;}
+		if (length == 4 && memcmp(field,"name",4) == 0)    {client->name = value;}
+		if (length == 5 && memcmp(field,"flags",5) == 0)   {client->flags = value;}
+		if (length == 3 && memcmp(field,"cmd",3) == 0)     {client->cmd = value;}
+		if (length == 3 && memcmp(field,"age",3) == 0)     {client->age = strtoull(value,NULL,10);}
+		if (length == 4 && memcmp(field,"idle",4) == 0)    {client->idle = strtoull(value,NULL,10);}
+		if (length == 4 && memcmp(field,"omem",4) == 0)    {client->omem = strtoull(value,NULL,10);}
+		if (length == 4 && memcmp(field,"qbuf",4) == 0)    {client->qbuf = strtoull(value,NULL,10);}
+		if (length == 7 && memcmp(field,"tot-mem",7) == 0) {client->totmem = strtoull(value,NULL,10);}
+		if (length == 3 && memcmp(field,"sub",3) == 0)     {client->subscriptions += atoi(value);}
+		if (length == 4 && memcmp(field,"psub",4) == 0)    {client->subscriptions += atoi(value);}
+		if (length == 4 && memcmp(field,"ssub",4) == 0)    {client->subscriptions += atoi(value);}
+
+	}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will parse CLIENT LIST into a client table      *
+ *              sorted by addr (the fields are split in place)                *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_clients_parse(redis_clients_t *clients, char *text)
+{
+
+	// Declare Variables
+	char           *cursor, *end, *line, *line_end;
+	int             lines = 0;
+
+	// Take a copy of the text
+	clients->text = zbx_strdup(NULL, text);
+	end = clients->text + strlen(clients->text);
+
+	// Count the lines to size the table
+	for (line = clients->text; (line = redis_scan(line, end, SCAN_NEWLINE)) < end; line++) {lines++;}
+
+	clients->clients      = zbx_malloc(NULL, sizeof(redis_client_t) * (lines + 1));
+	clients->client_count = 0;
+
+	// Process every line
+	for (cursor = clients->text; (line = redis_scan_line(&cursor, end, &line_end)) != NULL; ) {
+
+		// Parse the client
+		redis_client_parse(&clients->clients[clients->client_count], line, line_end);
+
+		clients->client_count++;
+
+	}
+
+	// Sort the clients by addr
+	qsort(clients->clients, clients->client_count, sizeof(redis_client_t), redis_clients_compare);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the client table of a server from the  *
+ *              cache, or on a miss fetch and parse CLIENT LIST               *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_clients_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, redis_clients_t **clientsptr)
+{
+
+	// Declare Variables
+	char             redis_target[MAX_LENGTH_STRING];
+	int              count;
+	redis_clients_t *clients = NULL;
+	redisContext    *redisC;
+	redisReply      *redisR;
+
+	// Form the target
+	zbx_snprintf(redis_target,MAX_LENGTH_STRING,"%s:%s",redis_server,redis_port);
+
+	// Find the client table of the target
+	for (count = 0; count < MAX_CLIENT_TABLES; count++) {
+
+		if (strcmp(redis_clients[count].target,redis_target) == 0) {clients = &redis_clients[count]; break;}
+
+	}
+
+	// If the client table is current
+	if (clients != NULL && clients->text != NULL && clients->expires > time(NULL)) {REDIS_STATS_ADD(cache_hits, 1); *clientsptr = clients; return 0;}
+
+	REDIS_STATS_ADD(cache_misses, 1);
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password)) == NULL) {return 1;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "CLIENT LIST", NULL, REDIS_REPLY_STRING)) {redisFree(redisC); return 1;}
+
+	// Free the context
+	redisFree(redisC);
+
+	// If the target has no table then take the next one
+	if (clients == NULL) {
+
+		clients = &redis_clients[redis_clients_next];
+		redis_clients_next = (redis_clients_next + 1) % MAX_CLIENT_TABLES;
+
+		zbx_strlcpy(clients->target,redis_target,MAX_LENGTH_STRING);
+
+	}
+
+	// Parse the clients
+	redis_clients_clear(clients);
+	redis_clients_parse(clients, redisR->str);
+	clients->expires = time(NULL) + cache_ttl;
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// Assign the client table
+	*clientsptr = clients;
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will read what is available from a redis        *
+ *              connection, waiting for it up to the deadline of the reply    *
+ *              (redis_stats_clock microseconds)                              *
+ * Returns    : Bytes read (success), -1 (failure)                            *
+ *                                                                            *
+ ******************************************************************************/
+static ssize_t redis_clients_read(redisContext *redisC, char *buffer, size_t length, unsigned long long deadline, char **zbx_msg)
+{
+
+	// Declare Variables
+	struct pollfd       redisPoll;
+	ssize_t             bytes = 0;
+	int                 ready = 0;
+	unsigned long long  now;
+
+	while (bytes == 0) {
+
+		// Wait for the socket to become readable, for no longer than what is left of the timeout
+		redisPoll.fd = redisC->fd;
+		redisPoll.events = POLLIN;
+		redisPoll.revents = 0;
+
+		// If the poll failed
+		if ((now = redis_stats_clock()) < deadline && (ready = poll(&redisPoll,1,(int)((deadline - now + 999) / 1000))) < 0) {
+
+			if (errno == EINTR) {continue;}
+
+			// Form message
+			*zbx_msg = redis_arena_printf("Redis connection lost (%s)",strerror(errno));
+
+			return -1;
+
+		}
+
+		// If the reply did not arrive in time
+		if (now >= deadline || ready == 0) {
+
+			// Form message
+			*zbx_msg = redis_arena_printf("Redis connection lost (Timed out)");
+
+			return -1;
+
+		}
+
+#ifdef HAVE_REDIS_CONTEXT_FUNCS
+
+		// Read through the context so that the bytes and socket time are counted
+		if ((bytes = redisC->funcs->read(redisC, buffer, length)) < 0) {
+
+			// Form message
+			*zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+			return -1;
+
+		}
+
+#else
+
+		// Read from the socket
+		if ((bytes = recv(redisC->fd, buffer, length, 0)) <= 0) {
+
+			if (bytes < 0 && (errno == EINTR || errno == EAGAIN)) {bytes = 0; continue;}
+
+			// Form message
+			*zbx_msg = redis_arena_printf("Redis connection lost (%s)",(bytes == 0) ? "Server closed the connection" : strerror(errno));
+
+			return -1;
+
+		}
+
+#endif
+
+	}
+
+	return bytes;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will run CLIENT LIST and sum every client into  *
+ *              the aggregates as the reply is read off the socket, holding   *
+ *              no more than a chunk and a line of it whatever the number of  *
+ *              clients                                                       *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_clients_stream(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, char *redis_timeout, redis_client_summary_t *summary)
+{
+
+	// Declare Variables
+	char            buffer[CLIENT_STREAM_CHUNK];
+	char            header[MAX_LENGTH_STRING];
+	char           *zbx_msg = "";
+	char           *data, *end, *payload_end, *newline, *line = NULL;
+	size_t          header_length = 0, line_length = 0, line_size = 0, length;
+	long long       remaining = -1;
+	size_t          prefix = 0, trailer = 2;
+	ssize_t         bytes;
+	int             done = 0, ret = 1;
+	unsigned long long deadline;
+	redis_client_t  client;
+
+	// Send the command
+	if (redis_command_append(redisC,"CLIENT LIST") != REDIS_OK) {goto error_connection_lost;}
+
+	do {if (redisBufferWrite(redisC,&done) == REDIS_ERR) {goto error_connection_lost;}} while (! done);
+
+	// The whole reply must arrive within the timeout, however slowly it is sent
+	deadline = redis_stats_clock() + (unsigned long long)atoll(redis_timeout) * 1000000;
+
+	// Read the reply until its payload and trailing CRLF have been taken
+	while (remaining != 0 || trailer > 0) {
+
+		// Take what the reader had already buffered first, then read the socket
+		if (redisC->reader->len > redisC->reader->pos) {
+
+			length = redisC->reader->len - redisC->reader->pos;
+			length = (length > sizeof(buffer)) ? sizeof(buffer) : length;
+
+			memcpy(buffer, redisC->reader->buf + redisC->reader->pos, length);
+			redisC->reader->pos += length;
+
+			bytes = length;
+
+		}
+		else if ((bytes = redis_clients_read(redisC, buffer, sizeof(buffer), deadline, &zbx_msg)) < 0) {goto error;}
+
+		data = buffer;
+		end = buffer + bytes;
+
+		// Read the header ($length or =length for a RESP3 verbatim string)
+		if (remaining < 0) {
+
+			while (data < end && (header_length == 0 || header[header_length - 1] != '\n')) {
+
+				if (header_length >= sizeof(header) - 1) {goto error_protocol;}
+
+				header[header_length++] = *data++;
+
+			}
+
+			// If the header is incomplete
+			if (header[header_length - 1] != '\n') {continue;}
+
+			// Terminate the header
+			header[header_length] = '\0';
+			header[strcspn(header,"\r\n")] = '\0';
+
+			// If the reply type is an error
+			if (header[0] == '-' || header[0] == '!') {
+
+				// Form message
+				zbx_msg = redis_arena_printf("Redis command error (%s)",header + 1);
+
+				goto error;
+
+			}
+
+			// If the reply is not a string
+			if ((header[0] != '$' && header[0] != '=') || (remaining = strtoll(header + 1,NULL,10)) < 0) {goto error_protocol;}
+
+			// Verbatim strings start with their format (txt:)
+			prefix = (header[0] == '=') ? 4 : 0;
+
+		}
+
+		// Take the payload
+		length = ((long long)(end - data) < remaining) ? (size_t)(end - data) : (size_t)remaining;
+		payload_end = data + length;
+		remaining -= length;
+
+		// Skip the format of a verbatim string
+		while (prefix > 0 && data < payload_end) {prefix--; data++;}
+
+		// Process every line of the payload
+		while (data < payload_end) {
+
+			// Find the end of the line
+			newline = redis_scan(data, payload_end, SCAN_NEWLINE);
+			length = newline - data;
+			newline = (newline < payload_end) ? newline : NULL;
+
+			// If the whole line is in the chunk then parse it in place
+			if (newline != NULL && line_length == 0) {
+
+				if (length > 0 && data[length - 1] == '\r') {length--;}
+				data[length] = '\0';
+
+				if (length > 0) {redis_client_parse(&client, data, data + length); redis_clients_summarise(summary, &client);}
+
+				data = newline + 1;
+
+				continue;
+
+			}
+
+			// If the line is too long to be held
+			if (line_length + length >= MAX_CLIENT_STREAM_LINE) {goto error_protocol;}
+
+			// Carry the part of the line over to the next chunk
+			if (line_length + length >= line_size) {
+
+				line_size = (line_length + length) * 2 + 1;
+				line = zbx_realloc(line, line_size);
+
+			}
+
+			memcpy(line + line_length, data, length);
+			line_length += length;
+
+			data += length;
+
+			// If the line is complete
+			if (newline != NULL) {
+
+				if (line[line_length - 1] == '\r') {line_length--;}
+				line[line_length] = '\0';
+
+				if (line_length > 0) {redis_client_parse(&client, line, line + line_length); redis_clients_summarise(summary, &client);}
+
+				line_length = 0;
+				data++;
+
+			}
+
+		}
+
+		// Take the trailing CRLF
+		length = (size_t)(end - data);
+		trailer -= (length < trailer) ? length : trailer;
+
+	}
+
+	// Process the last line when it was not terminated
+	if (line_length > 0) {
+
+		if (line[line_length - 1] == '\r') {line_length--;}
+		line[line_length] = '\0';
+
+		if (line_length > 0) {redis_client_parse(&client, line, line + line_length); redis_clients_summarise(summary, &client);}
+
+	}
+
+	REDIS_STATS_ADD(replies, 1);
+
+	ret = 0;
+
+	goto out;
+
+error_connection_lost:
+
+	// Form message
+	zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+	goto error;
+
+error_protocol:
+
+	// Form message
+	zbx_msg = redis_arena_printf("Redis reply of CLIENT LIST is not valid");
+
+error:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+
+	// Set message
+	SET_MSG_RESULT(result,strdup(zbx_msg));
+
+out:
+
+	// Free the line
+	zbx_free(line);
+
+	return ret;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the aggregates of a group, adding     *
+ *              them when they are not found (groups beyond the table are     *
+ *              only counted in all)                                          *
+ * Returns    : Group (success), NULL (failure)                               *
+ *                                                                            *
+ ******************************************************************************/
+static redis_client_group_t * redis_clients_group(redis_client_groups_t *groups, const char *group, size_t length, int add)
+{
+
+	// Declare Variables
+	unsigned int          hash;
+	size_t                count;
+	redis_client_group_t *slot;
+
+	// If the group can not be held
+	if (length >= MAX_CLIENT_GROUP) {groups->overflow |= add; return NULL;}
+
+	// Hash the group
+	hash = redis_hash(group, length);
+
+	// Probe from the hashed slot
+	for (count = 0; count < MAX_CLIENT_GROUPS; count++) {
+
+		slot = &groups->groups[(hash + count) % MAX_CLIENT_GROUPS];
+
+		// If the slot is free then the group has not been seen
+		if (! slot->used) {
+
+			if (! add) {return NULL;}
+
+			memcpy(slot->group,group,length);
+			slot->group[length] = '\0';
+			slot->used = 1;
+
+			return slot;
+
+		}
+
+		// If the slot holds the group
+		if (strncmp(slot->group,group,length) == 0 && slot->group[length] == '\0') {return slot;}
+
+	}
+
+	groups->overflow |= add;
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will add a client to the aggregates of a group  *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_clients_group_add(redis_client_group_t *group, redis_client_t *client)
+{
+
+	// If the group is not held
+	if (group == NULL) {return;}
+
+	group->count   += 1;
+	group->omem    += client->omem;
+	group->qbuf    += client->qbuf;
+	group->totmem  += client->totmem;
+	group->idle_max = MAX(group->idle_max, client->idle);
+	group->blocked += (strchr(client->flags,'b') != NULL);
+	group->pubsub  += (client->subscriptions > 0 || strchr(client->flags,'P') != NULL);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will sum a client into the aggregates of all    *
+ *              clients, its name, its cmd and every flag it has              *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_clients_summarise(redis_client_summary_t *summary, redis_client_t *client)
+{
+
+	// Declare Variables
+	char *flag;
+
+	// Clients of this module are not counted
+	if (strcmp(client->name,MODULE) == 0) {return;}
+
+	redis_clients_group_add(&summary->all, client);
+	redis_clients_group_add(redis_clients_group(&summary->names, client->name, strlen(client->name), 1), client);
+	redis_clients_group_add(redis_clients_group(&summary->cmds, client->cmd, strlen(client->cmd), 1), client);
+
+	for (flag = client->flags; *flag != '\0'; flag++) {redis_clients_group_add(redis_clients_group(&summary->flags, flag, 1, 1), client);}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the client aggregates of a server from *
+ *              the cache, or on a miss stream CLIENT LIST into them          *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_clients_summary_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, redis_client_summary_t **summaryptr)
+{
+
+	// Declare Variables
+	char                    redis_target[MAX_LENGTH_STRING];
+	int                     count;
+	redis_client_summary_t *summary = NULL;
+	redisContext           *redisC;
+
+	// Form the target
+	zbx_snprintf(redis_target,MAX_LENGTH_STRING,"%s:%s",redis_server,redis_port);
+
+	// Find the aggregates of the target
+	for (count = 0; count < MAX_CLIENT_TABLES; count++) {
+
+		if (strcmp(redis_client_summaries[count].target,redis_target) == 0) {summary = &redis_client_summaries[count]; break;}
+
+	}
+
+	// If the aggregates are current
+	if (summary != NULL && summary->expires > time(NULL)) {REDIS_STATS_ADD(cache_hits, 1); *summaryptr = summary; return 0;}
+
+	REDIS_STATS_ADD(cache_misses, 1);
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password)) == NULL) {return 1;}
+
+	// If the target has no aggregates then take the next ones
+	if (summary == NULL) {
+
+		summary = &redis_client_summaries[redis_client_summaries_next];
+		redis_client_summaries_next = (redis_client_summaries_next + 1) % MAX_CLIENT_TABLES;
+
+	}
+
+	// Clear the aggregates (they are only current once the stream has completed)
+	memset(summary, 0, sizeof(redis_client_summary_t));
+	zbx_strlcpy(summary->target,redis_target,MAX_LENGTH_STRING);
+
+	// Stream the clients into the aggregates
+	if (redis_clients_stream(result, zbx_key, redisC, redis_timeout, summary)) {redisFree(redisC); return 1;}
+
+	// Free the context
+	redisFree(redisC);
+
+	summary->expires = time(NULL) + cache_ttl;
+
+	// Assign the aggregates
+	*summaryptr = summary;
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the aggregates of a group of clients   *
+ *              (a group without clients has aggregates of zero)              *
+ * Returns    : Group (success), NULL (the group was not held)                *
+ *                                                                            *
+ ******************************************************************************/
+redis_client_group_t * redis_clients_summary_group(redis_client_summary_t *summary, char *groupby, char *group)
+{
+
+	// Declare Variables
+	static redis_client_group_t  empty;
+	redis_client_groups_t       *groups = NULL;
+	redis_client_group_t        *found;
+
+	// Find the groups
+	if (strcmp(groupby,"all") == 0)  {return &summary->all;}
+	if (strcmp(groupby,"name") == 0) {groups = &summary->names;}
+	if (strcmp(groupby,"cmd") == 0)  {groups = &summary->cmds;}
+	if (strcmp(groupby,"flag") == 0) {groups = &summary->flags;}
+
+	// If the groupby is not known
+	if (groups == NULL) {return &empty;}
+
+	// If the group has clients
+	if ((found = redis_clients_group(groups, group, strlen(group), 0)) != NULL) {return found;}
+
+	// Without every group held a missing group may still have clients
+	return groups->overflow ? NULL : &empty;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find a client by addr                      *
+ * Returns    : Client (success), NULL (failure)                              *
+ *                                                                            *
+ ******************************************************************************/
+redis_client_t * redis_clients_find(redis_clients_t *clients, char *addr)
+{
+
+	// Declare Variables
+	redis_client_t client;
+
+	// Set the search
+	client.addr = addr;
+
+	return bsearch(&client, clients->clients, clients->client_count, sizeof(redis_client_t), redis_clients_compare);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the value of a client field            *
+ * Returns    : Value (success), NULL (failure)                               *
+ *                                                                            *
+ ******************************************************************************/
+char * redis_client_field(redis_client_t *client, char *field)
+{
+
+	// Declare Variables
+	char   *fields = client->fields;
+	size_t  length = strlen(field);
+	int     count;
+
+	// Search every field
+	for (count = 0; count < client->field_count; count++) {
+
+		// If the field matches
+		if (strncmp(fields,field,length) == 0 && fields[length] == '=') {return fields + length + 1;}
+
+		// Move to the next field
+		fields += strlen(fields) + 1;
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free all client tables                     *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_clients_free()
+{
+
+	// Declare Variables
+	int count;
+
+	// Free every client table
+	for (count = 0; count < MAX_CLIENT_TABLES; count++) {redis_clients_clear(&redis_clients[count]);}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will estimate the rate of an offset from its    *
+ *              previous sample and sample it again (rates restart when an    *
+ *              offset goes backwards)                                        *
+ * Returns    : 1 (rated), 0 (not rated)                                      *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_replication_sample(redis_replica_sample_t *sample, unsigned long long offset, time_t now, double *rate)
+{
+
+	// Declare Variables
+	int rated = 0;
+
+	*rate = 0;
+
+	// If there is an earlier sample to estimate from
+	if (sample->sampled > 0 && now > sample->sampled && offset >= sample->offset) {
+
+		*rate = (double)(offset - sample->offset) / (now - sample->sampled);
+		rated = 1;
+
+	}
+
+	// Sample the offset
+	sample->offset  = offset;
+	sample->sampled = now;
+
+	return rated;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will parse INFO REPLICATION into a replication  *
+ *              state, estimating the rates of every offset from its sample   *
+ *              (a slave is only rated once it has been sampled twice)        *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_replication_parse(redis_replication_t *replication, char *text, time_t now)
+{
+
+	// Declare Variables
+	char                   *info, *cursor, *end, *line, *line_end;
+	char                   *redis_field, *redis_data, *redis_value;
+	char                   *redis_slave_ip, *redis_slave_port;
+	redis_replica_t        *slave;
+	redis_replica_sample_t *sample;
+	int                     count;
+
+	replication->slave_count   = 0;
+	replication->master_offset = 0;
+
+	// Take a copy of the text in the request arena (the lines are split in place)
+	info = redis_arena_strdup(text);
+	cursor = info;
+	end = info + strlen(info);
+
+	// Process every line of output
+	for (line = redis_scan_line(&cursor, end, &line_end); line != NULL; line = redis_scan_line(&cursor, end, &line_end)) {
+
+		// If the line is the master offset
+		if (strncmp(line,"master_repl_offset:",19) == 0) {replication->master_offset = strtoull(line + 19,NULL,10); continue;}
+
+		// If the line is not a slave or there is no room for it
+		if (replication->slave_count == MAX_REPLICATION_SLAVES || redis_info_split(line, line_end, "slave", &redis_field, &redis_data) != 0) {continue;}
+
+		// Take room for the values from the request arena
+		redis_value      = redis_arena_string(strlen(redis_data));
+		redis_slave_ip   = redis_arena_string(strlen(redis_data));
+		redis_slave_port = redis_arena_string(strlen(redis_data));
+
+		// Get the values
+		if (redis_get_value(redis_field, redis_data, "ip", redis_slave_ip) || redis_get_value(redis_field, redis_data, "port", redis_slave_port)) {continue;}
+		if (redis_get_value(redis_field, redis_data, "offset", redis_value)) {continue;}
+
+		// Add the slave
+		slave = &replication->slaves[replication->slave_count++];
+		zbx_snprintf(slave->addr,MAX_LENGTH_STRING,"%s:%s",redis_slave_ip,redis_slave_port);
+		slave->offset = strtoull(redis_value,NULL,10);
+
+		// Find the sample of the slave, or take an unused one or else the oldest
+		for (count = 0, sample = &replication->samples[0]; count < MAX_REPLICATION_SLAVES; count++) {
+
+			if (strcmp(replication->samples[count].addr,slave->addr) == 0) {sample = &replication->samples[count]; break;}
+
+			if (replication->samples[count].sampled < sample->sampled) {sample = &replication->samples[count];}
+
+		}
+
+		// If the sample is of another slave then start again
+		if (strcmp(sample->addr,slave->addr) != 0) {
+
+			zbx_strlcpy(sample->addr,slave->addr,MAX_LENGTH_STRING);
+			sample->sampled = 0;
+
+		}
+
+		// Estimate the rate of the slave from its sample
+		slave->rated = redis_replication_sample(sample, slave->offset, now, &slave->rate);
+
+	}
+
+	// Estimate the rate of the master from its sample
+	replication->rated = redis_replication_sample(&replication->master_sample, replication->master_offset, now, &replication->master_rate);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will allocate the replication states in memory  *
+ *              shared with the forked agent processes                        *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_replications_start()
+{
+
+	// Allocate the states in memory shared with the forked agent processes
+	redis_replications = mmap(NULL, sizeof(redis_replications_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	// If the allocation failed then every process samples the offsets on its own
+	if (redis_replications == MAP_FAILED) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Replication states could not be shared (%s)",MODULE,strerror(errno));
+
+		redis_replications = &redis_replications_local;
+
+		return 1;
+
+	}
+
+	memset(redis_replications, 0, sizeof(redis_replications_t));
+
+	// If the lock could not be shared then every process samples the offsets on its own
+	if (redis_shared_lock_init(&redis_replications->lock)) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Replication states could not be shared (Lock not supported)",MODULE);
+
+		munmap(redis_replications, sizeof(redis_replications_t));
+		redis_replications = &redis_replications_local;
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the replication state of a target,    *
+ *              or else the least recently used state to replace (the lock    *
+ *              must be held)                                                 *
+ * Returns    : State (found), NULL (not found)                               *
+ *                                                                            *
+ ******************************************************************************/
+static redis_replication_t * redis_replication_find(char *redis_target, redis_replication_t **oldestptr)
+{
+
+	// Declare Variables
+	int count;
+
+	*oldestptr = &redis_replications->targets[0];
+
+	for (count = 0; count < MAX_REPLICATION_TARGETS; count++) {
+
+		if (strcmp(redis_replications->targets[count].target,redis_target) == 0) {return &redis_replications->targets[count];}
+
+		if (redis_replications->targets[count].used < (*oldestptr)->used) {*oldestptr = &redis_replications->targets[count];}
+
+	}
+
+	return NULL;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the replication state of a server,     *
+ *              fetching and parsing INFO REPLICATION once per interval (the  *
+ *              state is a copy that lasts until the handler returns, the     *
+ *              server is asked without holding the lock)                     *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_replication_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, redis_replication_t **replicationptr)
+{
+
+	// Declare Variables
+	char                 redis_target[MAX_LENGTH_STRING];
+	time_t               now = time(NULL);
+	redis_replication_t *replication, *oldest, *copy;
+	redisContext        *redisC;
+	redisReply          *redisR;
+
+	// Form the target
+	zbx_snprintf(redis_target,MAX_LENGTH_STRING,"%s:%s",redis_server,redis_port);
+
+	// Take the copy from the request arena
+	copy = redis_arena_alloc(sizeof(redis_replication_t));
+
+	redis_shared_lock(&redis_replications->lock, sizeof(redis_replications_t), 1);
+
+	// If the replication state is current
+	if ((replication = redis_replication_find(redis_target, &oldest)) != NULL && replication->expires > now) {
+
+		REDIS_STATS_ADD(cache_hits, 1);
+
+		replication->used = now;
+		memcpy(copy, replication, sizeof(redis_replication_t));
+
+		redis_shared_lock(&redis_replications->lock, sizeof(redis_replications_t), 0);
+
+		*replicationptr = copy;
+
+		return 0;
+
+	}
+
+	redis_shared_lock(&redis_replications->lock, sizeof(redis_replications_t), 0);
+
+	REDIS_STATS_ADD(cache_misses, 1);
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, redis_server, redis_port, redis_timeout, redis_password)) == NULL) {return 1;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "INFO REPLICATION", NULL, REDIS_REPLY_STRING)) {redisFree(redisC); return 1;}
+
+	// Free the context
+	redisFree(redisC);
+
+	redis_shared_lock(&redis_replications->lock, sizeof(redis_replications_t), 1);
+
+	// If the target has no state then replace the least recently used one (the state may have been replaced while unlocked)
+	if ((replication = redis_replication_find(redis_target, &oldest)) == NULL) {
+
+		replication = oldest;
+
+		memset(replication, 0, sizeof(redis_replication_t));
+		zbx_strlcpy(replication->target,redis_target,MAX_LENGTH_STRING);
+
+	}
+
+	// Parse the replication
+	redis_replication_parse(replication, redisR->str, now);
+	replication->expires = now + cache_ttl;
+	replication->used    = now;
+
+	memcpy(copy, replication, sizeof(redis_replication_t));
+
+	redis_shared_lock(&redis_replications->lock, sizeof(redis_replications_t), 0);
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// Assign the replication state
+	*replicationptr = copy;
+
+	return 0;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find a slave of a replication state        *
+ * Returns    : Slave (success), NULL (failure)                               *
+ *                                                                            *
+ ******************************************************************************/
+redis_replica_t * redis_replication_slave(redis_replication_t *replication, char *addr)
+{
+
+	// Declare Variables
+	int count;
+
+	for (count = 0; count < replication->slave_count; count++) {
 
-        // Set message
-        SET_MSG_RESULT(result,strdup(zbx_msg));
+		if (strcmp(replication->slaves[count].addr,addr) == 0) {return &replication->slaves[count];}
 
-	return 1;
+	}
+
+	return NULL;
 
 }
 
-/*************************************************************
- *                                                           *
- * Function   : This function confirm redis command support  *
- * Returns    : 0 (supported), 1 (unsupported)               *
- *                                                           *
- *************************************************************/
-int redis_command_is_supported(redisContext *redisC, char *command, char *zbx_key, char *zbx_msg)
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will free the replication states                *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_replications_free()
 {
 
-	// Declare variables
-	redisReply *redisR;
+	// If the states are shared
+	if (redis_replications != NULL && redis_replications != &redis_replications_local) {munmap(redis_replications, sizeof(redis_replications_t));}
 
-	// Run the redis command
-	redisR = redisCommand(redisC,"COMMAND INFO %s",command);
+	redis_replications = &redis_replications_local;
 
-	// If the connection is lost
-	if(redisR == NULL) {goto error_connection_lost;}
+}
 
-	// If the reply is not valid
-	if (redis_reply_valid(redisR->type,REDIS_REPLY_ARRAY,"COMMAND INFO",zbx_key,zbx_msg) == 1) {goto error_free_reply;}
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the event type of an event name        *
+ * Returns    : Event type (success), -1 (failure)                            *
+ *                                                                            *
+ ******************************************************************************/
+int redis_events_type(char *event)
+{
 
-	// If the command is supported
-	if (redisR->element[0]->elements) {
+	// Declare Variables
+	int count;
 
-		// Free the reply
-		freeReplyObject(redisR);
+	for (count = 0; count < EVENT_TYPES; count++) {
 
-		// Return supported
-		return 0;
+		if (strcmp(redis_event_names[count],event) == 0) {return count;}
 
 	}
 
-	// Form message
-	zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Required redis command (%s) is not supported by the redis server",MODULE,command);
+	return -1;
 
-	// Free the reply
-	freeReplyObject(redisR);
+}
 
-	// Return unsupported
-	return 1;
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find the counters of a key prefix, adding  *
+ *              them when they are not found and add is set (only the         *
+ *              listener of a target adds so slots are published without a    *
+ *              lock once the prefix has been written)                        *
+ * Returns    : Counters (success), NULL (failure)                            *
+ *                                                                            *
+ ******************************************************************************/
+static redis_event_prefix_t * redis_events_prefix(redis_events_t *events, const char *prefix, size_t length, int add)
+{
 
-error_connection_lost:
+	// Declare Variables
+	unsigned int          hash;
+	size_t                count;
+	redis_event_prefix_t *slot;
 
-	// Form message
-	zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis connection lost (%s)",redisC->errstr);
+	// If the prefix can not be held
+	if (length == 0 || length >= MAX_EVENT_PREFIX) {return NULL;}
 
-	goto error;
+	// Hash the prefix
+	hash = redis_hash(prefix, length);
 
-error_free_reply:
+	// Probe from the hashed slot
+	for (count = 0; count < MAX_EVENT_PREFIXES; count++) {
 
-	// Free the reply
-	freeReplyObject(redisR);
+		slot = &events->prefixes[(hash + count) % MAX_EVENT_PREFIXES];
 
-error:
+		// If the slot is free then the prefix has not been seen
+		if (! __atomic_load_n(&slot->used,__ATOMIC_ACQUIRE)) {
 
-        // Log message
-        zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+			if (! add) {return NULL;}
 
-out:
+			// Write the prefix and then publish the slot
+			memcpy(slot->prefix,prefix,length);
+			slot->prefix[length] = '\0';
+			__atomic_store_n(&slot->used,1,__ATOMIC_RELEASE);
 
-	// Return unsupported
-	return 1;
+			return slot;
+
+		}
+
+		// If the slot holds the prefix
+		if (strncmp(slot->prefix,prefix,length) == 0 && slot->prefix[length] == '\0') {return slot;}
+
+	}
+
+	return NULL;
 
 }
 
 /******************************************************************************
  *                                                                            *
- * Function   : This function will create a redis session on a redis server   *
- * Returns    : 0 (success), 1 (failure)                                      *
+ * Function   : This function will count a keyspace event of a key            *
+ * Returns    : Void                                                          *
  *                                                                            *
  ******************************************************************************/
-redisContext * redis_session(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password)
+static void redis_events_add(redis_events_t *events, int type, const char *key)
+{
+
+	// Declare Variables
+	const char           *delimiter;
+	redis_event_prefix_t *slot = NULL;
+
+	// Count the event for the target
+	__atomic_add_fetch(&events->total.count[type],1,__ATOMIC_RELAXED);
+
+	// Count the event for the key prefix (keys without a prefix or beyond the table are only counted in the total)
+	if ((delimiter = strchr(key,EVENT_PREFIX_DELIMITER)) != NULL) {slot = redis_events_prefix(events, key, delimiter - key, 1);}
+
+	if (slot != NULL) {__atomic_add_fetch(&slot->count[type],1,__ATOMIC_RELAXED);}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will update the rates of a set of counters      *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_events_rate_update(redis_event_prefix_t *slot, time_t elapsed)
+{
+
+	// Declare Variables
+	int                 type;
+	unsigned long long  count;
+
+	for (type = 0; type < EVENT_TYPES; type++) {
+
+		count = __atomic_load_n(&slot->count[type],__ATOMIC_RELAXED);
+
+		// Rates are held in events per thousand seconds so that they can be stored atomically
+		__atomic_store_n(&slot->rate[type],(count - slot->last[type]) * 1000 / elapsed,__ATOMIC_RELAXED);
+
+		slot->last[type] = count;
+
+	}
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will open the keyspace event subscription of a  *
+ *              target                                                        *
+ * Returns    : Context (success), NULL (failure)                             *
+ *                                                                            *
+ ******************************************************************************/
+static redisContext * redis_events_connect(redis_events_t *events)
+{
+
+	// Declare Variables
+	char         *zbx_key;
+	AGENT_RESULT  result;
+	redisContext *redisC;
+	int           done = 0;
+
+	// Initialise the result
+	memset(&result, 0, sizeof(AGENT_RESULT));
+
+	// Release the previous attempt from the request arena of this thread (it is not dispatched through redis_stats_dispatch)
+	redis_arena_reset();
+
+	// Form the key (only used for logging)
+	zbx_key = redis_arena_printf("keyspace events (%s:%s)",events->server,events->port);
+
+	// Create the redis session
+	if ((redisC = redis_session(&result, zbx_key, events->server, events->port, DEFAULT_REDIS_TIMEOUT, events->password)) == NULL) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Keyspace event listener (%s:%s) failed to connect (%s)",MODULE,events->server,events->port,(result.msg != NULL) ? result.msg : "Unknown");
+
+		// Free the message
+		if (result.msg != NULL) {free(result.msg);}
+
+		return NULL;
+
+	}
+
+	// Subscribe (the confirmations are read by the listener as they may arrive as RESP3 pushes)
+	redis_command_append(redisC,"PSUBSCRIBE __keyevent@*__:expired __keyevent@*__:evicted __keyevent@*__:set");
+
+	// Send the subscription
+	while (! done) {
+
+		if (redisBufferWrite(redisC,&done) == REDIS_ERR) {redisFree(redisC); return NULL;}
+
+	}
+
+	// Log message
+	zabbix_log(LOG_LEVEL_INFORMATION,"Module (%s): Keyspace event listener (%s:%s) subscribed",MODULE,events->server,events->port);
+
+	// Set connected
+	__atomic_store_n(&events->connected,1,__ATOMIC_RELEASE);
+
+	return redisC;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will listen for the keyspace events of a target *
+ *              and count them until the module is uninitialised (reconnects  *
+ *              every EVENT_RECONNECT_INTERVAL seconds when disconnected)     *
+ * Returns    : NULL                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void * redis_events_listen(void *arg)
 {
 
 	// Declare Variables
-	char            zbx_msg[MAX_LENGTH_MSG] = "";
+	redis_events_t *events = arg;
+	redisContext   *redisC = NULL;
 	redisReply     *redisR;
-	redisContext   *redisC;
-	struct timeval  timeout;
+	char           *event;
+	time_t          now, window = time(NULL), reconnect = 0;
+	int             count, pending, type;
 
-	// Set Timeout
-	timeout.tv_sec = atol(redis_timeout);
-	timeout.tv_usec = 0;
+	while (! __atomic_load_n(&redis_events_stop,__ATOMIC_ACQUIRE)) {
 
-	// Attempt the connection
-	redisC = redisConnectWithTimeout(redis_server,atol(redis_port),timeout);
+		now = time(NULL);
 
-	// If there was an error connecting
-	if (redisC == NULL || redisC->err) {
+		// If there is no subscription (or it has been lost) then connect
+		if (redisC == NULL && now >= reconnect) {
 
-		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis connection failed (Unknown)");
+			if ((redisC = redis_events_connect(events)) == NULL) {reconnect = now + EVENT_RECONNECT_INTERVAL;}
 
-		// If there is an error message
-		if (redisC->err) {
+			__atomic_store_n(&redis_events_subscriptions[events - redis_events],redisC,__ATOMIC_RELEASE);
 
-			// Form message
-			zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis connection failed (%s)",redisC->errstr);
+		}
+
+		// If there is no subscription then wait
+		if (redisC == NULL) {sleep(1); goto listen_rate;}
+
+		// Wait for an event
+		pending = redis_reply_pending(redisC, 1000, &redisR);
+
+		// If the subscription has been lost
+		if (pending == -1) {
+
+			// Log message
+			zabbix_log(LOG_LEVEL_WARNING,"Module (%s): Keyspace event listener (%s:%s) lost connection",MODULE,events->server,events->port);
+
+			// Set disconnected
+			__atomic_store_n(&events->connected,0,__ATOMIC_RELEASE);
+			__atomic_store_n(&redis_events_subscriptions[events - redis_events],NULL,__ATOMIC_RELEASE);
+
+			redisFree(redisC);
+			redisC = NULL;
+			reconnect = now + EVENT_RECONNECT_INTERVAL;
+
+			goto listen_rate;
 
 		}
 
-		goto session_invalid;
+		// If there is an event (Events are [pmessage, pattern, __keyevent@db__:event, key])
+		if (pending == 1) {
+
+#ifdef HAVE_REDIS_RESP3
+			if ((redisR->type == REDIS_REPLY_ARRAY || redisR->type == REDIS_REPLY_PUSH) && redisR->elements == 4
+#else
+			if (redisR->type == REDIS_REPLY_ARRAY && redisR->elements == 4
+#endif
+			 && redisR->element[2]->str != NULL && redisR->element[3]->str != NULL && (event = strrchr(redisR->element[2]->str,':')) != NULL
+			 && (type = redis_events_type(event + 1)) != -1) {
+
+				redis_events_add(events, type, redisR->element[3]->str);
+
+			}
+
+			// Free the reply
+			redis_reply_free(redisR);
+
+		}
+
+listen_rate:
+
+		// If the rate interval has passed
+		if ((now = time(NULL)) - window < EVENT_RATE_INTERVAL) {continue;}
+
+		// Update the rates
+		redis_events_rate_update(&events->total, now - window);
+
+		for (count = 0; count < MAX_EVENT_PREFIXES; count++) {
+
+			if (__atomic_load_n(&events->prefixes[count].used,__ATOMIC_ACQUIRE)) {redis_events_rate_update(&events->prefixes[count], now - window);}
+
+		}
+
+		window = now;
 
 	}
 
-	// Authenticate with blank password (The assumption is that there could be a blank password)
-	if (strlen(redis_password) == 0) {redisR = redisCommand(redisC,"AUTH ''");}
-	if (strlen(redis_password) > 0)  {redisR = redisCommand(redisC,"AUTH %s",redis_password);}
+	// Close the subscription
+	__atomic_store_n(&redis_events_subscriptions[events - redis_events],NULL,__ATOMIC_RELEASE);
 
-	// If the connection is lost
-	if(redisR == NULL) {goto error_connection_lost;}
+	if (redisC != NULL) {redisFree(redisC);}
 
-	// Free the reply
-	freeReplyObject(redisR);
+	// Free the request arena of this thread
+	redis_arena_free();
 
-	// Test whether authentication has been successful
-	redisR = redisCommand(redisC,"ECHO Authentication-Test");
+	return NULL;
 
-	// If the connection is lost
-	if(redisR == NULL) {goto error_connection_lost;}
+}
 
-	// If the authentication failed
-	if (strcmp(redisR->str,"NOAUTH Authentication required.") == 0) {
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will hold the tables the listeners share with   *
+ *              the process across a fork, so that a forked process never     *
+ *              inherits them half changed                                    *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_events_prepare()
+{
 
-		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis authentication failed",MODULE);
+	pthread_mutex_lock(&redis_sentinels_lock);
+	pthread_mutex_lock(&redis_hello_lock);
+	pthread_mutex_lock(&redis_stats_lock);
 
-		// Free the reply
-		freeReplyObject(redisR);
+}
 
-		goto session_invalid;
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will release the tables held across a fork      *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_events_parent()
+{
+
+	pthread_mutex_unlock(&redis_stats_lock);
+	pthread_mutex_unlock(&redis_hello_lock);
+	pthread_mutex_unlock(&redis_sentinels_lock);
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will close the subscriptions a forked process   *
+ *              has inherited (the listeners and the parent own them)         *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+static void redis_events_atfork()
+{
+
+	// Declare Variables
+	redisContext *redisC;
+	int           count;
+
+	// Close the copy of every keyspace event subscription (the context is left as the listener may have been changing it)
+	for (count = 0; count < redis_events_targets; count++) {
+
+		if ((redisC = __atomic_load_n(&redis_events_subscriptions[count],__ATOMIC_ACQUIRE)) != NULL) {close(redisC->fd);}
 
 	}
 
-	// Free the reply
-	freeReplyObject(redisR);
+	// Forget every sentinel subscription, so that failover notifications are only read by the process that subscribed
+	for (count = 0; count < MAX_SENTINEL_TARGETS; count++) {redis_sentinel_close(&redis_sentinels[count]);}
 
-	// We want to set the client name in order to exclude from client discovery
-	redisR = redisCommand(redisC,"CLIENT SETNAME %s",MODULE);
+	redis_events_parent();
 
-	// If the connection is lost
-	if(redisR == NULL) {goto error_connection_lost;}
+}
 
-	// Free the reply
-	freeReplyObject(redisR);
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will start a keyspace event listener for every  *
+ *              named target with events set and every target in              *
+ *              LIBZBXREDIS_EVENTS (host:port separated by commas).           *
+ *              The counters are shared with the agent processes forked after *
+ *              the module has been initialised so they are read without      *
+ *              polling redis (the listeners connect so init does not block)  *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_events_start()
+{
 
-	goto session_valid;
+	// Declare Variables
+	char           *targets, *target, *target_next, *port, *password;
+	redis_events_t *events;
+	int             count, named;
 
-error_connection_lost:
+	// Get the targets
+	targets = getenv(EVENT_TARGETS_ENV);
+
+	// Count the named targets to listen to
+	for (count = 0, named = 0; count < redis_targets_count; count++) {named += redis_targets[count].events;}
+
+	// If no targets have been configured
+	if (strisnull(targets) && named == 0) {return 0;}
+
+	// Password of every target
+	password = strisnull(getenv(EVENT_PASSWORD_ENV)) ? DEFAULT_REDIS_PASS : getenv(EVENT_PASSWORD_ENV);
+
+	// Allocate the counters in memory shared with the forked agent processes
+	redis_events = mmap(NULL, sizeof(redis_events_t) * MAX_EVENT_TARGETS, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	// If the allocation failed
+	if (redis_events == MAP_FAILED) {
+
+		// Log message
+		zabbix_log(LOG_LEVEL_ERR,"Module (%s): Keyspace event counters could not be allocated (%s)",MODULE,strerror(errno));
+
+		redis_events = NULL;
+
+		return 1;
+
+	}
+
+	memset(redis_events, 0, sizeof(redis_events_t) * MAX_EVENT_TARGETS);
+
+	// Add the named targets that listen to events
+	for (count = 0; count < redis_targets_count && redis_events_targets < MAX_EVENT_TARGETS; count++) {
+
+		if (! redis_targets[count].events) {continue;}
+
+		events = &redis_events[redis_events_targets];
+
+		zbx_strlcpy(events->server,redis_targets[count].server,MAX_LENGTH_STRING);
+		zbx_strlcpy(events->port,redis_targets[count].port,MAX_LENGTH_PARAM);
+		zbx_strlcpy(events->password,redis_targets[count].password,MAX_LENGTH_PARAM);
+
+		redis_events_targets++;
+
+	}
+
+	// Take a copy of the targets
+	targets = zbx_strdup(NULL, strisnull(targets) ? "" : targets);
+
+	// Process every target
+	for (target = targets; target != NULL && redis_events_targets < MAX_EVENT_TARGETS; target = target_next) {
+
+		// Terminate the target
+		if ((target_next = strchr(target,',')) != NULL) {*target_next++ = '\0';}
+
+		// If the target is empty
+		if (*target == '\0') {continue;}
+
+		events = &redis_events[redis_events_targets];
+
+		// Sentinel targets carry their own port
+		zbx_strlcpy(events->server,target,MAX_LENGTH_STRING);
+		zbx_strlcpy(events->port,DEFAULT_REDIS_PORT,MAX_LENGTH_PARAM);
+		zbx_strlcpy(events->password,password,MAX_LENGTH_PARAM);
+
+		// If a port has been given
+		if (strncmp(target,REDIS_SENTINEL_PREFIX,strlen(REDIS_SENTINEL_PREFIX)) != 0 && (port = strrchr(events->server,':')) != NULL) {
+
+			zbx_strlcpy(events->port,port + 1,MAX_LENGTH_PARAM);
+			*port = '\0';
+
+		}
+
+		redis_events_targets++;
+
+	}
+
+	zbx_free(targets);
+
+	// Start the listeners (processes forked later close the subscriptions they inherit)
+	redis_events_owner = getpid();
 
-	// Form message
-	zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis connection lost (%s)",redisC->errstr);
+	pthread_atfork(redis_events_prepare, redis_events_parent, redis_events_atfork);
 
-	goto session_invalid;
+	for (count = 0; count < redis_events_targets; count++) {
 
-session_valid:
+		// If the listener could not be started
+		if (pthread_create(&redis_events_threads[count], NULL, redis_events_listen, &redis_events[count]) != 0) {
 
-	return redisC;
+			// Log message
+			zabbix_log(LOG_LEVEL_ERR,"Module (%s): Keyspace event listener (%s:%s) could not be started",MODULE,redis_events[count].server,redis_events[count].port);
 
-session_invalid:
+			continue;
 
-	// Free the context
-	redisFree(redisC);
+		}
 
-	// Log message
-	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
+		redis_events_started[count] = 1;
 
-	// Set message
-	SET_MSG_RESULT(result,strdup(zbx_msg));
+	}
 
-	return NULL;
+	return 0;
 
 }
 
 /******************************************************************************
  *                                                                            *
- * Function   : This function will run a redis command and set the reply      *
+ * Function   : This function will get the counters of a key prefix of a      *
+ *              target (a blank prefix gets the counters of every key)        *
  * Returns    : 0 (success), 1 (failure)                                      *
  *                                                                            *
  ******************************************************************************/
-int redis_command(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, redisReply **redisRptr, char *command, char *param, int redisReplyType)
+int redis_events_get(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *prefix, redis_event_prefix_t **slotptr)
 {
 
 	// Declare Variables
-	char          zbx_msg[MAX_LENGTH_MSG] = "";
-	char          redisCmd[MAX_LENGTH_STRING];
-	redisReply   *redisR;
-
-	// If there are parameters
-	if (param != NULL) {zbx_snprintf(redisCmd,MAX_LENGTH_STRING,"%s %s",command,param);}
-
-	// If there are no parameters
-	if (param == NULL) {zbx_snprintf(redisCmd,MAX_LENGTH_STRING,"%s",command);}
+	char                 *zbx_msg = "";
+	redis_events_t       *events = NULL;
+	int                   count;
+	static redis_event_prefix_t empty;
 
-	// If the connection is lost
-	if (redisC == NULL || redisC->err) {
+	// Find the target (the port of a sentinel target is not compared)
+	for (count = 0; redis_events != NULL && count < redis_events_targets; count++) {
 
-		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis connection lost (%s)",redisC->errstr);
+		if (strcmp(redis_events[count].server,redis_server) != 0) {continue;}
 
-		goto command_invalid;
+		if (strncmp(redis_server,REDIS_SENTINEL_PREFIX,strlen(REDIS_SENTINEL_PREFIX)) == 0 || strcmp(redis_events[count].port,redis_port) == 0) {events = &redis_events[count]; break;}
 
 	}
 
-	// Run the redis command
-	redisR = redisCommand(redisC,redisCmd);
-
-	// If the connection is lost
-	if (redisR == NULL) {
+	// If the target is not listened to
+	if (events == NULL) {
 
 		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis connection lost (%s)",redisC->errstr);
+		zbx_msg = redis_arena_printf("Keyspace events are not listened to for target (%s:%s), set %s",redis_server,redis_port,EVENT_TARGETS_ENV);
 
-		goto command_invalid;
+		goto events_invalid;
 
 	}
 
-	// If the reply type is an error
-	if (redisR->type == REDIS_REPLY_ERROR) {
+	// If the listener is not subscribed
+	if (! __atomic_load_n(&events->connected,__ATOMIC_ACQUIRE)) {
 
 		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis command error (%s)",redisR->str);
-
-		goto command_invalid;
+		zbx_msg = redis_arena_printf("Keyspace event listener is not connected (%s:%s)",events->server,events->port);
 
+		goto events_invalid;
 
 	}
 
-	// If the redis reply type is to be checked
-	if (redisReplyType == 9999) {goto command_valid;}
-
-	// If the reply is not valid
-	if (redis_reply_valid(redisR->type,redisReplyType,command,zbx_key,zbx_msg) == 1) {goto command_invalid;}
-
-command_valid:
-
-	// Assign the reply
-	*redisRptr = redisR;
+	// Get the counters (prefixes that have not been seen have no events)
+	if (strisnull(prefix))                                                                  {*slotptr = &events->total;}
+	else if ((*slotptr = redis_events_prefix(events, prefix, strlen(prefix), 0)) == NULL)   {*slotptr = &empty;}
 
 	return 0;
 
-command_invalid:
+events_invalid:
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s) - %s - Key %s",MODULE,zbx_msg,zbx_key);
@@ -819,19 +6615,64 @@ command_invalid:
 
 }
 
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will stop the keyspace event listeners          *
+ * Returns    : Void                                                          *
+ *                                                                            *
+ ******************************************************************************/
+void redis_events_free()
+{
+
+	// Declare Variables
+	int count;
+
+	// If there are no listeners
+	if (redis_events == NULL) {return;}
+
+	// The listeners only run in the process that started them
+	if (redis_events_owner == getpid()) {
+
+		__atomic_store_n(&redis_events_stop,1,__ATOMIC_RELEASE);
+
+		for (count = 0; count < redis_events_targets; count++) {
+
+			if (redis_events_started[count]) {pthread_join(redis_events_threads[count], NULL);}
+
+			redis_events_started[count] = 0;
+
+		}
+
+	}
+
+	// Free the counters
+	munmap(redis_events, sizeof(redis_events_t) * MAX_EVENT_TARGETS);
+	redis_events = NULL;
+
+}
+
 /*************************************************************************
  *                                                                       *
  * Function   : This function will check if a redis reply is valid       *
  * Returns    : 0 (success), 1 (failure)                                 *
  *                                                                       *
  *************************************************************************/
-int redis_reply_valid(int reply_received, int reply_expected, char *command, char *zbx_key, char *zbx_msg)
+int redis_reply_valid(int reply_received, int reply_expected, char *command, char *zbx_key, char **zbx_msg)
 {
 
 	// Declare Variables
 	char reply_received_text[128] = "Unknown";
 	char reply_expected_text[128] = "Unknown";
 
+#ifdef HAVE_REDIS_RESP3
+
+	// RESP3 verbatim strings are strings and maps/sets are laid out as arrays
+	if (reply_received == REDIS_REPLY_VERB) {reply_received = REDIS_REPLY_STRING;}
+	if (reply_received == REDIS_REPLY_MAP)  {reply_received = REDIS_REPLY_ARRAY;}
+	if (reply_received == REDIS_REPLY_SET)  {reply_received = REDIS_REPLY_ARRAY;}
+
+#endif
+
 	// Set the reply type that has been received and expected
 	if(reply_received == REDIS_REPLY_STRING)  {zbx_strlcpy(reply_received_text,"STRING",sizeof(reply_received_text));}
 	if(reply_received == REDIS_REPLY_INTEGER) {zbx_strlcpy(reply_received_text,"INTEGER",sizeof(reply_received_text));}
@@ -846,11 +6687,20 @@ int redis_reply_valid(int reply_received, int reply_expected, char *command, cha
 	if(reply_expected == REDIS_REPLY_NIL)     {zbx_strlcpy(reply_expected_text,"NIL",sizeof(reply_expected_text));}
 	if(reply_expected == REDIS_REPLY_ERROR)   {zbx_strlcpy(reply_expected_text,"ERROR",sizeof(reply_expected_text));}
 
+#ifdef HAVE_REDIS_RESP3
+
+	// Set the RESP3 reply types that have been received
+	if(reply_received == REDIS_REPLY_DOUBLE)  {zbx_strlcpy(reply_received_text,"DOUBLE",sizeof(reply_received_text));}
+	if(reply_received == REDIS_REPLY_BOOL)    {zbx_strlcpy(reply_received_text,"BOOL",sizeof(reply_received_text));}
+	if(reply_received == REDIS_REPLY_BIGNUM)  {zbx_strlcpy(reply_received_text,"BIGNUM",sizeof(reply_received_text));}
+
+#endif
+
 	// If the reply is not a match
 	if (reply_received != reply_expected) {
 
 		// Form message
-		zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Redis reply invalid - Error (Command %s Expected %s: Received %s)",command,reply_expected_text,reply_received_text);
+		*zbx_msg = redis_arena_printf("Redis reply invalid - Error (Command %s Expected %s: Received %s)",command,reply_expected_text,reply_received_text);
 
 		// Return failure
 		return 1;
@@ -862,83 +6712,269 @@ int redis_reply_valid(int reply_received, int reply_expected, char *command, cha
 
 }
 
+/*************************************************************************
+ *                                                                       *
+ * Function   : This function will get the value of a field from a map   *
+ *              reply (RESP3) or a flat field/value array reply (RESP2)  *
+ * Returns    : Reply element (success), NULL (failure)                  *
+ *                                                                       *
+ *************************************************************************/
+redisReply * redis_reply_map_value(redisReply *redisR, char *field)
+{
+
+	// Declare Variables
+	size_t count;
+
+	// Fields and values alternate
+	for (count = 0; count + 1 < redisR->elements; count += 2) {
+
+		// If the field matches
+		if (redisR->element[count]->str != NULL && strcasecmp(redisR->element[count]->str,field) == 0) {return redisR->element[count + 1];}
+
+	}
+
+	return NULL;
+
+}
+
+/*************************************************************************
+ *                                                                       *
+ * Function   : This function will get a value from a nested map reply   *
+ *              where the path is made up of field names joined with '.' *
+ *              (field names may themselves contain '.' ie db.0)         *
+ * Returns    : Reply element (success), NULL (failure)                  *
+ *                                                                       *
+ *************************************************************************/
+redisReply * redis_reply_path_value(redisReply *redisR, char *path)
+{
+
+	// Declare Variables
+	size_t      count, length;
+	redisReply *field, *value;
+
+	// If the reply can not be searched
+	if (redisR == NULL || redisR->element == NULL) {return NULL;}
+
+	// Fields and values alternate
+	for (count = 0; count + 1 < redisR->elements; count += 2) {
+
+		// Declare Variables
+		field  = redisR->element[count];
+		value  = redisR->element[count + 1];
+
+		// If the field is not named
+		if (field->str == NULL) {continue;}
+
+		// If the field matches the whole path
+		if (strcmp(field->str,path) == 0) {return value;}
+
+		// If the field matches the start of the path then search the nested reply
+		length = strlen(field->str);
+		if (value->element != NULL && strncmp(field->str,path,length) == 0 && path[length] == '.') {
+
+			// If the rest of the path is found
+			if ((value = redis_reply_path_value(value, path + length + 1)) != NULL) {return value;}
+
+		}
+
+	}
+
+	return NULL;
+
+}
+
+/*************************************************************************
+ *                                                                       *
+ * Function   : This function will find the element of an array reply    *
+ *              whose map (or field/value array) has a field value       *
+ * Returns    : Reply element (success), NULL (failure)                  *
+ *                                                                       *
+ *************************************************************************/
+redisReply * redis_reply_find(redisReply *redisR, char *field, char *value)
+{
+
+	// Declare Variables
+	size_t      count;
+	redisReply *redisValue;
+
+	// For every element
+	for (count = 0; count < redisR->elements; count++) {
+
+		// If the field has the value
+		if ((redisValue = redis_reply_map_value(redisR->element[count], field)) != NULL && redisValue->str != NULL && strcmp(redisValue->str,value) == 0) {return redisR->element[count];}
+
+	}
+
+	return NULL;
+
+}
+
 /******************************************************************************
  *                                                                            *
- * Function   : This function will get the value depending on the required    *
- *              field name and whether the data is single or multi value      *
+ * Function   : This function will find the first delimiter of a set          *
+ *              (SCAN_NEWLINE, SCAN_COLON etc...) in text                     *
+ * Returns    : First delimiter (found), end (not found)                      *
+ *                                                                            *
+ ******************************************************************************/
+char * redis_scan(char *data, char *end, int delimiters)
+{
+
+	while (data < end && (redis_scan_classes[(unsigned char)*data] & delimiters) == 0) {data++;}
+
+	return data;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the next line of text, skipping empty  *
+ *              lines as strtok does, and terminate it in place               *
+ * Returns    : Line (success), NULL (no more lines)                          *
+ *                                                                            *
+ ******************************************************************************/
+char * redis_scan_line(char **cursor, char *end, char **line_end)
+{
+
+	// Declare Variables
+	char *line = *cursor;
+
+	// Skip the line breaks
+	while (line < end && (*line == '\n' || *line == '\r')) {line++;}
+
+	// If there are no more lines
+	if (line >= end) {*cursor = end; return NULL;}
+
+	// Find the end of the line
+	*line_end = redis_scan(line, end, SCAN_LINE);
+
+	// Terminate the line
+	if (*line_end < end) {**line_end = '\0'; *cursor = *line_end + 1;} else {*cursor = end;}
+
+	return line;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will split a line of INFO into its field and    *
+ *              data in place (field:data), with a prefix the field must be   *
+ *              the prefix and a number (ie db0, slave1) and only the number  *
+ *              is returned                                                   *
  * Returns    : 0 (success), 1 (failure)                                      *
  *                                                                            *
  ******************************************************************************/
-int redis_get_value(char *redis_field, char *redis_data, char *redis_search, char *redis_value)
+int redis_info_split(char *line, char *line_end, const char *prefix, char **redis_field, char **redis_data)
 {
 
-	// Declare variables
-	char            regex[MAX_LENGTH_REGEX] = "";
-        regex_t         regexCompiled;
-        regmatch_t      regexGroups[2];
-	char            zbx_msg[MAX_LENGTH_MSG] = "";
+	// Declare Variables
+	size_t  length = (prefix != NULL) ? strlen(prefix) : 0;
+	char   *colon, *digit;
 
-	// If the line is a multi value (ie field=val,field=val)
-	if (regexec(&regexCompiled_INFO_MULTI_VALUE,redis_data,1,regexGroups,0) == 0) {
+	// If the line does not start with the prefix
+	if (length > 0 && strncmp(line,prefix,length) != 0) {return 1;}
 
-		// Lets build the regex to match the required field
-		strcat(regex,"");
-		strcat(regex,redis_search);
-		strcat(regex,"=([^, ]*)");
+	// If the line has no data
+	if ((colon = redis_scan(line + length, line_end, SCAN_COLON)) == line_end) {return 1;}
 
-		// Compile the regular expression and if it fails
-		if (regcomp(&regexCompiled,regex,REG_EXTENDED)) {
+	// If the field is not numbered
+	if (prefix != NULL) {
 
-			// Form message
-			zbx_snprintf(zbx_msg,MAX_LENGTH_MSG,"Unable to compile regular expression ([%s])",regex);
+		if (colon == line + length) {return 1;}
 
-			// Log message
-			zabbix_log(LOG_LEVEL_DEBUG,"%s",zbx_msg);
+		for (digit = line + length; digit < colon; digit++) {if (! isdigit((unsigned char)*digit)) {return 1;}}
 
-			goto failure;
+	}
 
-		}
+	// Split the field from its data
+	*colon = '\0';
+	*redis_field = line + length;
+	*redis_data  = colon + 1;
 
-		// If the line contains the searched field
-		if (regexec(&regexCompiled,redis_data,2,regexGroups,0) == 0) {
+	return 0;
 
-			// Copy the value
-			zbx_strlcpy(redis_value,redis_data + regexGroups[1].rm_so,regexGroups[1].rm_eo - regexGroups[1].rm_so + 1);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will find a field in the output of INFO (the    *
+ *              output is split in place)                                     *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_info_value(char *redis_info, char *redis_search, char *redis_value)
+{
 
-			// Free compiled regex
-			regfree(&regexCompiled);
+	// Declare Variables
+	char *cursor = redis_info, *end = redis_info + strlen(redis_info);
+	char *line, *line_end, *redis_field, *redis_data;
 
-			goto success;
+	// Get first line of output
+	line = redis_scan_line(&cursor, end, &line_end);
 
-		}
+	// Process every line of output
+	while (line != NULL) {
+
+		// If the line contains the key field
+		if (redis_info_split(line, line_end, NULL, &redis_field, &redis_data) == 0 && redis_get_value(redis_field, redis_data, redis_search, redis_value) == 0) {return 0;}
+
+		// Get next line of output
+		line = redis_scan_line(&cursor, end, &line_end);
 
 	}
 
+	return 1;
+
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Function   : This function will get the value depending on the required    *
+ *              field name and whether the data is single or multi value      *
+ * Returns    : 0 (success), 1 (failure)                                      *
+ *                                                                            *
+ ******************************************************************************/
+int redis_get_value(char *redis_field, char *redis_data, char *redis_search, char *redis_value)
+{
+
+	// Declare variables
+	char   *end = redis_data + strlen(redis_data);
+	char   *name, *name_end, *value_end;
+	size_t  length = strlen(redis_search);
+
 	// If the line is a single value (ie val)
-	if (regexec(&regexCompiled_INFO_MULTI_VALUE,redis_data,1,regexGroups,0) == 1) {
+	if (redis_scan(redis_data, end, SCAN_EQUALS) == end) {
+
+		// If the field does not match the search
+		if (strcmp(redis_field,redis_search) != 0) {return 1;}
+
+		// Copy the value
+		zbx_strlcpy(redis_value,redis_data,end - redis_data + 1);
+
+		return 0;
+
+	}
+
+	// Process every field of the multi value (ie field=val,field=val)
+	for (name = redis_data; name < end; name = value_end + 1) {
+
+		// Find the end of the field and of its value
+		name_end  = redis_scan(name, end, SCAN_EQUALS | SCAN_COMMA | SCAN_SPACE);
+		value_end = (*name_end == '=') ? redis_scan(name_end + 1, end, SCAN_COMMA | SCAN_SPACE) : name_end;
 
 		// If the field matches the search
-		if (strcmp(redis_field,redis_search) == 0) {
+		if (*name_end == '=' && (size_t)(name_end - name) == length && strncmp(name,redis_search,length) == 0) {
 
 			// Copy the value
-			zbx_strlcpy(redis_value,redis_data,strlen(redis_data)+1);
+			zbx_strlcpy(redis_value,name_end + 1,value_end - name_end);
 
-			goto success;
+			return 0;
 
 		}
 
 	}
 
-failure:
-
-	// Return success
 	return 1;
 
-success:
-
-	// Return success
-	return 0;
-
 }
 
 /******************************************************************************
@@ -967,7 +7003,7 @@ int redis_select_database(AGENT_RESULT *result, int *ret, char *zbx_key, redisCo
 	}
 
 	// Free the reply
-	freeReplyObject(redisR);
+	redis_reply_free(redisR);
 
 	return 0;
 
@@ -999,7 +7035,7 @@ int redis_key_check_exists(AGENT_RESULT *result, int *ret, char *zbx_key, redisC
         }
 
         // Free the reply
-        freeReplyObject(redisR);
+        redis_reply_free(redisR);
 
 	return 0;
 
@@ -1018,7 +7054,7 @@ int redis_key_check_type(AGENT_RESULT *result, int *ret, char *zbx_key, redisCon
 	redisReply *redisR;
 
         // Run redis command
-        if (redis_command(result, zbx_key, *redisCptr, &redisR, "TYPE", key, REDIS_REPLY_INTEGER)) {return 1;}
+        if (redis_command(result, zbx_key, *redisCptr, &redisR, "TYPE", key, REDIS_REPLY_STATUS)) {return 1;}
 
         // If the key is not the correct type
         if (strcmp(redisR->str,type) != 0) {
@@ -1031,7 +7067,7 @@ int redis_key_check_type(AGENT_RESULT *result, int *ret, char *zbx_key, redisCon
         }
 
         // Free the reply
-        freeReplyObject(redisR);
+        redis_reply_free(redisR);
 
 	return 0;
 
@@ -1069,9 +7105,90 @@ int redis_hash_field_check_exists(AGENT_RESULT *result, int *ret, char *zbx_key,
         }
 
         // Free the reply
-        freeReplyObject(redisR);
+        redis_reply_free(redisR);
 
 	return 0;
 
 }
 
+/*********************************************************************************
+ *                                                                               *
+ * Function   : This function will run a command on a key of an expected type,   *
+ *              the TYPE check and the command are pipelined in one round trip   *
+ *              (the command reply is only used if the key type matches)         *
+ * Returns    : 0 (success), 1 (failure)                                         *
+ *                                                                               *
+ *********************************************************************************/
+int redis_key_typed_command(AGENT_RESULT *result, int *ret, char *zbx_key, redisContext *redisC, redisReply **redisRptr, char *key, char *type, int argc, const char **argv, int redisReplyType)
+{
+
+	// Declare Variables
+	char       *zbx_msg = "";
+	redisReply *redisType = NULL, *redisR = NULL;
+
+	// Pipeline the type check and the command
+	redis_command_append(redisC,"TYPE %s",key);
+	redis_command_append_argv(redisC,argc,argv,NULL);
+
+	// If the connection is lost
+	if (redisGetReply(redisC,(void **)&redisType) != REDIS_OK || redisGetReply(redisC,(void **)&redisR) != REDIS_OK) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis connection lost (%s)",redisC->errstr);
+
+		goto typed_invalid;
+
+	}
+
+	// If the redis key does not exist
+	if (redisType->type == REDIS_REPLY_STATUS && strcmp(redisType->str,"none") == 0) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis key does not exist");
+
+		goto typed_invalid;
+
+	}
+
+	// If the redis key type does not match
+	if (redisType->type != REDIS_REPLY_STATUS || strcmp(redisType->str,type) != 0) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis key type does not match");
+
+		goto typed_invalid;
+
+	}
+
+	// If the reply type is an error
+	if (redisR->type == REDIS_REPLY_ERROR) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Redis command error (%s)",redisR->str);
+
+		goto typed_invalid;
+
+	}
+
+	// If the reply is not valid
+	if (redis_reply_valid(redisR->type,redisReplyType,(char *)argv[0],zbx_key,&zbx_msg) == 1) {goto typed_invalid;}
+
+	// Free the type reply
+	redis_reply_free(redisType);
+
+	// Assign the reply
+	*redisRptr = redisR;
+
+	return 0;
+
+typed_invalid:
+
+	// Free the replies
+	if (redisType != NULL) {redis_reply_free(redisType);}
+
+	// Set the return
+	zbx_ret_fail(result, ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, redisR);
+
+	return 1;
+
+}
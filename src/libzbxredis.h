@@ -24,7 +24,11 @@
 
 #include <ctype.h>
 #include <stdarg.h>
+#include <poll.h>
 #include <arpa/inet.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <sys/mman.h>
 
 // Hiredis headers
 #include <hiredis.h>
@@ -51,12 +55,154 @@
 #define MAX_LENGTH_TEXT 8192
 #define MAX_LENGTH_LINE 8192
 #define MAX_LENGTH_REGEX 8192
+#define MAX_LENGTH_CURSOR 32
 
 // Default values
 #define DEFAULT_REDIS_SERVER  "127.0.0.1"
 #define DEFAULT_REDIS_PORT "6379"
 #define DEFAULT_REDIS_PASS ""
 #define DEFAULT_REDIS_TIMEOUT "5"
+#define DEFAULT_SENTINEL_PORT "26379"
+
+// RESP3 negotiation (HELLO 3) and replaceable context socket functions are only available with hiredis 1.0 and later
+#ifdef REDIS_REPLY_MAP
+#define HAVE_REDIS_RESP3 1
+#define HAVE_REDIS_CONTEXT_FUNCS 1
+#endif
+#define MAX_HELLO_TARGETS 64
+
+// Delimiter scanning of text replies (a byte at a time against a class table)
+#define SCAN_NEWLINE 0x01
+#define SCAN_RETURN 0x02
+#define SCAN_COLON 0x04
+#define SCAN_EQUALS 0x08
+#define SCAN_COMMA 0x10
+#define SCAN_SPACE 0x20
+#define SCAN_LINE (SCAN_NEWLINE | SCAN_RETURN)
+
+// Request arena (keys, messages and parsed fields of a key, released at once when its handler returns)
+#define ARENA_BLOCK_SIZE 65536
+#define ARENA_ALIGNMENT 8
+
+// Reply arenas (every reply of a module context is laid out in blocks of its own, freed at once by redis_reply_free)
+#define REPLY_ARENA_BLOCK_SIZE 1024
+#define MAX_REPLY_ARENA_BLOCK_SIZE 1048576
+#define REPLY_ARENA_ELEMENT_SIZE 24
+
+// Module statistics (libzbxredis.stats, latency buckets of 1ms,10ms,100ms,1s,10s and more)
+#define MAX_STATS_KEYS 128
+#define STATS_INDEX_SIZE 256
+#define STATS_LATENCY_BUCKETS 6
+
+// Named targets (@name, loaded from the module configuration file when the module is initialised)
+#define TARGETS_CONFIG_ENV "LIBZBXREDIS_CONFIG"
+#define DEFAULT_TARGETS_CONFIG "/etc/zabbix/libzbxredis.conf"
+#define REDIS_TARGET_PREFIX '@'
+#define MAX_TARGETS 64
+#define TARGET_INDEX_SIZE 128
+#define MIN_CACHE_TTL 1
+#define MAX_CACHE_TTL 3600
+
+// Reply cache (replies shared by several keys are fetched once per interval)
+#define REDIS_CACHE_TTL 10
+#define MAX_CACHE_ENTRIES 64
+
+// Big key sampler (bounded SCAN per poll, top-K heap and per-prefix reservoir)
+#define DEFAULT_BIGKEYS_COUNT "100"
+#define DEFAULT_BIGKEYS_SAMPLES "5"
+#define DEFAULT_BIGKEYS_TOPK "10"
+#define MIN_BIGKEYS_COUNT 1
+#define MAX_BIGKEYS_COUNT 1000
+#define MIN_BIGKEYS_SAMPLES 1
+#define MAX_BIGKEYS_SAMPLES 64
+#define MIN_BIGKEYS_TOPK 1
+#define MAX_BIGKEYS_TOPK 100
+#define MAX_BIGKEYS_TARGETS 8
+#define MAX_BIGKEYS_NAME 128
+#define BIGKEYS_RESERVOIR_SIZE 1024
+#define BIGKEYS_PREFIX_DELIMITER ':'
+
+// TTL histogram sampler (RANDOMKEY or incremental SCAN MATCH, then pipelined PTTL)
+#define DEFAULT_TTL_SAMPLES "100"
+#define MIN_TTL_SAMPLES 1
+#define MAX_TTL_SAMPLES 1000
+#define MAX_TTL_SCAN_ROUNDS 8
+#define MAX_SCAN_CURSORS 16
+#define TTL_BUCKET_NO_EXPIRE 0
+#define TTL_BUCKET_LT_1M 1
+#define TTL_BUCKET_LT_1H 2
+#define TTL_BUCKET_LT_1D 3
+#define TTL_BUCKET_GT_1D 4
+#define TTL_BUCKET_MISSING 5
+#define TTL_BUCKETS 6
+
+// Multi-key reads (keys or fields separated by '|')
+#define MGET_SEPARATOR '|'
+#define MAX_MGET_KEYS 256
+
+// Hash snapshots (HGETALL up to maxfields, HSCAN beyond)
+#define DEFAULT_HASH_JSON_FIELDS "1000"
+#define MIN_HASH_JSON_FIELDS 1
+#define MAX_HASH_JSON_FIELDS 100000
+#define HASH_JSON_SCAN_COUNT 1000
+
+// Client table (CLIENT LIST parsed once per interval and sorted by addr)
+#define MAX_CLIENT_TABLES 4
+#define DEFAULT_CLIENT_DISCOVERY_ROWS "1000"
+#define MIN_CLIENT_DISCOVERY_ROWS 1
+#define MAX_CLIENT_DISCOVERY_ROWS 100000
+#define MIN_CLIENT_AGE 0
+#define MAX_CLIENT_AGE 2147483647
+#define MIN_CLIENT_IDLE 0
+#define MAX_CLIENT_IDLE 2147483647
+
+// Client aggregates (CLIENT LIST streamed off the socket and summed per group, so clients are not held)
+#define MAX_CLIENT_GROUPS 256
+#define MAX_CLIENT_GROUP 64
+#define CLIENT_STREAM_CHUNK 16384
+#define MAX_CLIENT_STREAM_LINE 1048576
+
+// Pub/Sub channels (PUBSUB CHANNELS pattern, defaults to every channel)
+#define DEFAULT_PUBSUB_PATTERN "*"
+
+// Replication state (INFO REPLICATION parsed once per interval, rates from the offsets sampled by the previous parse,
+// the least recently used target is replaced)
+#define MAX_REPLICATION_TARGETS 64
+#define MAX_REPLICATION_SLAVES 32
+
+// Keyspace event listeners (PSUBSCRIBE per target, counters per key prefix)
+#define EVENT_TARGETS_ENV "LIBZBXREDIS_EVENTS"
+#define EVENT_PASSWORD_ENV "LIBZBXREDIS_EVENTS_PASSWORD"
+#define MAX_EVENT_TARGETS 8
+#define MAX_EVENT_PREFIXES 256
+#define MAX_EVENT_PREFIX 64
+#define EVENT_PREFIX_DELIMITER ':'
+#define EVENT_RATE_INTERVAL 10
+#define EVENT_RECONNECT_INTERVAL 30
+#define EVENT_EXPIRED 0
+#define EVENT_EVICTED 1
+#define EVENT_SET 2
+#define EVENT_TYPES 3
+
+// Sentinel targets (sentinel://host:port/mastername)
+#define REDIS_SENTINEL_PREFIX "sentinel://"
+#define MAX_SENTINEL_TARGETS 32
+
+// Circuit breaker (a target that could not be reached BREAKER_FAILURES times in a row fails fast for a backoff in
+// seconds, doubled up to MAX_BREAKER_BACKOFF while the probe let through after it keeps failing, failures before the
+// backoff has expired do not double it)
+#define MAX_BREAKER_TARGETS 64
+#define BREAKER_FAILURES 3
+#define BREAKER_BACKOFF 10
+#define MAX_BREAKER_BACKOFF 300
+
+// Host resolution cache (a host name is resolved once per RESOLVE_TTL seconds by one agent process while the others
+// keep the last addresses for up to RESOLVE_RETRY seconds, while the resolver fails the last addresses are kept and
+// retried every RESOLVE_RETRY seconds, a connection error moves every process on to the next address)
+#define MAX_RESOLVE_HOSTS 64
+#define MAX_RESOLVE_ADDRESSES 8
+#define RESOLVE_TTL 60
+#define RESOLVE_RETRY 10
 
 // Min & Max values
 #define MIN_REDIS_PORT 1
@@ -64,13 +210,6 @@
 #define MIN_REDIS_TIMEOUT 1
 #define MAX_REDIS_TIMEOUT 30
 
-// Regular expressions
-#define REGEX_MATCH_INFO_MULTI_VALUE "^.*=.*$"
-#define REGEX_MATCH_INFO_SINGLE_VALUE "^[^:]+:[^=]+$"
-#define REGEX_MATCH_INFO "^([^:]*):(.*)$" 
-#define REGEX_MATCH_INFO_SLAVE "^slave([0-9]+):(.*)$" 
-#define REGEX_MATCH_INFO_DATABASE "^db([0-9]+):(.*)$" 
-
 // Parameter validation
 #define NO_DEFAULT ""
 #define NO_MIN -1
@@ -78,39 +217,325 @@
 #define ALLOW_NULL_TRUE 1
 #define ALLOW_NULL_FALSE 0
 
-// Define compiled regular expressions
-extern regex_t regexCompiled_INFO;
-extern regex_t regexCompiled_INFO_MULTI_VALUE;
-extern regex_t regexCompiled_INFO_SINGLE_VALUE;
-extern regex_t regexCompiled_INFO_SLAVE;
-extern regex_t regexCompiled_INFO_DATABASE;
+// Define module statistics (shared by every agent process, times in microseconds)
+typedef struct {
+	unsigned long long  calls, errors, time;
+	unsigned long long  latency[STATS_LATENCY_BUCKETS];
+} redis_stats_key_t;
+
+typedef struct {
+	unsigned long long  sessions, session_errors, session_time;
+	unsigned long long  commands, replies, bytes_read, bytes_written, io_time;
+	unsigned long long  cache_hits, cache_misses;
+	unsigned long long  breaker_opens, breaker_rejects;
+	unsigned long long  resolves, resolve_errors, resolve_time;
+	redis_stats_key_t   keys[MAX_STATS_KEYS];
+} redis_stats_t;
+
+// Define request arena block (the first block of a thread is kept between requests, larger requests chain more)
+typedef struct redis_arena_block {
+	struct redis_arena_block  *next;
+	size_t                     size, used;
+} redis_arena_block_t;
+
+// Define circuit breaker (one entry per failing server and port, shared by every agent process)
+typedef struct {
+	char                target[MAX_LENGTH_STRING];
+	int                 failures, backoff;
+	time_t              open_until, probe_until;
+	char                error[MAX_LENGTH_STRING];
+} redis_breaker_t;
+
+typedef struct {
+	pthread_mutex_t     lock;
+	int                 next;
+	redis_breaker_t     targets[MAX_BREAKER_TARGETS];
+} redis_breakers_t;
+
+// Define host resolution cache (one entry per host name, shared by every agent process)
+typedef struct {
+	char                host[MAX_LENGTH_STRING];
+	char                addresses[MAX_RESOLVE_ADDRESSES][INET6_ADDRSTRLEN];
+	int                 address_count, current;
+	time_t              expires, refreshing_until;
+} redis_resolve_t;
+
+typedef struct {
+	pthread_mutex_t     lock;
+	int                 next;
+	redis_resolve_t     hosts[MAX_RESOLVE_HOSTS];
+} redis_resolves_t;
+
+// Define named target
+typedef struct {
+	char                name[MAX_LENGTH_PARAM];
+	char                server[MAX_LENGTH_STRING];
+	char                port[MAX_LENGTH_PARAM];
+	char                timeout[MAX_LENGTH_PARAM];
+	char                password[MAX_LENGTH_PARAM];
+	int                 cache_ttl;
+	int                 events;
+} redis_target_t;
+
+// Define big key sampler state (one entry per server, port and database)
+typedef struct {
+	char                key[MAX_BIGKEYS_NAME];
+	char                type[16];
+	unsigned long long  bytes;
+	unsigned int        hash;
+} redis_bigkey_t;
+
+typedef struct {
+	char                prefix[MAX_BIGKEYS_NAME];
+	unsigned long long  keys;
+	unsigned long long  bytes;
+} redis_bigkeys_prefix_t;
+
+typedef struct {
+	char                    target[MAX_LENGTH_STRING];
+	char                    cursor[MAX_LENGTH_CURSOR];
+	redis_bigkey_t          heap[MAX_BIGKEYS_TOPK];
+	int                     heap_count;
+	redis_bigkeys_prefix_t  reservoir[BIGKEYS_RESERVOIR_SIZE];
+	unsigned long long      keys, bytes;
+	time_t                  started;
+	redis_bigkey_t          top[MAX_BIGKEYS_TOPK];
+	int                     top_count;
+	redis_bigkeys_prefix_t  prefixes[BIGKEYS_RESERVOIR_SIZE];
+	int                     prefix_count;
+	unsigned long long      published_keys, published_bytes, cycles, steps;
+	time_t                  published, published_duration;
+} redis_bigkeys_t;
+
+typedef struct {
+	pthread_mutex_t         lock;
+	int                     next;
+	redis_bigkeys_t         targets[MAX_BIGKEYS_TARGETS];
+} redis_bigkeys_table_t;
+
+// Define SCAN cursor of an incremental sampler (one entry per server, port, database and pattern)
+typedef struct {
+	char                    target[MAX_LENGTH_KEY];
+	char                    cursor[MAX_LENGTH_CURSOR];
+	unsigned long long      steps;
+} redis_scan_cursor_t;
+
+typedef struct {
+	pthread_mutex_t         lock;
+	int                     next;
+	redis_scan_cursor_t     targets[MAX_SCAN_CURSORS];
+} redis_scan_cursors_t;
+
+// Define client table (fields of a client are held as consecutive "field=value" strings)
+typedef struct {
+	char               *fields;
+	int                 field_count;
+	char               *addr, *name, *flags, *cmd;
+	unsigned long long  age, idle, omem, qbuf, totmem;
+	int                 subscriptions;
+} redis_client_t;
+
+typedef struct {
+	char                target[MAX_LENGTH_STRING];
+	time_t              expires;
+	char               *text;
+	redis_client_t     *clients;
+	int                 client_count;
+} redis_clients_t;
+
+// Define client aggregates (summed per group while CLIENT LIST streams in, clients of this module are not counted)
+typedef struct {
+	char                group[MAX_CLIENT_GROUP];
+	int                 used;
+	unsigned long long  count, omem, qbuf, totmem, idle_max, blocked, pubsub;
+} redis_client_group_t;
+
+typedef struct {
+	redis_client_group_t  groups[MAX_CLIENT_GROUPS];
+	int                   overflow;
+} redis_client_groups_t;
+
+typedef struct {
+	char                   target[MAX_LENGTH_STRING];
+	time_t                 expires;
+	redis_client_group_t   all;
+	redis_client_groups_t  names, cmds, flags;
+} redis_client_summary_t;
+
+// Define replication state (the parsed INFO REPLICATION lives for an interval, the offset samples the rates are
+// estimated from are kept for as long as the target is)
+typedef struct {
+	char                addr[MAX_LENGTH_STRING];
+	unsigned long long  offset;
+	double              rate;
+	int                 rated;
+} redis_replica_t;
+
+typedef struct {
+	char                addr[MAX_LENGTH_STRING];
+	unsigned long long  offset;
+	time_t              sampled;
+} redis_replica_sample_t;
+
+typedef struct {
+	char                    target[MAX_LENGTH_STRING];
+	time_t                  expires, used;
+	unsigned long long      master_offset;
+	double                  master_rate;
+	int                     rated;
+	redis_replica_t         slaves[MAX_REPLICATION_SLAVES];
+	int                     slave_count;
+	redis_replica_sample_t  master_sample;
+	redis_replica_sample_t  samples[MAX_REPLICATION_SLAVES];
+} redis_replication_t;
+
+typedef struct {
+	pthread_mutex_t         lock;
+	redis_replication_t     targets[MAX_REPLICATION_TARGETS];
+} redis_replications_t;
+
+// Define keyspace event counters (written by the listener of a target only, read by every agent process)
+typedef struct {
+	char                prefix[MAX_EVENT_PREFIX];
+	int                 used;
+	unsigned long long  count[EVENT_TYPES];
+	unsigned long long  last[EVENT_TYPES];
+	unsigned long long  rate[EVENT_TYPES];
+} redis_event_prefix_t;
+
+typedef struct {
+	char                  server[MAX_LENGTH_STRING];
+	char                  port[MAX_LENGTH_PARAM];
+	char                  password[MAX_LENGTH_PARAM];
+	int                   connected;
+	redis_event_prefix_t  total;
+	redis_event_prefix_t  prefixes[MAX_EVENT_PREFIXES];
+} redis_events_t;
 
 // function to determine if a string is null or empty
 #define strisnull(c) (NULL == c || '\0' == *c)
 
 // Define generic functions
-int zbx_key_gen(AGENT_REQUEST *request, char *zbx_key);
+char * zbx_key_gen(AGENT_REQUEST *request);
 int zbx_ret_fail(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, char *zbx_msg, redisReply *redisR);
 int zbx_ret_string(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, char *value, redisReply *redisR);
 int zbx_ret_string_convert(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, char *value, char *datatype, redisReply *redisR);
+int zbx_ret_text(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, char *value, redisReply *redisR);
 int zbx_ret_integer(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, unsigned long long value, redisReply *redisR);
-int zbx_ret_float(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, float value, redisReply *redisR);
+int zbx_ret_float(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, double value, redisReply *redisR);
+int zbx_ret_reply_convert(AGENT_RESULT *result, int *ret, int log_level, char *zbx_key, redisReply *value, char *datatype, redisReply *redisR);
 int libzbxredis_version(AGENT_REQUEST *request, AGENT_RESULT *result);
+int libzbxredis_stats(AGENT_REQUEST *request, AGENT_RESULT *result);
 
 // Define validation functions
 int validate_param(AGENT_RESULT *result, char *zbx_key, char *param, char *value, char *value_default, int allow_empty, int min, int max);
 int validate_param_count(AGENT_RESULT *result, char *zbx_key, int param_count, int nparam, char *condition);
+int split_param(AGENT_RESULT *result, char *zbx_key, char *param, char *value, char separator, const char **argv, int max);
+
+// Define request arena functions
+void * redis_arena_alloc(size_t size);
+char * redis_arena_slice(const char *text, size_t length);
+char * redis_arena_strdup(const char *text);
+char * redis_arena_string(size_t length);
+char * redis_arena_printf(const char *format, ...);
+void redis_arena_reset();
+void redis_arena_free();
 
 // Define redis functions
+unsigned int redis_hash(const char *value, size_t length);
+int redis_names_add(char **names, size_t slots, const char *name, size_t length);
+void redis_reply_free(redisReply *redisR);
+unsigned long long redis_stats_clock();
+void redis_stats_context(redisContext *redisC);
+void * redis_command_send(redisContext *redisC, const char *format, ...);
+void * redis_command_send_argv(redisContext *redisC, int argc, const char **argv, const size_t *argvlen);
+int redis_command_append(redisContext *redisC, const char *format, ...);
+int redis_command_append_argv(redisContext *redisC, int argc, const char **argv, const size_t *argvlen);
+int redis_stats_start();
+void redis_stats_free();
+
+int redis_targets_load();
+redis_target_t * redis_target_find(char *name);
+int redis_target_resolve(AGENT_RESULT *result, char *zbx_key, char **redis_server, char **redis_port, char **redis_timeout, char **redis_password, int *cache_ttl);
+int redis_breakers_start();
+void redis_breakers_free();
+int redis_resolves_start();
+void redis_resolves_free();
+int redis_resolve(char *redis_host, char *redis_address, unsigned long long *resolve_time, char **zbx_msg);
+int redis_resolve_next(char *redis_host, char *redis_address);
+void redis_resolve_invalidate(char *redis_host);
 redisContext * redis_session(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password);
+redisContext * redis_session_probe(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password);
 int redis_command(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, redisReply **redisRptr, char *command, char *param, int redisReplyType);
-int redis_command_is_supported(redisContext *redisC, char *command, char *zbx_key, char *zbx_msg);
-int redis_reply_valid(int reply_received, int reply_expected, char *command, char *zbx_key, char *zbx_msg);
+int redis_command_is_supported(redisContext *redisC, char *command, char *zbx_key, char **zbx_msg);
+int redis_reply_valid(int reply_received, int reply_expected, char *command, char *zbx_key, char **zbx_msg);
+redisReply * redis_reply_map_value(redisReply *redisR, char *field);
+char * redis_scan(char *data, char *end, int delimiters);
+char * redis_scan_line(char **cursor, char *end, char **line_end);
+int redis_info_split(char *line, char *line_end, const char *prefix, char **redis_field, char **redis_data);
+int redis_info_value(char *redis_info, char *redis_search, char *redis_value);
 int redis_get_value(char *redis_field, char *redis_data, char *redis_search, char *redis_value);
 int redis_select_database(AGENT_RESULT *result, int *ret, char *zbx_key, redisContext **redisCptr, char *database);
 int redis_key_check_exists(AGENT_RESULT *result, int *ret, char *zbx_key, redisContext **redisCptr, char *key);
 int redis_key_check_type(AGENT_RESULT *result, int *ret, char *zbx_key, redisContext **redisCptr, char *key, char *type);
 int redis_hash_field_check_exists(AGENT_RESULT *result, int *ret, char *zbx_key, redisContext **redisCptr, char *hash, char *field);
+int redis_key_typed_command(AGENT_RESULT *result, int *ret, char *zbx_key, redisContext *redisC, redisReply **redisRptr, char *key, char *type, int argc, const char **argv, int redisReplyType);
+int redis_reply_pending(redisContext *redisC, int timeout_ms, redisReply **redisRptr);
+redisReply * redis_reply_path_value(redisReply *redisR, char *path);
+redisReply * redis_reply_find(redisReply *redisR, char *field, char *value);
+
+// Define redis cache functions
+redisReply * redis_cache_get(char *redis_server, char *redis_port, char *command);
+void redis_cache_set(char *redis_server, char *redis_port, char *command, redisReply *redisR, int ttl);
+void redis_cache_set_children(char *redis_server, char *redis_port, char *command, redisReply *redisR, redisReply **children, size_t child_count, int ttl);
+redisReply * redis_cache_child(char *redis_server, char *redis_port, char *command, size_t index);
+int redis_cache_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, char **commands, int command_count, int command_index, int redisReplyType, redisReply **redisRptr);
+void redis_cache_free();
+int redis_stream_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, char *database, char *stream, redisReply **redisRptr);
+redisReply * redis_stream_consumers(char *redis_server, char *redis_port, char *database, char *stream, char *group);
+int redis_pubsub_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, char *pattern, redisReply **channelsptr, redisReply **numsubptr);
+long long redis_pubsub_subscribers(redisReply *redisNumsub, char *channel);
+
+// Define redis big key sampler functions
+int redis_bigkeys_start();
+redis_bigkeys_t * redis_bigkeys_get(char *redis_server, char *redis_port, char *database);
+void redis_bigkeys_put(redis_bigkeys_t *bigkeys);
+int redis_bigkeys_step(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, redis_bigkeys_t *bigkeys, int count, int samples, int topk);
+void redis_bigkeys_json(redis_bigkeys_t *bigkeys, int topk, struct zbx_json *j);
+void redis_bigkeys_free();
+
+// Define redis TTL sampler functions
+int redis_scan_cursors_start();
+redis_scan_cursor_t * redis_scan_cursor_get(char *redis_server, char *redis_port, char *database, char *pattern);
+void redis_scan_cursor_put(redis_scan_cursor_t *scan);
+void redis_scan_cursors_free();
+int redis_ttl_sample(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, char *cursor, char *pattern, int samples, unsigned long long *buckets);
+
+// Define redis client table functions
+void redis_client_parse(redis_client_t *client, char *line, char *line_end);
+void redis_clients_parse(redis_clients_t *clients, char *text);
+void redis_clients_clear(redis_clients_t *clients);
+int redis_clients_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, redis_clients_t **clientsptr);
+redis_client_t * redis_clients_find(redis_clients_t *clients, char *addr);
+char * redis_client_field(redis_client_t *client, char *field);
+int redis_clients_stream(AGENT_RESULT *result, char *zbx_key, redisContext *redisC, char *redis_timeout, redis_client_summary_t *summary);
+void redis_clients_summarise(redis_client_summary_t *summary, redis_client_t *client);
+int redis_clients_summary_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, redis_client_summary_t **summaryptr);
+redis_client_group_t * redis_clients_summary_group(redis_client_summary_t *summary, char *groupby, char *group);
+void redis_clients_free();
+int redis_replications_start();
+int redis_replication_fetch(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *redis_timeout, char *redis_password, int cache_ttl, redis_replication_t **replicationptr);
+redis_replica_t * redis_replication_slave(redis_replication_t *replication, char *addr);
+void redis_replications_free();
+int redis_events_type(char *event);
+int redis_events_start();
+int redis_events_get(AGENT_RESULT *result, char *zbx_key, char *redis_server, char *redis_port, char *prefix, redis_event_prefix_t **slotptr);
+void redis_events_free();
+
+// Define redis sentinel functions
+int redis_sentinel_master(char *redis_server, struct timeval timeout, char *master_host, char *master_port, char **zbx_msg);
+void redis_sentinel_invalidate(char *redis_server);
+void redis_sentinel_free();
 
 // Define redis key functions
 int redis_session_status(AGENT_REQUEST *request, AGENT_RESULT *result);
@@ -129,8 +554,14 @@ int redis_role(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_keyspace_hit_ratio(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_slowlog_length(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_config(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_memory_stats(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_memory_doctor(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_keys_bigkeys(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_keys_ttl_histogram(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_client_discovery(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_client_info(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_client_group_discovery(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_client_aggregate(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_key_exists(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_key_ttl(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_key_pttl(AGENT_REQUEST *request, AGENT_RESULT *result);
@@ -147,5 +578,23 @@ int redis_key_hash_field_length(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_key_list_exists(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_key_list_get(AGENT_REQUEST *request, AGENT_RESULT *result);
 int redis_key_list_length(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_key_set_count(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_key_zset_count(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_key_zset_range_count(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_key_stream_length(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_key_mget(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_key_hash_mget(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_key_hash_json(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_stream_group_discovery(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_stream_group_info(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_stream_consumer_discovery(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_stream_consumer_info(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_pubsub_channel_discovery(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_pubsub_channel_subscribers(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_pubsub_channel_count(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_pubsub_patterns(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_replication_lag(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_events_rate(AGENT_REQUEST *request, AGENT_RESULT *result);
+int redis_events_count(AGENT_REQUEST *request, AGENT_RESULT *result);
 
 #endif
@@ -51,18 +51,17 @@ int redis_session_status(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_session_status";
 	const char     *__key_name      = "redis.session.status[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	redisContext   *redisC;
-	redisReply     *redisR;
 	struct timeval  timeout;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -73,21 +72,24 @@ int redis_session_status(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {
+	// Create the redis session (past an open circuit breaker, the real state of the server is reported)
+	if ((redisC = redis_session_probe(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {
 
 		// Set return
-		zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);
+		zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, NULL);
 
 	} else {
 
 		// Set return
-		zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);
+		zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, NULL);
 
 		// Free the context
 		redisFree(redisC);
@@ -122,11 +124,10 @@ int redis_session_duration(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_session_duration";
 	const char     *__key_name      = "redis.session.duration[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	redisContext   *redisC;
-	redisReply     *redisR;
 	struct timeval  timeout, clock_start, clock_finish;
 	float           clock_duration;
 
@@ -134,7 +135,7 @@ int redis_session_duration(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -145,6 +146,9 @@ int redis_session_duration(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -166,7 +170,7 @@ int redis_session_duration(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (clock_duration < 0) {clock_duration=0;}
 
 	// Set return
-	zbx_ret_float(result, &ret, LOG_LEVEL_DEBUG, zbx_key, clock_duration, redisR);
+	zbx_ret_float(result, &ret, LOG_LEVEL_DEBUG, zbx_key, clock_duration, NULL);
 
 out:
 
@@ -200,18 +204,18 @@ int redis_command_supported(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_command_supported";
 	const char     *__key_name      = "redis.command.supported[server,port,timeout,password,command]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 5;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_command;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -223,6 +227,9 @@ int redis_command_supported(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_password = get_rparam(request,3);
 	param_command  = get_rparam(request,4);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -281,11 +288,11 @@ int redis_command_duration(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_command_duration";
 	const char     *__key_name      = "redis.command.duration[server,port,timeout,password,command,params]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 6;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_command, *param_params;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout, clock_start, clock_finish;
 	float           clock_duration;
 
@@ -293,7 +300,7 @@ int redis_command_duration(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -306,6 +313,9 @@ int redis_command_duration(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_command  = get_rparam(request,4);
 	param_params   = get_rparam(request,5);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -369,20 +379,19 @@ int redis_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_info";
 	const char     *__key_name      = "redis.info[server,port,timeout,password,datatype,section,key,default]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 8;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_datatype, *param_section, *param_key, *param_default;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
-	char           *line;
-	regmatch_t      regexGroups[3];
+	char           *redis_value;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -397,6 +406,9 @@ int redis_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_key      = get_rparam(request,6);
 	param_default  = get_rparam(request,7);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -412,36 +424,16 @@ int redis_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	// Run redis command
 	if (redis_command(result, zbx_key, redisC, &redisR, "INFO", param_section, REDIS_REPLY_STRING)) {goto out;}
 
-	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
-
-	// Process every line of output
-	while (line != NULL) {
-
-		// Declare Variables
-		char redis_field[MAX_LENGTH_KEY]="", redis_data[MAX_LENGTH_KEY]="", redis_value[MAX_LENGTH_KEY]="";
-
-		// If the line is matched
-		if (regexec(&regexCompiled_INFO,line,3,regexGroups,0) == 0) {
-
-			// Copy the fields
-			zbx_strlcpy(redis_field,line + regexGroups[1].rm_so,regexGroups[1].rm_eo - regexGroups[1].rm_so + 1);
-			zbx_strlcpy(redis_data,line + regexGroups[2].rm_so,regexGroups[2].rm_eo - regexGroups[2].rm_so + 1);
-
-			// If the line contains the key field
-			if (redis_get_value(redis_field, redis_data, param_key, redis_value) == 0) {
-
-				// Set return
-				zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redis_value, param_datatype, redisR);
-
-				goto out;
+	// Take room for the value (no longer than the reply) from the request arena
+	redis_value = redis_arena_string(redisR->len);
 
-			}
+	// If the info contains the key field
+	if (redis_info_value(redisR->str, param_key, redis_value) == 0) {
 
-		}
+		// Set return
+		zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redis_value, param_datatype, redisR);
 
-		// Get next line of output
-		line = strtok(NULL,"\n\r");
+		goto out;
 
 	}
 
@@ -492,22 +484,21 @@ int redis_database_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_database_discovery";
 	const char     *__key_name      = "redis.database.discovery[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	struct          zbx_json j;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	int             discovered_instances = 0;
-	char           *line;
-	regmatch_t      regexGroups[3];
+	char           *line, *cursor, *line_end;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -518,6 +509,9 @@ int redis_database_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -536,21 +530,17 @@ int redis_database_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
 
 	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
+	cursor = redisR->str;
+	line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	// Process every line of output
 	while (line != NULL) {
 
-		// If the line is matched
-		if (regexec(&regexCompiled_INFO_DATABASE,line,3,regexGroups,0) == 0) {
-
-			// Declare variables
-			char redis_field[MAX_LENGTH_KEY]="", redis_data[MAX_LENGTH_KEY]="", redis_value[MAX_LENGTH_KEY]="";
-			char redis_database[MAX_LENGTH_KEY]="";
+		// Declare variables
+		char *redis_field, *redis_data;
 
-			// Copy the fields
-			zbx_strlcpy(redis_field,line + regexGroups[1].rm_so,regexGroups[1].rm_eo - regexGroups[1].rm_so + 1);
-			zbx_strlcpy(redis_data,line + regexGroups[2].rm_so,regexGroups[2].rm_eo - regexGroups[2].rm_so + 1);
+		// If the line is matched
+		if (redis_info_split(line, line_end, "db", &redis_field, &redis_data) == 0) {
 
 			// Open instance in JSON
 			zbx_json_addobject(&j, NULL);
@@ -566,7 +556,7 @@ int redis_database_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 		}
 
 		// Get next line of output
-		line = strtok(NULL,"\n\r");
+		line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	}
 
@@ -586,7 +576,7 @@ int redis_database_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zbx_json_free(&j);
 
 	// Free the reply
-	freeReplyObject(redisR);
+	redis_reply_free(redisR);
 
 out:
 
@@ -623,20 +613,19 @@ int redis_database_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_database_info";
 	const char     *__key_name      = "redis.database.info[server,port,timeout,password,datatype,database,key,default]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 8;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_datatype, *param_database, *param_key, *param_default;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
-	char           *line;
-	regmatch_t      regexGroups[3];
+	char           *line, *cursor, *line_end;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -651,6 +640,9 @@ int redis_database_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_key      = get_rparam(request,6);
 	param_default  = get_rparam(request,7);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -667,20 +659,20 @@ int redis_database_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (redis_command(result, zbx_key, redisC, &redisR, "INFO KEYSPACE", NULL, REDIS_REPLY_STRING)) {goto out;}
 
 	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
+	cursor = redisR->str;
+	line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	// Process every line of output
 	while (line != NULL) {
 
-		// If the line is matched
-		if (regexec(&regexCompiled_INFO_DATABASE,line,3,regexGroups,0) == 0) {
+		// Declare variables
+		char *redis_field, *redis_data, *redis_value;
 
-			// Declare variables
-			char redis_field[MAX_LENGTH_KEY]="", redis_data[MAX_LENGTH_KEY]="", redis_value[MAX_LENGTH_KEY]="";
+		// If the line is matched
+		if (redis_info_split(line, line_end, "db", &redis_field, &redis_data) == 0) {
 
-			// Copy the fields
-			zbx_strlcpy(redis_field,line + regexGroups[1].rm_so,regexGroups[1].rm_eo - regexGroups[1].rm_so + 1);
-			zbx_strlcpy(redis_data,line + regexGroups[2].rm_so,regexGroups[2].rm_eo - regexGroups[2].rm_so + 1);
+			// Take room for the values from the request arena
+			redis_value = redis_arena_string(strlen(redis_data));
 
 			// If the database matches the requested database
 			if (strcmp(param_database,redis_field) == 0) {
@@ -718,7 +710,7 @@ int redis_database_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 		}
 
 		// Get next line of output
-		line = strtok(NULL,"\n\r");
+		line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	}
 
@@ -756,22 +748,21 @@ int redis_slave_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_slave_discovery";
 	const char     *__key_name      = "redis.slave.discovery[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	struct          zbx_json j;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	int             discovered_instances = 0;
-	char           *line;
-	regmatch_t      regexGroups[3];
+	char           *line, *cursor, *line_end;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -782,6 +773,9 @@ int redis_slave_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -800,30 +794,29 @@ int redis_slave_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
 
 	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
+	cursor = redisR->str;
+	line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	// Process every line of output
 	while (line != NULL) {
 
-		// If the line is matched
-		if (regexec(&regexCompiled_INFO_SLAVE,line,3,regexGroups,0) == 0) {
+		// Declare variables
+		char *redis_field, *redis_data;
+		char *redis_slave, *redis_slave_ip, *redis_slave_port;
 
-			// Declare variables
-			char redis_field[MAX_LENGTH_KEY]="", redis_data[MAX_LENGTH_KEY]="";
-			char redis_slave[MAX_LENGTH_KEY]="", redis_slave_ip[MAX_LENGTH_KEY]="", redis_slave_port[MAX_LENGTH_KEY]="";
+		// If the line is matched
+		if (redis_info_split(line, line_end, "slave", &redis_field, &redis_data) == 0) {
 
-			// Copy the fields
-			zbx_strlcpy(redis_field,line + regexGroups[1].rm_so,regexGroups[1].rm_eo - regexGroups[1].rm_so + 1);
-			zbx_strlcpy(redis_data,line + regexGroups[2].rm_so,regexGroups[2].rm_eo - regexGroups[2].rm_so + 1);
+			// Take room for the values from the request arena
+			redis_slave_ip   = redis_arena_string(strlen(redis_data));
+			redis_slave_port = redis_arena_string(strlen(redis_data));
 
 			// Get the values
 			redis_get_value(redis_field, redis_data, "ip", redis_slave_ip);
 			redis_get_value(redis_field, redis_data, "port", redis_slave_port);
 
 			// Form the slave
-			strcat(redis_slave,redis_slave_ip);
-			strcat(redis_slave,":");
-			strcat(redis_slave,redis_slave_port);
+			redis_slave = redis_arena_printf("%s:%s",redis_slave_ip,redis_slave_port);
 
 			// Open instance in JSON
 			zbx_json_addobject(&j, NULL);
@@ -839,7 +832,7 @@ int redis_slave_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 		}
 
 		// Get next line of output
-		line = strtok(NULL,"\n\r");
+		line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	}
 
@@ -859,7 +852,7 @@ int redis_slave_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zbx_json_free(&j);
 
 	// Free the reply
-	freeReplyObject(redisR);
+	redis_reply_free(redisR);
 
 out:
 
@@ -896,20 +889,19 @@ int redis_slave_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_slave_info";
 	const char     *__key_name      = "redis.slave.info[server,port,timeout,password,datatype,slave,key,default]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 8;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_datatype, *param_slave, *param_key, *param_default;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
-	char           *line;
-	regmatch_t      regexGroups[3];
+	char           *line, *cursor, *line_end;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -924,6 +916,9 @@ int redis_slave_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_key      = get_rparam(request,6);
 	param_default  = get_rparam(request,7);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -940,30 +935,30 @@ int redis_slave_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (redis_command(result, zbx_key, redisC, &redisR, "INFO REPLICATION", NULL, REDIS_REPLY_STRING)) {goto out;}
 
 	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
+	cursor = redisR->str;
+	line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	// Process every line of output
 	while (line != NULL) {
 
 		// Declare  Variables
-		char redis_field[MAX_LENGTH_KEY]="", redis_data[MAX_LENGTH_KEY]="", redis_value[MAX_LENGTH_KEY]="";
-		char redis_slave[MAX_LENGTH_KEY]="", redis_slave_ip[MAX_LENGTH_KEY]="", redis_slave_port[MAX_LENGTH_KEY]="";
+		char *redis_field, *redis_data, *redis_value;
+		char *redis_slave, *redis_slave_ip, *redis_slave_port;
 
 		// If the line is matched
-		if (regexec(&regexCompiled_INFO_SLAVE,line,3,regexGroups,0) == 0) {
+		if (redis_info_split(line, line_end, "slave", &redis_field, &redis_data) == 0) {
 
-			// Copy the fields
-			zbx_strlcpy(redis_field,line + regexGroups[1].rm_so,regexGroups[1].rm_eo - regexGroups[1].rm_so + 1);
-			zbx_strlcpy(redis_data,line + regexGroups[2].rm_so,regexGroups[2].rm_eo - regexGroups[2].rm_so + 1);
+			// Take room for the values from the request arena
+			redis_value      = redis_arena_string(strlen(redis_data));
+			redis_slave_ip   = redis_arena_string(strlen(redis_data));
+			redis_slave_port = redis_arena_string(strlen(redis_data));
 
 			// Get the values
 			redis_get_value(redis_field, redis_data, "ip", redis_slave_ip);
 			redis_get_value(redis_field, redis_data, "port", redis_slave_port);
 
 			// Form the slave
-			strcat(redis_slave,redis_slave_ip);
-			strcat(redis_slave,":");
-			strcat(redis_slave,redis_slave_port);
+			redis_slave = redis_arena_printf("%s:%s",redis_slave_ip,redis_slave_port);
 
 			// If the slave matches the requested slave
 			if (strcmp(param_slave,redis_slave) == 0) {
@@ -1001,7 +996,7 @@ int redis_slave_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 		}
 
 		// Get next line of output
-		line = strtok(NULL,"\n\r");
+		line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	}
 
@@ -1039,17 +1034,17 @@ int redis_ping(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_ping";
 	const char     *__key_name      = "redis.ping[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1060,6 +1055,9 @@ int redis_ping(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -1105,18 +1103,18 @@ int redis_time(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_time";
 	const char     *__key_name      = "redis.time[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1127,6 +1125,9 @@ int redis_time(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -1172,18 +1173,18 @@ int redis_lastsave(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_lastsave";
 	const char     *__key_name      = "redis.lastsave[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1194,6 +1195,9 @@ int redis_lastsave(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -1239,18 +1243,18 @@ int redis_role(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_role";
 	const char     *__key_name      = "redis.role[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1261,6 +1265,9 @@ int redis_role(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -1306,22 +1313,21 @@ int redis_keyspace_hit_ratio(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char        *__function_name = "redis_keyspace_hit_ratio";
 	const char        *__key_name      = "redis.keyspace.hit.ratio[server,port,timeout,password]";
 	int                ret = SYSINFO_RET_FAIL;
-	char               zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char              *zbx_key;
 	int                param_count = 4;
 	char              *param_server, *param_port, *param_timeout, *param_password;
 	redisContext      *redisC;
-	redisReply        *redisR;
+	redisReply        *redisR = NULL;
 	struct timeval     timeout;
-	char              *line;
+	char              *line, *cursor, *line_end;
 	unsigned long long keyspace_hits = 0, keyspace_misses = 0, keyspace_total = 0;
 	float              keyspace_hitrate = 0;
-	regmatch_t         regexGroups[3];
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1332,6 +1338,9 @@ int redis_keyspace_hit_ratio(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -1344,20 +1353,20 @@ int redis_keyspace_hit_ratio(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (redis_command(result, zbx_key, redisC, &redisR, "INFO", "stats", REDIS_REPLY_STRING)) {goto out;}
 
 	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
+	cursor = redisR->str;
+	line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	// Process every line of output
 	while (line != NULL) {
 
 		// Declare Variables
-		char redis_field[MAX_LENGTH_KEY]="", redis_data[MAX_LENGTH_KEY]="", redis_value[MAX_LENGTH_KEY]="";
+		char *redis_field, *redis_data, *redis_value;
 
 		// If the line is matched
-		if (regexec(&regexCompiled_INFO,line,3,regexGroups,0) == 0) {
+		if (redis_info_split(line, line_end, NULL, &redis_field, &redis_data) == 0) {
 
-			// Copy the fields
-			zbx_strlcpy(redis_field,line + regexGroups[1].rm_so,regexGroups[1].rm_eo - regexGroups[1].rm_so + 1);
-			zbx_strlcpy(redis_data,line + regexGroups[2].rm_so,regexGroups[2].rm_eo - regexGroups[2].rm_so + 1);
+			// Take room for the values from the request arena
+			redis_value = redis_arena_string(strlen(redis_data));
 
 			// If the line contains the keyspace_hits
 			if (redis_get_value(redis_field, redis_data, "keyspace_hits", redis_value) == 0) {keyspace_hits = atoll(redis_value);}
@@ -1368,7 +1377,7 @@ int redis_keyspace_hit_ratio(AGENT_REQUEST *request,AGENT_RESULT *result)
 		}
 
 		// Get next line of output
-		line = strtok(NULL,"\n\r");
+		line = redis_scan_line(&cursor, redisR->str + redisR->len, &line_end);
 
 	}
 
@@ -1416,18 +1425,18 @@ int redis_slowlog_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_slowlog_length";
 	const char     *__key_name      = "redis.slowlog.length[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 4;
 	char           *param_server, *param_port, *param_timeout, *param_password;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1438,6 +1447,9 @@ int redis_slowlog_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -1486,11 +1498,11 @@ int redis_config(AGENT_REQUEST *request,AGENT_RESULT *result)
 	const char     *__function_name = "redis_config";
 	const char     *__key_name      = "redis.config[server,port,timeout,password,datatype,key,default]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 7;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_datatype, *param_key, *param_default;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	char            redisCmd[MAX_LENGTH_KEY];
 	struct timeval  timeout;
 
@@ -1498,7 +1510,7 @@ int redis_config(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;;}
@@ -1512,6 +1524,9 @@ int redis_config(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_key      = get_rparam(request,5);
 	param_default  = get_rparam(request,6);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;;}
@@ -1549,8 +1564,8 @@ int redis_config(AGENT_REQUEST *request,AGENT_RESULT *result)
 
 	}
 
-	// Set return
-	zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->element[1]->str, param_datatype, redisR);
+	// Set return (CONFIG GET is a field/value array on RESP2 and a map on RESP3)
+	zbx_ret_reply_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->element[1], param_datatype, redisR);
 
 out:
 
@@ -1564,41 +1579,43 @@ out:
 
 }
 
-/***********************************************************************************
- *                                                                                 *
- * Custom Key            : redis.client.discovery[server,port,timeout,password]    *
- *                                                                                 *
- * Function              : Discovers redis clients                                 *
- * Parameters [server]   : Redis server address to connect                         *
- * Parameters [port]     : Redis server port to connect                            *
- * Parameters [timeout]  : Timeout in seconds                                      *
- * Parameters [password] : Redis password to connect using (blank)                 *
- * Returns               : 0 (success),1 (failure)                                 *
- *                                                                                 *
- ***********************************************************************************/
-int redis_client_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
+/**************************************************************************************
+ *                                                                                    *
+ * Custom Key            : redis.memory.stats[server,port,timeout,password,datatype,  *
+ *                                            field,default]                          *
+ *                                                                                    *
+ * Function              : Gets a redis memory stats field                            *
+ * Parameters [server]   : Redis server address to connect                            *
+ * Parameters [port]     : Redis server port to connect                               *
+ * Parameters [timeout]  : Timeout in seconds                                         *
+ * Parameters [password] : Redis password to connect using (blank)                    *
+ * Parameters [datatype] : Data type to return (integer,float,string,text)            *
+ * Parameters [field]    : Field to return (dataset.bytes,overhead.total,             *
+ *                         fragmentation,allocator.resident,db.0.overhead.hashtable.  *
+ *                         main etc...)                                               *
+ * Parameters [default]  : Value default to return if no value is detected            *
+ * Returns               : 0 (success),1 (failure)                                    *
+ *                                                                                    *
+ **************************************************************************************/
+int redis_memory_stats(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_client_discovery";
-	const char     *__key_name      = "redis.client.discovery[server,port,timeout,password]";
+	const char     *__function_name = "redis_memory_stats";
+	const char     *__key_name      = "redis.memory.stats[server,port,timeout,password,datatype,field,default]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 4;
-	char           *param_server, *param_port, *param_timeout, *param_password;
-	struct          zbx_json j;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	int             discovered_instances = 0;
-	char            redis_value[MAX_LENGTH_KEY], redis_client_name[MAX_LENGTH_KEY];
-	char           *line;
+	char           *zbx_key;
+	int             param_count = 7;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_datatype, *param_field, *param_default;
+	int             cache_ttl;
+	char           *redisCmds[] = {"MEMORY STATS", "MEMORY DOCTOR"};
+	redisReply     *redisR = NULL, *redisValue;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1608,81 +1625,52 @@ int redis_client_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
+	param_datatype = get_rparam(request,4);
+	param_field    = get_rparam(request,5);
+	param_default  = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Datatype", param_datatype, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                            {return ret;}
+	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
-
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "CLIENT LIST", NULL, REDIS_REPLY_STRING)) {goto out;}
-
-	// Initialise JSON for discovery
-	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
-
-	// Create JSON array of discovered instances
-	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
-
-	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
-
-	// Process every line of output
-	while (line != NULL) {
+	// Get the memory stats (MEMORY STATS and MEMORY DOCTOR are fetched together and cached so every field is served by one round trip)
+	if (redis_cache_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, redisCmds, 2, 0, REDIS_REPLY_ARRAY, &redisR)) {goto out;}
 
-		// Declare variables
-		char redis_value[MAX_LENGTH_KEY]="", redis_client_name[MAX_LENGTH_KEY]="";
+	// Get the field (The reply is owned by the cache so it is not freed)
+	redisValue = redis_reply_path_value(redisR, param_field);
 
-		// Try to get the client name in order to skip libzbxredis connections
-		redis_get_value("", line, "name", redis_client_name);
-		
-		// If the line contains addr and is not a libzbxredis-internal client name
-		if (redis_get_value("", line, "addr", redis_value) == 0 && strcmp(redis_client_name,MODULE) != 0) {
+	// If the field is a value
+	if (redisValue != NULL && redisValue->element == NULL) {
 
-			// Open instance in JSON
-			zbx_json_addobject(&j, NULL);
+		// Set return
+		zbx_ret_reply_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisValue, param_datatype, NULL);
 
-			zbx_json_addstring(&j, "{#CLIENT}", redis_value, ZBX_JSON_TYPE_STRING);
+		goto out;
 
-			// Close instance in JSON 
-			zbx_json_close(&j);
+	}
 
-			// Increment discovered instances
-			discovered_instances++;
+	// If the info is undetected and can be set to a default value
+	if (strlen(param_default) > 0 && param_default != NULL) {
 
-		}
+		// Set return
+		zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, param_default, param_datatype, NULL);
 
-		// Get next line of output
-		line = strtok(NULL,"\n\r");
+		goto out;
 
 	}
 
-	// Finalise JSON for discovery
-	zbx_json_close(&j);
-
-	// Log message
-	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%lld)",MODULE,zbx_key,discovered_instances);
-
-	// Set result
-	SET_STR_RESULT(result, strdup(j.buffer));
-
 	// Set return
-	ret = SYSINFO_RET_OK;
-
-	// Free the json
-	zbx_json_free(&j);
-
-	// Free the reply
-	freeReplyObject(redisR);
-
+	zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis memory statistic does not exist", NULL);
 
 out:
 
-	// Free the context
-	redisFree(redisC);
-
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
 
@@ -1690,42 +1678,37 @@ out:
 
 }
 
-/*************************************************************************************************************************
- *                                                                                                                       *
- * Custom Key            : redis.client.info[server,port,timeout,password,datatype,client,key]                           *
- *                                                                                                                       *
- * Function              : Gets the redis client field                                                                   *
- * Parameters [server]   : Redis server address to connect                                                               *
- * Parameters [port]     : Redis server port to connect                                                                  *
- * Parameters [timeout]  : Timeout in seconds                                                                            *
- * Parameters [password] : Redis password to connect using (blank)                                                       *
- * Parameters [datatype] : Data type to return (integer,float,string,text)                                               *
- * Parameters [client]   : Client to select the key for (192.168.1.1:6789, 192.168.1.2:6789, 192.168.1.3:6789 etc...)    *
- * Parameters [key]      : Key to return (ip,port,state,offset,lag etc...)                                               *
- * Parameters [default]  : Value default to return if no value is detected                                               *
- * Returns               : 0 (success),1 (failure)                                                                       *
- *                                                                                                                       *
- *************************************************************************************************************************/
-int redis_client_info(AGENT_REQUEST *request,AGENT_RESULT *result)
+/********************************************************************************
+ *                                                                              *
+ * Custom Key            : redis.memory.doctor[server,port,timeout,password]    *
+ *                                                                              *
+ * Function              : Gets the redis memory doctor report                  *
+ * Parameters [server]   : Redis server address to connect                      *
+ * Parameters [port]     : Redis server port to connect                         *
+ * Parameters [timeout]  : Timeout in seconds                                   *
+ * Parameters [password] : Redis password to connect using (blank)              *
+ * Returns               : 0 (success),1 (failure)                              *
+ *                                                                              *
+ ********************************************************************************/
+int redis_memory_doctor(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_client_info";
-	const char     *__key_name      = "redis.client.info[server,port,timeout,password,datatype,client,key,default]";
+	const char     *__function_name = "redis_memory_doctor";
+	const char     *__key_name      = "redis.memory.doctor[server,port,timeout,password]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 8;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_datatype, *param_client, *param_key, *param_default;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	char           *zbx_key;
+	int             param_count = 4;
+	char           *param_server, *param_port, *param_timeout, *param_password;
+	int             cache_ttl;
+	char           *redisCmds[] = {"MEMORY STATS", "MEMORY DOCTOR"};
+	redisReply     *redisR = NULL;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1735,85 +1718,23 @@ int redis_client_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
-	param_datatype = get_rparam(request,4);
-	param_client   = get_rparam(request,5);
-	param_key      = get_rparam(request,6);
-	param_default  = get_rparam(request,7);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Datatype", param_datatype, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Client", param_client, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                          {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
-	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
-
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
-
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "CLIENT LIST", NULL, REDIS_REPLY_STRING)) {goto out;}
-
-	// Get first line of output
-	line = strtok(redisR->str, "\n\r");
-
-	// Process every line of output
-	while (line != NULL) {
-
-		// Declare variables
-		char redis_field[MAX_LENGTH_KEY]="", redis_data[MAX_LENGTH_KEY]="", redis_value[MAX_LENGTH_KEY]="";
-		char redis_client[MAX_LENGTH_KEY]="";
-
-		// Get the values
-		redis_get_value("", line, "addr", redis_client);
-
-		// If the client matches the requested client
-		if (strcmp(param_client,redis_client) == 0) {
-
-			// If the redis value can not be found
-			if (redis_get_value("", line, param_key, redis_value) == 1 ) {
-
-				// For some values they are or are not present depending on the status of redis so this is where the default value comes into it
-				// This is used to prevent Zabbix from reporting the item as "Unsupported" where it makes sense ie master_link_down_since_seconds could be defaulted to 0
-
-				// If the info is undetected and can be set to a default value
-				if (strlen(param_default) > 0 && param_default != NULL) {
-
-					// Set return
-					zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, param_default, param_datatype, redisR);
-
-					goto out;
-
-				}
-
-				// Set return
-				zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis client information does not exist", redisR);
 
-				goto out;
-
-			}
-
-			// Set return
-			zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redis_value, param_datatype, redisR);
-
-			goto out;
-
-		}
-
-		// Get next line of output
-		line = strtok(NULL,"\n\r");
-
-	}
+	// Get the memory doctor report (Shares the cached round trip with redis.memory.stats)
+	if (redis_cache_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, redisCmds, 2, 1, REDIS_REPLY_STRING, &redisR)) {goto out;}
 
-	// Set return
-	zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis client does not exist", redisR);
+	// Set return (The reply is owned by the cache so it is not freed)
+	zbx_ret_text(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, NULL);
 
 out:
 
-	// Free the context
-	redisFree(redisC);
-
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
 
@@ -1821,41 +1742,44 @@ out:
 
 }
 
-/******************************************************************************************
- *                                                                                        *
- * Custom Key            : redis.key.exists[server,port,timeout,password,database,key]    *
- *                                                                                        *
- * Function              : Check if a redis key exists                                    *
- * Parameters [server]   : Redis server address to connect                                *
- * Parameters [port]     : Redis server port to connect                                   *
- * Parameters [timeout]  : Timeout in seconds                                             *
- * Parameters [password] : Redis password to connect using (blank)                        *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)               *
- * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                     *
- * Returns               : 0 (success),1 (failure)                                        *
- *                                                                                        *
- ******************************************************************************************/
-int redis_key_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+/*********************************************************************************************
+ *                                                                                           *
+ * Custom Key            : redis.keys.bigkeys[server,port,timeout,password,database,count,   *
+ *                                            samples,topk]                                  *
+ *                                                                                           *
+ * Function              : Samples the biggest keys and the memory used per key prefix       *
+ *                         (each poll scans the next batch of keys so a full scan is spread  *
+ *                         over many polls, results are from the last complete scan)         *
+ * Parameters [server]   : Redis server address to connect                                   *
+ * Parameters [port]     : Redis server port to connect                                      *
+ * Parameters [timeout]  : Timeout in seconds                                                *
+ * Parameters [password] : Redis password to connect using (blank)                           *
+ * Parameters [database] : Redis database to scan                                            *
+ * Parameters [count]    : Keys to scan per poll (100)                                       *
+ * Parameters [samples]  : MEMORY USAGE samples per key (5)                                  *
+ * Parameters [topk]     : Big keys and prefixes to return (10)                              *
+ * Returns               : 0 (success),1 (failure)                                           *
+ *                                                                                           *
+ *********************************************************************************************/
+int redis_keys_bigkeys(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_exists";
-	const char     *__key_name      = "redis.key.exists[server,port,timeout,password,database,key]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
-	char           *param_key;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char      *__function_name = "redis_keys_bigkeys";
+	const char      *__key_name      = "redis.keys.bigkeys[server,port,timeout,password,database,count,samples,topk]";
+	int              ret = SYSINFO_RET_FAIL;
+	char            *zbx_key;
+	int              param_count = 8;
+	char            *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_keys, *param_samples, *param_topk;
+	struct           zbx_json j;
+	redisContext    *redisC;
+	redis_bigkeys_t *bigkeys;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1866,14 +1790,21 @@ int redis_key_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
+	param_keys     = get_rparam(request,5);
+	param_samples  = get_rparam(request,6);
+	param_topk     = get_rparam(request,7);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
 	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Count", param_keys, DEFAULT_BIGKEYS_COUNT, ALLOW_NULL_FALSE, MIN_BIGKEYS_COUNT, MAX_BIGKEYS_COUNT))           {return ret;}
+	if (validate_param(result, zbx_key, "Samples", param_samples, DEFAULT_BIGKEYS_SAMPLES, ALLOW_NULL_FALSE, MIN_BIGKEYS_SAMPLES, MAX_BIGKEYS_SAMPLES)) {return ret;}
+	if (validate_param(result, zbx_key, "Topk", param_topk, DEFAULT_BIGKEYS_TOPK, ALLOW_NULL_FALSE, MIN_BIGKEYS_TOPK, MAX_BIGKEYS_TOPK))                {return ret;}
 
 	// Create the redis session
 	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
@@ -1881,11 +1812,29 @@ int redis_key_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	// Select the redis database
 	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+	// Get the sampler state of the target
+	bigkeys = redis_bigkeys_get(param_server, param_port, param_database);
 
-	// If the redis key does exist
-	if (! redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+	// Scan and size the next batch of keys
+	if (redis_bigkeys_step(result, zbx_key, redisC, bigkeys, atoi(param_keys), atoi(param_samples), atoi(param_topk))) {goto out;}
+
+	// Store the sampler state of the target
+	redis_bigkeys_put(bigkeys);
+
+	// Initialise JSON
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Add the sampler results
+	redis_bigkeys_json(bigkeys, atoi(param_topk), &j);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
 
 out:
 
@@ -1899,41 +1848,47 @@ out:
 
 }
 
-/***************************************************************************************
- *                                                                                     *
- * Custom Key            : redis.key.ttl[server,port,timeout,password,database,key]    *
- *                                                                                     *
- * Function              : Get a redis keys ttl in seconds                             *
- * Parameters [server]   : Redis server address to connect                             *
- * Parameters [port]     : Redis server port to connect                                *
- * Parameters [timeout]  : Timeout in seconds                                          *
- * Parameters [password] : Redis password to connect using (blank)                     *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)            *
- * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                  *
- * Returns               : 0 (success),1 (failure)                                     *
- *                                                                                     *
- ***************************************************************************************/
-int redis_key_ttl(AGENT_REQUEST *request,AGENT_RESULT *result)
+/*********************************************************************************************
+ *                                                                                           *
+ * Custom Key            : redis.keys.ttl.histogram[server,port,timeout,password,database,   *
+ *                                                  pattern,samples]                         *
+ *                                                                                           *
+ * Function              : Samples keys and returns a histogram of their TTL                 *
+ *                         (no_expire, lt_1m, lt_1h, lt_1d, gt_1d, missing)                  *
+ * Parameters [server]   : Redis server address to connect                                   *
+ * Parameters [port]     : Redis server port to connect                                      *
+ * Parameters [timeout]  : Timeout in seconds                                                *
+ * Parameters [password] : Redis password to connect using (blank)                           *
+ * Parameters [database] : Redis database to sample                                          *
+ * Parameters [pattern]  : Key pattern to sample, blank or * samples with RANDOMKEY          *
+ *                         otherwise keys are sampled by continuing a SCAN MATCH             *
+ * Parameters [samples]  : Keys to sample per poll (100)                                     *
+ * Returns               : 0 (success),1 (failure)                                           *
+ *                                                                                           *
+ *********************************************************************************************/
+int redis_keys_ttl_histogram(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_ttl";
-	const char     *__key_name      = "redis.key.ttl[server,port,timeout,password,database,key]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
-	char           *param_key;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char          *__function_name = "redis_keys_ttl_histogram";
+	const char          *__key_name      = "redis.keys.ttl.histogram[server,port,timeout,password,database,pattern,samples]";
+	const char          *bucket_names[TTL_BUCKETS] = {"no_expire", "lt_1m", "lt_1h", "lt_1d", "gt_1d", "missing"};
+	int                  ret = SYSINFO_RET_FAIL;
+	char                *zbx_key;
+	int                  param_count = 7;
+	char                *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_pattern, *param_samples;
+	struct               zbx_json j;
+	redisContext        *redisC;
+	redis_scan_cursor_t *scan = NULL;
+	char                 value[MAX_LENGTH_STRING];
+	unsigned long long   buckets[TTL_BUCKETS] = {0}, sampled = 0;
+	int                  count;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -1944,14 +1899,19 @@ int redis_key_ttl(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
 	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
+	param_pattern  = get_rparam(request,5);
+	param_samples  = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
 	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Pattern", param_pattern, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
+	if (validate_param(result, zbx_key, "Samples", param_samples, DEFAULT_TTL_SAMPLES, ALLOW_NULL_FALSE, MIN_TTL_SAMPLES, MAX_TTL_SAMPLES))             {return ret;}
 
 	// Create the redis session
 	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
@@ -1959,14 +1919,43 @@ int redis_key_ttl(AGENT_REQUEST *request,AGENT_RESULT *result)
 	// Select the redis database
 	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+	// If the keys are matched then the scan continues from where the last poll finished
+	if (strlen(param_pattern) > 0 && strcmp(param_pattern,"*") != 0) {scan = redis_scan_cursor_get(param_server, param_port, param_database, param_pattern);}
 
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "TTL", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+	// Sample the keys
+	if (redis_ttl_sample(result, zbx_key, redisC, (scan != NULL) ? scan->cursor : NULL, param_pattern, atoi(param_samples), buckets)) {goto out;}
+
+	// Store the SCAN cursor of the target
+	if (scan != NULL) {redis_scan_cursor_put(scan);}
+
+	// Initialise JSON
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Add every bucket
+	for (count = 0; count < TTL_BUCKETS; count++) {
+
+		zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",buckets[count]);
+		zbx_json_addstring(&j, bucket_names[count], value, ZBX_JSON_TYPE_INT);
+
+		sampled += buckets[count];
+
+	}
+
+	// Add the keys sampled
+	zbx_snprintf(value,MAX_LENGTH_STRING,"%llu",sampled);
+	zbx_json_addstring(&j, "sampled", value, ZBX_JSON_TYPE_INT);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) sampled keys (%llu)",MODULE,zbx_key,sampled);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
 
 	// Set return
-	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
 
 out:
 
@@ -1980,79 +1969,155 @@ out:
 
 }
 
-/****************************************************************************************
- *                                                                                      *
- * Custom Key            : redis.key.pttl[server,port,timeout,password,database,key]    *
- *                                                                                      *
- * Function              : Get a redis keys pttl in milliseconds                        *
- * Parameters [server]   : Redis server address to connect                              *
- * Parameters [port]     : Redis server port to connect                                 *
- * Parameters [timeout]  : Timeout in seconds                                           *
- * Parameters [password] : Redis password to connect using (blank)                      *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)             *
- * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                   *
- * Returns               : 0 (success),1 (failure)                                      *
- *                                                                                      *
- ****************************************************************************************/
-int redis_key_pttl(AGENT_REQUEST *request,AGENT_RESULT *result)
+/***********************************************************************************************
+ *                                                                                             *
+ * Custom Key            : redis.client.discovery[server,port,timeout,password,name,flags,     *
+ *                                                minage,minidle,maxrows]                      *
+ *                                                                                             *
+ * Function              : Discovers redis clients (filters are optional and are matched in a  *
+ *                         single pass so the discovery stops once maxrows clients match)      *
+ * Parameters [server]   : Redis server address to connect                                     *
+ * Parameters [port]     : Redis server port to connect                                        *
+ * Parameters [timeout]  : Timeout in seconds                                                  *
+ * Parameters [password] : Redis password to connect using (blank)                             *
+ * Parameters [name]     : Client name regular expression to match (blank)                     *
+ * Parameters [flags]    : Client flags that must all be set ie bP (blank)                     *
+ * Parameters [minage]   : Minimum client age in seconds (blank)                               *
+ * Parameters [minidle]  : Minimum client idle time in seconds (blank)                         *
+ * Parameters [maxrows]  : Maximum clients to discover (1000)                                  *
+ * Returns               : 0 (success),1 (failure)                                             *
+ *                                                                                             *
+ ***********************************************************************************************/
+int redis_client_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_pttl";
-	const char     *__key_name      = "redis.key.pttl[server,port,timeout,password,database,key]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
-	char           *param_key;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char      *__function_name = "redis_client_discovery";
+	const char      *__key_name      = "redis.client.discovery[server,port,timeout,password,name,flags,minage,minidle,maxrows]";
+	int              ret = SYSINFO_RET_FAIL;
+	char            *zbx_key, *zbx_msg;
+	int              param_count = 9;
+	char            *param_server, *param_port, *param_timeout, *param_password;
+	int              cache_ttl;
+	char            *param_name, *param_flags, *param_minage, *param_minidle, *param_maxrows;
+	struct           zbx_json j;
+	redis_clients_t *clients;
+	redis_client_t  *client;
+	regex_t          regexCompiled;
+	int              discovered_instances = 0, maxrows;
+	int              count;
+	char            *flag;
+	unsigned long long minage, minidle;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
-	// Validate parameter count
-	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+	// Validate parameter count (the filters are optional)
+	if (validate_param_count(result, zbx_key, 4, request->nparam, "<"))           {return ret;}
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, ">")) {return ret;}
 
 	// Assign parameters
 	param_server   = get_rparam(request,0);
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
+	param_name     = strisnull(get_rparam(request,4)) ? "" : get_rparam(request,4);
+	param_flags    = strisnull(get_rparam(request,5)) ? "" : get_rparam(request,5);
+	param_minage   = strisnull(get_rparam(request,6)) ? "" : get_rparam(request,6);
+	param_minidle  = strisnull(get_rparam(request,7)) ? "" : get_rparam(request,7);
+	param_maxrows  = strisnull(get_rparam(request,8)) ? DEFAULT_CLIENT_DISCOVERY_ROWS : get_rparam(request,8);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
-	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
-	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
-	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                              {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                    {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT))     {return ret;}
+	if (validate_param(result, zbx_key, "Minage", param_minage, NO_DEFAULT, ALLOW_NULL_TRUE, MIN_CLIENT_AGE, MAX_CLIENT_AGE))                               {return ret;}
+	if (validate_param(result, zbx_key, "Minidle", param_minidle, NO_DEFAULT, ALLOW_NULL_TRUE, MIN_CLIENT_IDLE, MAX_CLIENT_IDLE))                           {return ret;}
+	if (validate_param(result, zbx_key, "Maxrows", param_maxrows, NO_DEFAULT, ALLOW_NULL_FALSE, MIN_CLIENT_DISCOVERY_ROWS, MAX_CLIENT_DISCOVERY_ROWS))      {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+	// Set the maximum rows and minimum times (blank matches every client)
+	maxrows = atoi(param_maxrows);
+	minage  = strtoull(param_minage,NULL,10);
+	minidle = strtoull(param_minidle,NULL,10);
 
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+	// Compile the name filter and fail if so
+	if (strlen(param_name) > 0 && regcomp(&regexCompiled,param_name,REG_EXTENDED|REG_NOSUB)) {
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+		// Form message
+		zbx_msg = redis_arena_printf("Unable to compile regular expression ([%s])",param_name);
 
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "PTTL", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, NULL);
+
+		return ret;
+
+	}
+
+	// Get the client table (The table is owned by the cache so it is not freed)
+	if (redis_clients_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, &clients)) {goto out;}
+
+	// Initialise JSON for discovery
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Create JSON array of discovered instances
+	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
+
+	// Process every client until enough have been discovered
+	for (count = 0; count < clients->client_count && discovered_instances < maxrows; count++) {
+
+		// Declare Variables
+		client = &clients->clients[count];
+
+		// If the client has no addr or is a libzbxredis-internal client
+		if (*client->addr == '\0' || strcmp(client->name,MODULE) == 0) {continue;}
+
+		// If the client does not match the filters
+		if (client->age < minage)                                                          {continue;}
+		if (client->idle < minidle)                                                        {continue;}
+		if (strlen(param_name) > 0 && regexec(&regexCompiled,client->name,0,NULL,0) != 0)  {continue;}
+
+		// Every flag must be set (commas between flags are ignored)
+		for (flag = param_flags; *flag != '\0' && (*flag == ',' || strchr(client->flags,*flag) != NULL); flag++) {}
+		if (*flag != '\0') {continue;}
+
+		// Open instance in JSON
+		zbx_json_addobject(&j, NULL);
+
+		zbx_json_addstring(&j, "{#CLIENT}", client->addr, ZBX_JSON_TYPE_STRING);
+
+		// Close instance in JSON 
+		zbx_json_close(&j);
+
+		// Increment discovered instances
+		discovered_instances++;
+
+	}
+
+	// Finalise JSON for discovery
+	zbx_json_close(&j);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%d)",MODULE,zbx_key,discovered_instances);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
 
 	// Set return
-	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
 
 out:
 
-	// Free the context
-	redisFree(redisC);
+	// Free compiled regex
+	if (strlen(param_name) > 0) {regfree(&regexCompiled);}
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
@@ -2061,41 +2126,42 @@ out:
 
 }
 
-/****************************************************************************************
- *                                                                                      *
- * Custom Key            : redis.key.type[server,port,timeout,password,database,key]    *
- *                                                                                      *
- * Function              : Gets a redis key type                                        *
- * Parameters [server]   : Redis server address to connect                              *
- * Parameters [port]     : Redis server port to connect                                 *
- * Parameters [timeout]  : Timeout in seconds                                           *
- * Parameters [password] : Redis password to connect using (blank)                      *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)             *
- * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                   *
- * Returns               : 0 (success),1 (failure)                                      *
- *                                                                                      *
- ****************************************************************************************/
-int redis_key_type(AGENT_REQUEST *request,AGENT_RESULT *result)
+/*************************************************************************************************************************
+ *                                                                                                                       *
+ * Custom Key            : redis.client.info[server,port,timeout,password,datatype,client,key]                           *
+ *                                                                                                                       *
+ * Function              : Gets the redis client field                                                                   *
+ * Parameters [server]   : Redis server address to connect                                                               *
+ * Parameters [port]     : Redis server port to connect                                                                  *
+ * Parameters [timeout]  : Timeout in seconds                                                                            *
+ * Parameters [password] : Redis password to connect using (blank)                                                       *
+ * Parameters [datatype] : Data type to return (integer,float,string,text)                                               *
+ * Parameters [client]   : Client to select the key for (192.168.1.1:6789, 192.168.1.2:6789, 192.168.1.3:6789 etc...)    *
+ * Parameters [key]      : Key to return (ip,port,state,offset,lag etc...)                                               *
+ * Parameters [default]  : Value default to return if no value is detected                                               *
+ * Returns               : 0 (success),1 (failure)                                                                       *
+ *                                                                                                                       *
+ *************************************************************************************************************************/
+int redis_client_info(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_type";
-	const char     *__key_name      = "redis.key.type[server,port,timeout,password,database,key]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
-	char           *param_key;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char      *__function_name = "redis_client_info";
+	const char      *__key_name      = "redis.client.info[server,port,timeout,password,datatype,client,key,default]";
+	int              ret = SYSINFO_RET_FAIL;
+	char            *zbx_key;
+	int              param_count = 8;
+	char            *param_server, *param_port, *param_timeout, *param_password, *param_datatype, *param_client, *param_key, *param_default;
+	int              cache_ttl;
+	redis_clients_t *clients;
+	redis_client_t  *client;
+	char            *redis_value;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2105,36 +2171,64 @@ int redis_key_type(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
+	param_datatype = get_rparam(request,4);
+	param_client   = get_rparam(request,5);
+	param_key      = get_rparam(request,6);
+	param_default  = get_rparam(request,7);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Datatype", param_datatype, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Client", param_client, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                          {return ret;}
 	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+	// Get the client table (The table is owned by the cache so it is not freed)
+	if (redis_clients_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, &clients)) {goto out;}
 
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+	// If the client does not exist
+	if ((client = redis_clients_find(clients, param_client)) == NULL) {
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis client does not exist", NULL);
 
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "TYPE", param_key, REDIS_REPLY_STRING)) {goto out;}
+		goto out;
+
+	}
+
+	// If the redis value can not be found
+	if ((redis_value = redis_client_field(client, param_key)) == NULL) {
+
+		// For some values they are or are not present depending on the status of redis so this is where the default value comes into it
+		// This is used to prevent Zabbix from reporting the item as "Unsupported" where it makes sense ie master_link_down_since_seconds could be defaulted to 0
+
+		// If the info is undetected and can be set to a default value
+		if (strlen(param_default) > 0 && param_default != NULL) {
+
+			// Set return
+			zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, param_default, param_datatype, NULL);
+
+			goto out;
+
+		}
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis client information does not exist", NULL);
+
+		goto out;
+
+	}
 
 	// Set return
-	zbx_ret_string(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, redisR);
+	zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redis_value, param_datatype, NULL);
 
 out:
 
-	// Free the context
-	redisFree(redisC);
-
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
 
@@ -2142,41 +2236,55 @@ out:
 
 }
 
-/*************************************************************************************************
- *                                                                                               *
- * Custom Key            : redis.key.string.exists[server,port,timeout,password,database,key]    *
- *                                                                                               *
- * Function              : Tests if redis string exists                                          *
- * Parameters [server]   : Redis server address to connect                                       *
- * Parameters [port]     : Redis server port to connect                                          *
- * Parameters [timeout]  : Timeout in seconds                                                    *
- * Parameters [password] : Redis password to connect using (blank)                               *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                      *
- * Parameters [key]      : Key to check (key-a, key-b, key-c etc...)                             *
- * Returns               : 0 (no),1 (yes)                                                        *
- *                                                                                               *
- *************************************************************************************************/
-int redis_key_string_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+/******************************************************************************
+ *                                                                            *
+ * Function   : Sort comparator of client group names                         *
+ * Returns    : <0, 0, >0                                                     *
+ *                                                                            *
+ ******************************************************************************/
+static int redis_client_group_compare(const void *a, const void *b)
+{
+
+	return strcmp(*(char * const *)a,*(char * const *)b);
+
+}
+
+/************************************************************************************************
+ *                                                                                              *
+ * Custom Key            : redis.client.group.discovery[server,port,timeout,password,groupby]   *
+ *                                                                                              *
+ * Function              : Discovers the groups of redis clients                                *
+ * Parameters [server]   : Redis server address to connect                                      *
+ * Parameters [port]     : Redis server port to connect                                         *
+ * Parameters [timeout]  : Timeout in seconds                                                   *
+ * Parameters [password] : Redis password to connect using (blank)                             *
+ * Parameters [groupby]  : Group clients by (name,cmd,flag)                                     *
+ * Returns               : 0 (success),1 (failure)                                              *
+ *                                                                                              *
+ ************************************************************************************************/
+int redis_client_group_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_string_exists";
-	const char     *__key_name      = "redis.key.string.exists[server,port,timeout,password,database,key]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
-	char           *param_key;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char      *__function_name = "redis_client_group_discovery";
+	const char      *__key_name      = "redis.client.group.discovery[server,port,timeout,password,groupby]";
+	int              ret = SYSINFO_RET_FAIL;
+	char            *zbx_key;
+	int              param_count = 5;
+	char            *param_server, *param_port, *param_timeout, *param_password, *param_groupby;
+	int              cache_ttl;
+	struct           zbx_json j;
+	redis_clients_t *clients;
+	redis_client_t  *client;
+	int              discovered_instances = 0;
+	int              count, group_count = 0, groupby_name, groupby_cmd, groupby_flag;
+	char           **groups, *flag, flag_group[2] = "", flags_seen[256] = {0};
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2186,35 +2294,125 @@ int redis_key_string_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
+	param_groupby  = get_rparam(request,4);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Groupby", param_groupby, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                        {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+	// Resolve the groupby
+	groupby_name = (strcmp(param_groupby,"name") == 0);
+	groupby_cmd  = (strcmp(param_groupby,"cmd") == 0);
+	groupby_flag = (strcmp(param_groupby,"flag") == 0);
 
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+	// If the groupby is not known
+	if (! groupby_name && ! groupby_cmd && ! groupby_flag) {
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Groupby must be name,cmd,flag", NULL);
 
-	// If the redis key type does not match string
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+		goto out;
 
-	// If the redis key type does match string
-	if (! redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+	}
 
-out:
+	// Get the client table (The table is owned by the cache so it is not freed)
+	if (redis_clients_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, &clients)) {goto out;}
 
-	// Free the context
-	redisFree(redisC);
+	// Initialise JSON for discovery
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Create JSON array of discovered instances
+	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
+
+	// Collect the group of every client (flags are collected as every flag the client has)
+	groups = zbx_malloc(NULL, sizeof(char *) * (clients->client_count + 1));
+
+	for (count = 0; count < clients->client_count; count++) {
+
+		// Declare Variables
+		client = &clients->clients[count];
+
+		// If the client is a libzbxredis-internal client
+		if (strcmp(client->name,MODULE) == 0) {continue;}
+
+		// Collect the group
+		if (groupby_name) {groups[group_count++] = client->name;}
+		if (groupby_cmd)  {groups[group_count++] = client->cmd;}
+
+		// Collect the flags
+		for (flag = client->flags; groupby_flag && *flag != '\0'; flag++) {flags_seen[(unsigned char)*flag] = 1;}
+
+	}
+
+	// Sort the groups so that each group is added once
+	qsort(groups, group_count, sizeof(char *), redis_client_group_compare);
+
+	// Add every group
+	for (count = 0; count < group_count; count++) {
+
+		// If the group has been added already
+		if (count > 0 && strcmp(groups[count],groups[count - 1]) == 0) {continue;}
+
+		// Open instance in JSON
+		zbx_json_addobject(&j, NULL);
+
+		zbx_json_addstring(&j, "{#GROUPBY}", param_groupby, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(&j, "{#GROUP}", groups[count], ZBX_JSON_TYPE_STRING);
+
+		// Close instance in JSON 
+		zbx_json_close(&j);
+
+		// Increment discovered instances
+		discovered_instances++;
+
+	}
+
+	// Add every flag
+	for (count = 1; count < 256; count++) {
+
+		// If the flag is not held by any client
+		if (! flags_seen[count]) {continue;}
+
+		flag_group[0] = (char)count;
+
+		// Open instance in JSON
+		zbx_json_addobject(&j, NULL);
+
+		zbx_json_addstring(&j, "{#GROUPBY}", param_groupby, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(&j, "{#GROUP}", flag_group, ZBX_JSON_TYPE_STRING);
+
+		// Close instance in JSON 
+		zbx_json_close(&j);
+
+		// Increment discovered instances
+		discovered_instances++;
+
+	}
+
+	// Free the groups
+	zbx_free(groups);
+
+	// Finalise JSON for discovery
+	zbx_json_close(&j);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%d)",MODULE,zbx_key,discovered_instances);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+out:
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
@@ -2223,41 +2421,41 @@ out:
 
 }
 
-/******************************************************************************************************
- *                                                                                                    *
- * Custom Key            : redis.key.string.get[server,port,timeout,password,database,key,default]    *
- *                                                                                                    *
- * Function              : Get a redis string                                                         *
- * Parameters [server]   : Redis server address to connect                                            *
- * Parameters [port]     : Redis server port to connect                                               *
- * Parameters [timeout]  : Timeout in seconds                                                         *
- * Parameters [password] : Redis password to connect using (blank)                                    *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                           *
- * Parameters [key]      : Key to get (key-a, key-b, key-c etc...)                                    *
- * Parameters [default]  : Value default to return if no value is detected                            *
- * Returns               : 0 (success),1 (failure)                                                    *
- *                                                                                                    *
- ******************************************************************************************************/
-int redis_key_string_get(AGENT_REQUEST *request,AGENT_RESULT *result)
+/**************************************************************************************************************
+ *                                                                                                            *
+ * Custom Key            : redis.client.aggregate[server,port,timeout,password,groupby,group,metric]          *
+ *                                                                                                            *
+ * Function              : Gets an aggregate of a group of redis clients                                      *
+ * Parameters [server]   : Redis server address to connect                                                    *
+ * Parameters [port]     : Redis server port to connect                                                       *
+ * Parameters [timeout]  : Timeout in seconds                                                                 *
+ * Parameters [password] : Redis password to connect using (blank)                                           *
+ * Parameters [groupby]  : Group clients by (all,name,cmd,flag)                                               *
+ * Parameters [group]    : Group to aggregate (client name, last command, or a single flag ie b,P,S,M)        *
+ * Parameters [metric]   : Aggregate to return (count,omem,qbuf,tot-mem,idle.max,blocked,pubsub)              *
+ * Returns               : 0 (success),1 (failure)                                                            *
+ *                                                                                                            *
+ **************************************************************************************************************/
+int redis_client_aggregate(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_string_get";
-	const char     *__key_name      = "redis.key.string.get[server,port,timeout,password,database,key,default]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 7;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_default;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char             *__function_name = "redis_client_aggregate";
+	const char             *__key_name      = "redis.client.aggregate[server,port,timeout,password,groupby,group,metric]";
+	int                     ret = SYSINFO_RET_FAIL;
+	char                   *zbx_key;
+	int                     param_count = 7;
+	char                   *param_server, *param_port, *param_timeout, *param_password, *param_groupby, *param_group, *param_metric;
+	int                     cache_ttl;
+	redis_client_summary_t *summary;
+	redis_client_group_t   *group;
+	unsigned long long      value = 0;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2267,41 +2465,69 @@ int redis_key_string_get(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
-	param_default  = get_rparam(request,6);
+	param_groupby  = get_rparam(request,4);
+	param_group    = get_rparam(request,5);
+	param_metric   = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
-	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
+	if (validate_param(result, zbx_key, "Groupby", param_groupby, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                        {return ret;}
+	if (validate_param(result, zbx_key, "Group", param_group, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
+	if (validate_param(result, zbx_key, "Metric", param_metric, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                          {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+	// If the groupby is not known
+	if (strcmp(param_groupby,"all") != 0 && strcmp(param_groupby,"name") != 0 && strcmp(param_groupby,"cmd") != 0 && strcmp(param_groupby,"flag") != 0) {
 
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Groupby must be all,name,cmd,flag", NULL);
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+		goto out;
 
-	// If the redis key type does not match
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {goto out;}
+	}
 
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "GET", param_key, REDIS_REPLY_STRING)) {goto out;}
+	// If the metric is not known
+	if (strcmp(param_metric,"count") != 0 && strcmp(param_metric,"omem") != 0 && strcmp(param_metric,"qbuf") != 0 && strcmp(param_metric,"tot-mem") != 0 &&
+	    strcmp(param_metric,"idle.max") != 0 && strcmp(param_metric,"blocked") != 0 && strcmp(param_metric,"pubsub") != 0) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Metric must be count,omem,qbuf,tot-mem,idle.max,blocked,pubsub", NULL);
+
+		goto out;
+
+	}
+
+	// Get the client aggregates, streamed from CLIENT LIST (The aggregates are owned by the cache so they are not freed)
+	if (redis_clients_summary_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, &summary)) {goto out;}
+
+	// If the group was not held
+	if ((group = redis_clients_summary_group(summary, param_groupby, param_group)) == NULL) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Group is not aggregated (too many groups of clients)", NULL);
+
+		goto out;
+
+	}
+
+	// Get the metric
+	if (strcmp(param_metric,"count") == 0)    {value = group->count;}
+	if (strcmp(param_metric,"omem") == 0)     {value = group->omem;}
+	if (strcmp(param_metric,"qbuf") == 0)     {value = group->qbuf;}
+	if (strcmp(param_metric,"tot-mem") == 0)  {value = group->totmem;}
+	if (strcmp(param_metric,"idle.max") == 0) {value = group->idle_max;}
+	if (strcmp(param_metric,"blocked") == 0)  {value = group->blocked;}
+	if (strcmp(param_metric,"pubsub") == 0)   {value = group->pubsub;}
 
 	// Set return
-	zbx_ret_string(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, redisR);
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, value, NULL);
 
 out:
 
-	// Free the context
-	redisFree(redisC);
-
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
 
@@ -2309,33 +2535,33 @@ out:
 
 }
 
-/*************************************************************************************************
- *                                                                                               *
- * Custom Key            : redis.key.string.length[server,port,timeout,password,database,key]    *
- *                                                                                               *
- * Function              : Gets a redis strings length                                           *
- * Parameters [server]   : Redis server address to connect                                       *
- * Parameters [port]     : Redis server port to connect                                          *
- * Parameters [timeout]  : Timeout in seconds                                                    *
- * Parameters [password] : Redis password to connect using (blank)                               *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                      *
- * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                            *
- * Returns               : 0 (success),1 (failure)                                               *
- *                                                                                               *
- *************************************************************************************************/
-int redis_key_string_length(AGENT_REQUEST *request,AGENT_RESULT *result)
+/******************************************************************************************
+ *                                                                                        *
+ * Custom Key            : redis.key.exists[server,port,timeout,password,database,key]    *
+ *                                                                                        *
+ * Function              : Check if a redis key exists                                    *
+ * Parameters [server]   : Redis server address to connect                                *
+ * Parameters [port]     : Redis server port to connect                                   *
+ * Parameters [timeout]  : Timeout in seconds                                             *
+ * Parameters [password] : Redis password to connect using (blank)                        *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)               *
+ * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                     *
+ * Returns               : 0 (success),1 (failure)                                        *
+ *                                                                                        *
+ ******************************************************************************************/
+int redis_key_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_string_length";
-	const char     *__key_name      = "redis.key.string.length[server,port,timeout,password,database,key]";
+	const char     *__function_name = "redis_key_exists";
+	const char     *__key_name      = "redis.key.exists[server,port,timeout,password,database,key]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 6;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
 	char           *param_key;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	char           *line;
 
@@ -2343,7 +2569,7 @@ int redis_key_string_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2356,6 +2582,9 @@ int redis_key_string_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_database = get_rparam(request,4);
 	param_key      = get_rparam(request,5);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -2370,16 +2599,10 @@ int redis_key_string_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
 
 	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
-
-	// If the redis key type does not match
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {goto out;}
-
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "STRLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
 
-	// Set return
-	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+	// If the redis key does exist
+	if (! redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
 
 out:
 
@@ -2393,44 +2616,41 @@ out:
 
 }
 
-/**************************************************************************************************
- *                                                                                                *
- * Custom Key            : redis.key.hash.discovery[server,port,timeout,password,database,key]    *
- *                                                                                                *
- * Function              : Discovers redis hash fields                                            *
- * Parameters [server]   : Redis server address to connect                                        *
- * Parameters [port]     : Redis server port to connect                                           *
- * Parameters [timeout]  : Timeout in seconds                                                     *
- * Parameters [password] : Redis password to connect using (blank)                                *
- * Parameters [datatype] : Data type to return (integer,float,string,text)                        *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                       *
- * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                             *
- * Returns               : 0 (success),1 (failure)                                                *
- *                                                                                                *
- **************************************************************************************************/
-int redis_key_hash_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
+/***************************************************************************************
+ *                                                                                     *
+ * Custom Key            : redis.key.ttl[server,port,timeout,password,database,key]    *
+ *                                                                                     *
+ * Function              : Get a redis keys ttl in seconds                             *
+ * Parameters [server]   : Redis server address to connect                             *
+ * Parameters [port]     : Redis server port to connect                                *
+ * Parameters [timeout]  : Timeout in seconds                                          *
+ * Parameters [password] : Redis password to connect using (blank)                     *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)            *
+ * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                  *
+ * Returns               : 0 (success),1 (failure)                                     *
+ *                                                                                     *
+ ***************************************************************************************/
+int redis_key_ttl(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_hash_discovery";
-	const char     *__key_name      = "redis.key.hash.discovery[server,port,timeout,password,database,key]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	const char     *__function_name = "redis_key_ttl";
+	const char     *__key_name      = "redis.key.ttl[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
 	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field, *param_default;
-	struct          zbx_json j;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
-	int             discovered_instances = 0;
-	int             count = 0;
 	char           *line;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2443,6 +2663,9 @@ int redis_key_hash_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_database = get_rparam(request,4);
 	param_key      = get_rparam(request,5);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -2459,53 +2682,11 @@ int redis_key_hash_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
 	// If the redis key does not exist
 	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
 
-	// If the redis key type does not match
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
-
 	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "HKEYS", param_key, REDIS_REPLY_ARRAY)) {goto out;}
-
-	// Initialise JSON for discovery
-	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
-
-	// Create JSON array of discovered instances
-	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
-
-	// For every element
-	for (count = 0; count < redisR->elements; count++) {
-
-		// Open instance in JSON
-		zbx_json_addobject(&j, NULL);
-
-		zbx_json_addstring(&j, "{#DATABASE}", param_database, ZBX_JSON_TYPE_STRING);
-		zbx_json_addstring(&j, "{#KEY}", param_key, ZBX_JSON_TYPE_STRING);
-		zbx_json_addstring(&j, "{#FIELD}", redisR->element[count]->str, ZBX_JSON_TYPE_STRING);
-
-		// Close instance in JSON 
-		zbx_json_close(&j);
-
-		// Increment discovered instances
-		discovered_instances++;
-
-	}
-
-	// Finalise JSON for discovery
-	zbx_json_close(&j);
-
-	// Log message
-	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%lld)",MODULE,zbx_key,discovered_instances);
-
-	// Set result
-	SET_STR_RESULT(result, strdup(j.buffer));
+	if (redis_command(result, zbx_key, redisC, &redisR, "TTL", param_key, REDIS_REPLY_INTEGER)) {goto out;}
 
 	// Set return
-	ret = SYSINFO_RET_OK;
-
-	// Free the json
-	zbx_json_free(&j);
-
-	// Free the reply
-	freeReplyObject(redisR);
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
 
 out:
 
@@ -2519,33 +2700,33 @@ out:
 
 }
 
-/**********************************************************************************************
- *                                                                                            *
- * Custom Key            : redis.key.hash.count[server,port,timeout,password,database,key]    *
- *                                                                                            *
- * Function              : Gets a redis hash field count                                      *
- * Parameters [server]   : Redis server address to connect                                    *
- * Parameters [port]     : Redis server port to connect                                       *
- * Parameters [timeout]  : Timeout in seconds                                                 *
- * Parameters [password] : Redis password to connect using (blank)                            *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                   *
- * Parameters [key]      : Key to select the field from  (key-a, key-b, key-c etc...)         *
- * Returns               : 0 (success),1 (failure)                                            *
- *                                                                                            *
- **********************************************************************************************/
-int redis_key_hash_count(AGENT_REQUEST *request,AGENT_RESULT *result)
+/****************************************************************************************
+ *                                                                                      *
+ * Custom Key            : redis.key.pttl[server,port,timeout,password,database,key]    *
+ *                                                                                      *
+ * Function              : Get a redis keys pttl in milliseconds                        *
+ * Parameters [server]   : Redis server address to connect                              *
+ * Parameters [port]     : Redis server port to connect                                 *
+ * Parameters [timeout]  : Timeout in seconds                                           *
+ * Parameters [password] : Redis password to connect using (blank)                      *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)             *
+ * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                   *
+ * Returns               : 0 (success),1 (failure)                                      *
+ *                                                                                      *
+ ****************************************************************************************/
+int redis_key_pttl(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_hash_count";
-	const char     *__key_name      = "redis.key.hash.count[server,port,timeout,password,database,key]";
+	const char     *__function_name = "redis_key_pttl";
+	const char     *__key_name      = "redis.key.pttl[server,port,timeout,password,database,key]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 6;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
 	char           *param_key;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	char           *line;
 
@@ -2553,7 +2734,7 @@ int redis_key_hash_count(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2566,6 +2747,9 @@ int redis_key_hash_count(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_database = get_rparam(request,4);
 	param_key      = get_rparam(request,5);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -2582,11 +2766,8 @@ int redis_key_hash_count(AGENT_REQUEST *request,AGENT_RESULT *result)
 	// If the redis key does not exist
 	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
 
-	// If the redis key type does not match
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
-
 	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "HLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+	if (redis_command(result, zbx_key, redisC, &redisR, "PTTL", param_key, REDIS_REPLY_INTEGER)) {goto out;}
 
 	// Set return
 	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
@@ -2603,33 +2784,33 @@ out:
 
 }
 
-/***********************************************************************************************
- *                                                                                             *
- * Custom Key            : redis.key.hash.exists[server,port,timeout,password,database,key]    *
- *                                                                                             *
- * Function              : Tests if redis hash exists                                          *
- * Parameters [server]   : Redis server address to connect                                     *
- * Parameters [port]     : Redis server port to connect                                        *
- * Parameters [timeout]  : Timeout in seconds                                                  *
- * Parameters [password] : Redis password to connect using (blank)                             *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                    *
- * Parameters [key]      : Key to check (key-a, key-b, key-c etc...)                           *
- * Returns               : 0 (no),1 (yes)                                                      *
- *                                                                                             *
- ***********************************************************************************************/
-int redis_key_hash_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+/****************************************************************************************
+ *                                                                                      *
+ * Custom Key            : redis.key.type[server,port,timeout,password,database,key]    *
+ *                                                                                      *
+ * Function              : Gets a redis key type                                        *
+ * Parameters [server]   : Redis server address to connect                              *
+ * Parameters [port]     : Redis server port to connect                                 *
+ * Parameters [timeout]  : Timeout in seconds                                           *
+ * Parameters [password] : Redis password to connect using (blank)                      *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)             *
+ * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                   *
+ * Returns               : 0 (success),1 (failure)                                      *
+ *                                                                                      *
+ ****************************************************************************************/
+int redis_key_type(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_hash_exists";
-	const char     *__key_name      = "redis.key.hash.exists[server,port,timeout,password,database,key]";
+	const char     *__function_name = "redis_key_type";
+	const char     *__key_name      = "redis.key.type[server,port,timeout,password,database,key]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
+	char           *zbx_key;
 	int             param_count = 6;
 	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
 	char           *param_key;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	char           *line;
 
@@ -2637,7 +2818,7 @@ int redis_key_hash_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2650,6 +2831,9 @@ int redis_key_hash_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_database = get_rparam(request,4);
 	param_key      = get_rparam(request,5);
 
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
@@ -2666,11 +2850,11 @@ int redis_key_hash_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	// If the redis key does not exist
 	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
 
-	// If the redis key type does not match hash
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "TYPE", param_key, REDIS_REPLY_STATUS)) {goto out;}
 
-	// If the redis key type does match hash
-	if (! redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+	// Set return
+	zbx_ret_string(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, redisR);
 
 out:
 
@@ -2684,33 +2868,33 @@ out:
 
 }
 
-/***********************************************************************************************************
- *                                                                                                         *
- * Custom Key            : redis.key.hash.field.exists[server,port,timeout,password,database,key,field]    *
- *                                                                                                         *
- * Function              : Checks hash field exists                                                        *
- * Parameters [server]   : Redis server address to connect                                                 *
- * Parameters [port]     : Redis server port to connect                                                    *
- * Parameters [timeout]  : Timeout in seconds                                                              *
- * Parameters [password] : Redis password to connect using (blank)                                         *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                *
- * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                       *
- * Parameters [field]    : Field to check (field-a, field-b, field-c etc...)                               *
- * Returns               : 0 (no),1 (yes)                                                                  *
- *                                                                                                         *
- ***********************************************************************************************************/
-int redis_key_hash_field_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+/*************************************************************************************************
+ *                                                                                               *
+ * Custom Key            : redis.key.string.exists[server,port,timeout,password,database,key]    *
+ *                                                                                               *
+ * Function              : Tests if redis string exists                                          *
+ * Parameters [server]   : Redis server address to connect                                       *
+ * Parameters [port]     : Redis server port to connect                                          *
+ * Parameters [timeout]  : Timeout in seconds                                                    *
+ * Parameters [password] : Redis password to connect using (blank)                               *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                      *
+ * Parameters [key]      : Key to check (key-a, key-b, key-c etc...)                             *
+ * Returns               : 0 (no),1 (yes)                                                        *
+ *                                                                                               *
+ *************************************************************************************************/
+int redis_key_string_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_hash_field_exists";
-	const char     *__key_name      = "redis.key.hash.field.exists[server,port,timeout,password,database,key,field]";
+	const char     *__function_name = "redis_key_string_exists";
+	const char     *__key_name      = "redis.key.string.exists[server,port,timeout,password,database,key]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 7;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	char           *line;
 
@@ -2718,7 +2902,7 @@ int redis_key_hash_field_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2730,7 +2914,9 @@ int redis_key_hash_field_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_password = get_rparam(request,3);
 	param_database = get_rparam(request,4);
 	param_key      = get_rparam(request,5);
-	param_field    = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
@@ -2738,7 +2924,6 @@ int redis_key_hash_field_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
 	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
 	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
-	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
 
 	// Create the redis session
 	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
@@ -2749,14 +2934,11 @@ int redis_key_hash_field_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
 	// If the redis key does not exist
 	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
 
-	// If the redis key type does not match
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
-
-	// If the redis hash field does not exist
-	if (redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+	// If the redis key type does not match string
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
 
-	// If the redis hash field does exist
-	if (! redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+	// If the redis key type does match string
+	if (! redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
 
 out:
 
@@ -2770,43 +2952,41 @@ out:
 
 }
 
-/****************************************************************************************************************
- *                                                                                                              *
- * Custom Key            : redis.key.hash.field.get[server,port,timeout,password,database,key,field,default]    *
- *                                                                                                              *
- * Function              : Gets a redis hash field                                                              *
- * Parameters [server]   : Redis server address to connect                                                      *
- * Parameters [port]     : Redis server port to connect                                                         *
- * Parameters [timeout]  : Timeout in seconds                                                                   *
- * Parameters [password] : Redis password to connect using (blank)                                              *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                     *
- * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                            *
- * Parameters [field]    : Field to return (field-a, field-b, field-c etc...)                                   *
- * Parameters [default]  : Value default to return if no value is detected                                      *
- * Returns               : 0 (success),1 (failure)                                                              *
- *                                                                                                              *
- ****************************************************************************************************************/
-int redis_key_hash_field_get(AGENT_REQUEST *request,AGENT_RESULT *result)
+/******************************************************************************************************
+ *                                                                                                    *
+ * Custom Key            : redis.key.string.get[server,port,timeout,password,database,key,default]    *
+ *                                                                                                    *
+ * Function              : Get a redis string                                                         *
+ * Parameters [server]   : Redis server address to connect                                            *
+ * Parameters [port]     : Redis server port to connect                                               *
+ * Parameters [timeout]  : Timeout in seconds                                                         *
+ * Parameters [password] : Redis password to connect using (blank)                                    *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                           *
+ * Parameters [key]      : Key to get (key-a, key-b, key-c etc...)                                    *
+ * Parameters [default]  : Value default to return if no value is detected                            *
+ * Returns               : 0 (success),1 (failure)                                                    *
+ *                                                                                                    *
+ ******************************************************************************************************/
+int redis_key_string_get(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_hash_field_get";
-	const char     *__key_name      = "redis.key.hash.field.get[server,port,timeout,password,database,key,field,default]";
+	const char     *__function_name = "redis_key_string_get";
+	const char     *__key_name      = "redis.key.string.get[server,port,timeout,password,database,key,default]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 8;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field, *param_default;
+	char           *zbx_key;
+	int             param_count = 7;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_default;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	char           *line;
-	char            redisParams[MAX_LENGTH_STRING];
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2818,8 +2998,10 @@ int redis_key_hash_field_get(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_password = get_rparam(request,3);
 	param_database = get_rparam(request,4);
 	param_key      = get_rparam(request,5);
-	param_field    = get_rparam(request,6);
-	param_default  = get_rparam(request,7);
+	param_default  = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
@@ -2827,14 +3009,8 @@ int redis_key_hash_field_get(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
 	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
 	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
-	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
 	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
 
-        // Append the parameters
-        strcat(redisParams,param_key);
-        strcat(redisParams," ");
-        strcat(redisParams,param_field);
- 
 	// Create the redis session
 	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
 
@@ -2845,13 +3021,10 @@ int redis_key_hash_field_get(AGENT_REQUEST *request,AGENT_RESULT *result)
 	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
 
 	// If the redis key type does not match
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
-
-	// If the redis hash field does not exist
-	if (redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {goto out;}
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {goto out;}
 
 	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "HGET", redisParams, REDIS_REPLY_STRING)) {goto out;}
+	if (redis_command(result, zbx_key, redisC, &redisR, "GET", param_key, REDIS_REPLY_STRING)) {goto out;}
 
 	// Set return
 	zbx_ret_string(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, redisR);
@@ -2868,42 +3041,2460 @@ out:
 
 }
 
-/***********************************************************************************************************
- *                                                                                                         *
- * Custom Key            : redis.key.hash.field.length[server,port,timeout,password,database,key,field]    *
- *                                                                                                         *
- * Function              : Gets a redis hash field length                                                  *
- * Parameters [server]   : Redis server address to connect                                                 *
- * Parameters [port]     : Redis server port to connect                                                    *
- * Parameters [timeout]  : Timeout in seconds                                                              *
- * Parameters [password] : Redis password to connect using (blank)                                         *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                *
- * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                       *
- * Parameters [field]    : Field to return (field-a, field-b, field-c etc...)                              *
- * Returns               : 0 (success),1 (failure)                                                         *
- *                                                                                                         *
- ***********************************************************************************************************/
-int redis_key_hash_field_length(AGENT_REQUEST *request,AGENT_RESULT *result)
+/*************************************************************************************************
+ *                                                                                               *
+ * Custom Key            : redis.key.string.length[server,port,timeout,password,database,key]    *
+ *                                                                                               *
+ * Function              : Gets a redis strings length                                           *
+ * Parameters [server]   : Redis server address to connect                                       *
+ * Parameters [port]     : Redis server port to connect                                          *
+ * Parameters [timeout]  : Timeout in seconds                                                    *
+ * Parameters [password] : Redis password to connect using (blank)                               *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                      *
+ * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                            *
+ * Returns               : 0 (success),1 (failure)                                               *
+ *                                                                                               *
+ *************************************************************************************************/
+int redis_key_string_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_hash_field_length";
-	const char     *__key_name      = "redis.key.hash.field.length[server,port,timeout,password,database,key,field]";
+	const char     *__function_name = "redis_key_string_length";
+	const char     *__key_name      = "redis.key.string.length[server,port,timeout,password,database,key]";
 	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 7;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
 	redisContext   *redisC;
-	redisReply     *redisR;
+	redisReply     *redisR = NULL;
 	struct timeval  timeout;
 	char           *line;
-	char            redisParams[MAX_LENGTH_STRING];
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "string")) {goto out;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "STRLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/**************************************************************************************************
+ *                                                                                                *
+ * Custom Key            : redis.key.hash.discovery[server,port,timeout,password,database,key]    *
+ *                                                                                                *
+ * Function              : Discovers redis hash fields                                            *
+ * Parameters [server]   : Redis server address to connect                                        *
+ * Parameters [port]     : Redis server port to connect                                           *
+ * Parameters [timeout]  : Timeout in seconds                                                     *
+ * Parameters [password] : Redis password to connect using (blank)                                *
+ * Parameters [datatype] : Data type to return (integer,float,string,text)                        *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                       *
+ * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                             *
+ * Returns               : 0 (success),1 (failure)                                                *
+ *                                                                                                *
+ **************************************************************************************************/
+int redis_key_hash_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_discovery";
+	const char     *__key_name      = "redis.key.hash.discovery[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field, *param_default;
+	struct          zbx_json j;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	int             discovered_instances = 0;
+	int             count = 0;
+	char           *line;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "HKEYS", param_key, REDIS_REPLY_ARRAY)) {goto out;}
+
+	// Initialise JSON for discovery
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Create JSON array of discovered instances
+	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
+
+	// For every element
+	for (count = 0; count < redisR->elements; count++) {
+
+		// Open instance in JSON
+		zbx_json_addobject(&j, NULL);
+
+		zbx_json_addstring(&j, "{#DATABASE}", param_database, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(&j, "{#KEY}", param_key, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(&j, "{#FIELD}", redisR->element[count]->str, ZBX_JSON_TYPE_STRING);
+
+		// Close instance in JSON 
+		zbx_json_close(&j);
+
+		// Increment discovered instances
+		discovered_instances++;
+
+	}
+
+	// Finalise JSON for discovery
+	zbx_json_close(&j);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%lld)",MODULE,zbx_key,discovered_instances);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/**********************************************************************************************
+ *                                                                                            *
+ * Custom Key            : redis.key.hash.count[server,port,timeout,password,database,key]    *
+ *                                                                                            *
+ * Function              : Gets a redis hash field count                                      *
+ * Parameters [server]   : Redis server address to connect                                    *
+ * Parameters [port]     : Redis server port to connect                                       *
+ * Parameters [timeout]  : Timeout in seconds                                                 *
+ * Parameters [password] : Redis password to connect using (blank)                            *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                   *
+ * Parameters [key]      : Key to select the field from  (key-a, key-b, key-c etc...)         *
+ * Returns               : 0 (success),1 (failure)                                            *
+ *                                                                                            *
+ **********************************************************************************************/
+int redis_key_hash_count(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_count";
+	const char     *__key_name      = "redis.key.hash.count[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "HLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***********************************************************************************************
+ *                                                                                             *
+ * Custom Key            : redis.key.hash.exists[server,port,timeout,password,database,key]    *
+ *                                                                                             *
+ * Function              : Tests if redis hash exists                                          *
+ * Parameters [server]   : Redis server address to connect                                     *
+ * Parameters [port]     : Redis server port to connect                                        *
+ * Parameters [timeout]  : Timeout in seconds                                                  *
+ * Parameters [password] : Redis password to connect using (blank)                             *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                    *
+ * Parameters [key]      : Key to check (key-a, key-b, key-c etc...)                           *
+ * Returns               : 0 (no),1 (yes)                                                      *
+ *                                                                                             *
+ ***********************************************************************************************/
+int redis_key_hash_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_exists";
+	const char     *__key_name      = "redis.key.hash.exists[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match hash
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+
+	// If the redis key type does match hash
+	if (! redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***********************************************************************************************************
+ *                                                                                                         *
+ * Custom Key            : redis.key.hash.field.exists[server,port,timeout,password,database,key,field]    *
+ *                                                                                                         *
+ * Function              : Checks hash field exists                                                        *
+ * Parameters [server]   : Redis server address to connect                                                 *
+ * Parameters [port]     : Redis server port to connect                                                    *
+ * Parameters [timeout]  : Timeout in seconds                                                              *
+ * Parameters [password] : Redis password to connect using (blank)                                         *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                *
+ * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                       *
+ * Parameters [field]    : Field to check (field-a, field-b, field-c etc...)                               *
+ * Returns               : 0 (no),1 (yes)                                                                  *
+ *                                                                                                         *
+ ***********************************************************************************************************/
+int redis_key_hash_field_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_field_exists";
+	const char     *__key_name      = "redis.key.hash.field.exists[server,port,timeout,password,database,key,field]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 7;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+	param_field    = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
+
+	// If the redis hash field does not exist
+	if (redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+
+	// If the redis hash field does exist
+	if (! redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/****************************************************************************************************************
+ *                                                                                                              *
+ * Custom Key            : redis.key.hash.field.get[server,port,timeout,password,database,key,field,default]    *
+ *                                                                                                              *
+ * Function              : Gets a redis hash field                                                              *
+ * Parameters [server]   : Redis server address to connect                                                      *
+ * Parameters [port]     : Redis server port to connect                                                         *
+ * Parameters [timeout]  : Timeout in seconds                                                                   *
+ * Parameters [password] : Redis password to connect using (blank)                                              *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                     *
+ * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                            *
+ * Parameters [field]    : Field to return (field-a, field-b, field-c etc...)                                   *
+ * Parameters [default]  : Value default to return if no value is detected                                      *
+ * Returns               : 0 (success),1 (failure)                                                              *
+ *                                                                                                              *
+ ****************************************************************************************************************/
+int redis_key_hash_field_get(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_field_get";
+	const char     *__key_name      = "redis.key.hash.field.get[server,port,timeout,password,database,key,field,default]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 8;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field, *param_default;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+	char            redisParams[MAX_LENGTH_STRING];
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+	param_field    = get_rparam(request,6);
+	param_default  = get_rparam(request,7);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
+	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
+
+        // Append the parameters
+        strcat(redisParams,param_key);
+        strcat(redisParams," ");
+        strcat(redisParams,param_field);
+ 
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
+
+	// If the redis hash field does not exist
+	if (redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {goto out;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "HGET", redisParams, REDIS_REPLY_STRING)) {goto out;}
+
+	// Set return
+	zbx_ret_string(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***********************************************************************************************************
+ *                                                                                                         *
+ * Custom Key            : redis.key.hash.field.length[server,port,timeout,password,database,key,field]    *
+ *                                                                                                         *
+ * Function              : Gets a redis hash field length                                                  *
+ * Parameters [server]   : Redis server address to connect                                                 *
+ * Parameters [port]     : Redis server port to connect                                                    *
+ * Parameters [timeout]  : Timeout in seconds                                                              *
+ * Parameters [password] : Redis password to connect using (blank)                                         *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                *
+ * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                       *
+ * Parameters [field]    : Field to return (field-a, field-b, field-c etc...)                              *
+ * Returns               : 0 (success),1 (failure)                                                         *
+ *                                                                                                         *
+ ***********************************************************************************************************/
+int redis_key_hash_field_length(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_field_length";
+	const char     *__key_name      = "redis.key.hash.field.length[server,port,timeout,password,database,key,field]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 7;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_field;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+	char            redisParams[MAX_LENGTH_STRING];
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+	param_field    = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
+
+        // Append the parameters
+        strcat(redisParams,param_key);
+        strcat(redisParams," ");
+        strcat(redisParams,param_field);
+ 
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
+
+	// If the redis hash field does not exist
+	if (redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {goto out;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "HSTRLEN", redisParams, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***********************************************************************************************
+ *                                                                                             *
+ * Custom Key            : redis.key.list.exists[server,port,timeout,password,database,key]    *
+ *                                                                                             *
+ * Function              : Tests if redis list exists                                          *
+ * Parameters [server]   : Redis server address to connect                                     *
+ * Parameters [port]     : Redis server port to connect                                        *
+ * Parameters [timeout]  : Timeout in seconds                                                  *
+ * Parameters [password] : Redis password to connect using (blank)                             *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                    *
+ * Parameters [key]      : Key to check (key-a, key-b, key-c etc...)                           *
+ * Returns               : 0 (no),1 (yes)                                                      *
+ *                                                                                             *
+ ***********************************************************************************************/
+int redis_key_list_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_list_exists";
+	const char     *__key_name      = "redis.key.list.exists[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match list
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+
+	// If the redis key type does match list
+	if (! redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/************************************************************************************************************
+ *                                                                                                          *
+ * Custom Key            : redis.key.list.get[server,port,timeout,password,database,key,element,default]    *
+ *                                                                                                          *
+ * Function              : Gets a redis list element                                                        *
+ * Parameters [server]   : Redis server address to connect                                                  *
+ * Parameters [port]     : Redis server port to connect                                                     *
+ * Parameters [timeout]  : Timeout in seconds                                                               *
+ * Parameters [password] : Redis password to connect using (blank)                                          *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                 *
+ * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                        *
+ * Parameters [element]  : Element to return (0, 1, 2 etc...)                                               *
+ * Parameters [default]  : Value default to return if no value is detected                                  *
+ * Returns               : 0 (success),1 (failure)                                                          *
+ *                                                                                                          *
+ ************************************************************************************************************/
+int redis_key_list_get(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_list_get";
+	const char     *__key_name      = "redis.key.list.get[server,port,timeout,password,database,key,element,default]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 8;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_element, *param_default;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+	char            redisParams[MAX_LENGTH_STRING];
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+	param_element  = get_rparam(request,6);
+	param_default  = get_rparam(request,7);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Element", param_element, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
+	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
+
+        // Append the parameters
+        strcat(redisParams,param_key);
+        strcat(redisParams," ");
+        strcat(redisParams,param_element);
+ 
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match list
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {goto out;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "LLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// If the redis list element does not exist
+	if (redisR->integer < atoi(param_element)) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis list element does not exist", redisR);
+
+		goto out;
+
+	}
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "LINDEX", redisParams, REDIS_REPLY_STRING)) {goto out;}
+
+	// Set return
+	zbx_ret_string(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***********************************************************************************************
+ *                                                                                             *
+ * Custom Key            : redis.key.list.length[server,port,timeout,password,database,key]    *
+ *                                                                                             *
+ * Function              : Gets the length of a redisk list key                                *
+ * Parameters [server]   : Redis server address to connect                                     *
+ * Parameters [port]     : Redis server port to connect                                        *
+ * Parameters [timeout]  : Timeout in seconds                                                  *
+ * Parameters [password] : Redis password to connect using (blank)                             *
+ * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                    *
+ * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                          *
+ * Returns               : 0 (success),1 (failure)                                             *
+ *                                                                                             *
+ ***********************************************************************************************/
+int redis_key_list_length(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_list_length";
+	const char     *__key_name      = "redis.key.list.length[server,port,timeout,password,database,key,field]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	struct timeval  timeout;
+	char           *line;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// If the redis key does not exist
+	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+
+	// If the redis key type does not match list
+	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {goto out;}
+
+	// Run redis command
+	if (redis_command(result, zbx_key, redisC, &redisR, "LLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/*******************************************************************************************
+ *                                                                                         *
+ * Custom Key            : redis.key.set.count[server,port,timeout,password,database,key]  *
+ *                                                                                         *
+ * Function              : Gets a redis set member count                                   *
+ * Parameters [server]   : Redis server address to connect                                 *
+ * Parameters [port]     : Redis server port to connect                                    *
+ * Parameters [timeout]  : Timeout in seconds                                              *
+ * Parameters [password] : Redis password to connect using (blank)                         *
+ * Parameters [database] : Redis database to connect                                       *
+ * Parameters [key]      : Redis key                                                       *
+ * Returns               : 0 (success),1 (failure)                                         *
+ *                                                                                         *
+ ******************************************************************************************/
+int redis_key_set_count(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_set_count";
+	const char     *__key_name      = "redis.key.set.count[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
+	const char     *redisArgv[2];
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// Set the redis command
+	redisArgv[0] = "SCARD";
+	redisArgv[1] = param_key;
+
+	// Run redis command (pipelined with the key type check)
+	if (redis_key_typed_command(result, &ret, zbx_key, redisC, &redisR, param_key, "set", 2, redisArgv, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/********************************************************************************************
+ *                                                                                          *
+ * Custom Key            : redis.key.zset.count[server,port,timeout,password,database,key]  *
+ *                                                                                          *
+ * Function              : Gets a redis sorted set member count                             *
+ * Parameters [server]   : Redis server address to connect                                  *
+ * Parameters [port]     : Redis server port to connect                                     *
+ * Parameters [timeout]  : Timeout in seconds                                               *
+ * Parameters [password] : Redis password to connect using (blank)                          *
+ * Parameters [database] : Redis database to connect                                        *
+ * Parameters [key]      : Redis key                                                        *
+ * Returns               : 0 (success),1 (failure)                                          *
+ *                                                                                          *
+ *******************************************************************************************/
+int redis_key_zset_count(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_zset_count";
+	const char     *__key_name      = "redis.key.zset.count[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
+	const char     *redisArgv[2];
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// Set the redis command
+	redisArgv[0] = "ZCARD";
+	redisArgv[1] = param_key;
+
+	// Run redis command (pipelined with the key type check)
+	if (redis_key_typed_command(result, &ret, zbx_key, redisC, &redisR, param_key, "zset", 2, redisArgv, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/**********************************************************************************************************
+ *                                                                                                        *
+ * Custom Key            : redis.key.zset.range.count[server,port,timeout,password,database,key,min,max]  *
+ *                                                                                                        *
+ * Function              : Gets a redis sorted set member count within a score range                      *
+ * Parameters [server]   : Redis server address to connect                                                *
+ * Parameters [port]     : Redis server port to connect                                                   *
+ * Parameters [timeout]  : Timeout in seconds                                                             *
+ * Parameters [password] : Redis password to connect using (blank)                                        *
+ * Parameters [database] : Redis database to connect                                                      *
+ * Parameters [key]      : Redis key                                                                      *
+ * Parameters [min]      : Minimum score (-inf, (1.5 for exclusive etc...)                                *
+ * Parameters [max]      : Maximum score (+inf etc...)                                                    *
+ * Returns               : 0 (success),1 (failure)                                                        *
+ *                                                                                                        *
+ *********************************************************************************************************/
+int redis_key_zset_range_count(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_zset_range_count";
+	const char     *__key_name      = "redis.key.zset.range.count[server,port,timeout,password,database,key,min,max]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 8;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key, *param_min, *param_max;
+	const char     *redisArgv[4];
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+	param_min      = get_rparam(request,6);
+	param_max      = get_rparam(request,7);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Min", param_min, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Max", param_max, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// Set the redis command
+	redisArgv[0] = "ZCOUNT";
+	redisArgv[1] = param_key;
+	redisArgv[2] = param_min;
+	redisArgv[3] = param_max;
+
+	// Run redis command (pipelined with the key type check)
+	if (redis_key_typed_command(result, &ret, zbx_key, redisC, &redisR, param_key, "zset", 4, redisArgv, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***********************************************************************************************
+ *                                                                                             *
+ * Custom Key            : redis.key.stream.length[server,port,timeout,password,database,key]  *
+ *                                                                                             *
+ * Function              : Gets a redis stream entry count                                     *
+ * Parameters [server]   : Redis server address to connect                                     *
+ * Parameters [port]     : Redis server port to connect                                        *
+ * Parameters [timeout]  : Timeout in seconds                                                  *
+ * Parameters [password] : Redis password to connect using (blank)                             *
+ * Parameters [database] : Redis database to connect                                           *
+ * Parameters [key]      : Redis key                                                           *
+ * Returns               : 0 (success),1 (failure)                                             *
+ *                                                                                             *
+ **********************************************************************************************/
+int redis_key_stream_length(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_stream_length";
+	const char     *__key_name      = "redis.key.stream.length[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database;
+	char           *param_key;
+	const char     *redisArgv[2];
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// Set the redis command
+	redisArgv[0] = "XLEN";
+	redisArgv[1] = param_key;
+
+	// Run redis command (pipelined with the key type check)
+	if (redis_key_typed_command(result, &ret, zbx_key, redisC, &redisR, param_key, "stream", 2, redisArgv, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***************************************************************************************************
+ *                                                                                                 *
+ * Custom Key            : redis.stream.group.discovery[server,port,timeout,password,database,key] *
+ *                                                                                                 *
+ * Function              : Discovers redis stream consumer groups                                  *
+ * Parameters [server]   : Redis server address to connect                                         *
+ * Parameters [port]     : Redis server port to connect                                            *
+ * Parameters [timeout]  : Timeout in seconds                                                      *
+ * Parameters [password] : Redis password to connect using (blank)                                 *
+ * Parameters [database] : Redis database to connect                                               *
+ * Parameters [key]      : Redis stream key                                                        *
+ * Returns               : 0 (success),1 (failure)                                                 *
+ *                                                                                                 *
+ **************************************************************************************************/
+int redis_stream_group_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_stream_group_discovery";
+	const char     *__key_name      = "redis.stream.group.discovery[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key;
+	int             cache_ttl;
+	struct          zbx_json j;
+	redisReply     *redisR = NULL, *redisGroup;
+	int             discovered_instances = 0;
+	size_t          count;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Get the stream groups (The reply is owned by the cache so it is not freed)
+	if (redis_stream_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, param_database, param_key, &redisR)) {goto out;}
+
+	// Initialise JSON for discovery
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Create JSON array of discovered instances
+	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
+
+	// For every group
+	for (count = 0; count < redisR->elements; count++) {
+
+		// If the group is not named
+		if ((redisGroup = redis_reply_map_value(redisR->element[count], "name")) == NULL || redisGroup->str == NULL) {continue;}
+
+		// Open instance in JSON
+		zbx_json_addobject(&j, NULL);
+
+		zbx_json_addstring(&j, "{#DATABASE}", param_database, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(&j, "{#KEY}", param_key, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(&j, "{#GROUP}", redisGroup->str, ZBX_JSON_TYPE_STRING);
+
+		// Close instance in JSON 
+		zbx_json_close(&j);
+
+		// Increment discovered instances
+		discovered_instances++;
+
+	}
+
+	// Finalise JSON for discovery
+	zbx_json_close(&j);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%d)",MODULE,zbx_key,discovered_instances);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/*******************************************************************************************************
+ *                                                                                                     *
+ * Custom Key            : redis.stream.group.info[server,port,timeout,password,database,datatype,key, *
+ *                                                 group,field,default]                                *
+ *                                                                                                     *
+ * Function              : Gets a redis stream consumer group field                                    *
+ * Parameters [server]   : Redis server address to connect                                             *
+ * Parameters [port]     : Redis server port to connect                                                *
+ * Parameters [timeout]  : Timeout in seconds                                                          *
+ * Parameters [password] : Redis password to connect using (blank)                                     *
+ * Parameters [database] : Redis database to connect                                                   *
+ * Parameters [datatype] : Data type to return (integer,float,string,text)                             *
+ * Parameters [key]      : Redis stream key                                                            *
+ * Parameters [group]    : Consumer group                                                              *
+ * Parameters [field]    : Field to return (lag,pending,consumers,last-delivered-id,entries-read)      *
+ * Parameters [default]  : Value default to return if no value is detected (lag is only reported       *
+ *                         by Redis 7 and may be unknown)                                              *
+ * Returns               : 0 (success),1 (failure)                                                     *
+ *                                                                                                     *
+ ******************************************************************************************************/
+int redis_stream_group_info(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_stream_group_info";
+	const char     *__key_name      = "redis.stream.group.info[server,port,timeout,password,database,datatype,key,group,field,default]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 10;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_datatype;
+	int             cache_ttl;
+	char           *param_key, *param_group, *param_field, *param_default;
+	redisReply     *redisR = NULL, *redisGroup, *redisValue = NULL;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_datatype = get_rparam(request,5);
+	param_key      = get_rparam(request,6);
+	param_group    = get_rparam(request,7);
+	param_field    = get_rparam(request,8);
+	param_default  = get_rparam(request,9);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Datatype", param_datatype, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Group", param_group, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                            {return ret;}
+	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                            {return ret;}
+	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
+
+	// Get the stream groups (The reply is owned by the cache so it is not freed)
+	if (redis_stream_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, param_database, param_key, &redisR)) {goto out;}
+
+	// Get the field of the group
+	if ((redisGroup = redis_reply_find(redisR, "name", param_group)) != NULL) {redisValue = redis_reply_map_value(redisGroup, param_field);}
+
+	// If the field is a value
+	if (redisValue != NULL && redisValue->type != REDIS_REPLY_NIL && redisValue->element == NULL) {
+
+		// Set return
+		zbx_ret_reply_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisValue, param_datatype, NULL);
+
+		goto out;
+
+	}
+
+	// If the info is undetected and can be set to a default value
+	if (strlen(param_default) > 0 && param_default != NULL) {
+
+		// Set return
+		zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, param_default, param_datatype, NULL);
+
+		goto out;
+
+	}
+
+	// Set return
+	zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis stream group information does not exist", NULL);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/******************************************************************************************************
+ *                                                                                                    *
+ * Custom Key            : redis.stream.consumer.discovery[server,port,timeout,password,database,key] *
+ *                                                                                                    *
+ * Function              : Discovers redis stream consumers of every consumer group                   *
+ * Parameters [server]   : Redis server address to connect                                            *
+ * Parameters [port]     : Redis server port to connect                                               *
+ * Parameters [timeout]  : Timeout in seconds                                                         *
+ * Parameters [password] : Redis password to connect using (blank)                                    *
+ * Parameters [database] : Redis database to connect                                                  *
+ * Parameters [key]      : Redis stream key                                                           *
+ * Returns               : 0 (success),1 (failure)                                                    *
+ *                                                                                                    *
+ *****************************************************************************************************/
+int redis_stream_consumer_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_stream_consumer_discovery";
+	const char     *__key_name      = "redis.stream.consumer.discovery[server,port,timeout,password,database,key]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key;
+	int             cache_ttl;
+	struct          zbx_json j;
+	redisReply     *redisR = NULL, *redisGroup, *redisConsumers, *redisConsumer;
+	int             discovered_instances = 0;
+	size_t          count, element;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+
+	// Get the stream groups (The replies are owned by the cache so they are not freed)
+	if (redis_stream_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, param_database, param_key, &redisR)) {goto out;}
+
+	// Initialise JSON for discovery
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Create JSON array of discovered instances
+	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
+
+	// For every group
+	for (count = 0; count < redisR->elements; count++) {
+
+		// If the group is not named or its consumers are not cached
+		if ((redisGroup = redis_reply_map_value(redisR->element[count], "name")) == NULL || redisGroup->str == NULL) {continue;}
+		if ((redisConsumers = redis_stream_consumers(param_server, param_port, param_database, param_key, redisGroup->str)) == NULL) {continue;}
+
+		// For every consumer
+		for (element = 0; element < redisConsumers->elements; element++) {
+
+			// If the consumer is not named
+			if ((redisConsumer = redis_reply_map_value(redisConsumers->element[element], "name")) == NULL || redisConsumer->str == NULL) {continue;}
+
+			// Open instance in JSON
+			zbx_json_addobject(&j, NULL);
+
+			zbx_json_addstring(&j, "{#DATABASE}", param_database, ZBX_JSON_TYPE_STRING);
+			zbx_json_addstring(&j, "{#KEY}", param_key, ZBX_JSON_TYPE_STRING);
+			zbx_json_addstring(&j, "{#GROUP}", redisGroup->str, ZBX_JSON_TYPE_STRING);
+			zbx_json_addstring(&j, "{#CONSUMER}", redisConsumer->str, ZBX_JSON_TYPE_STRING);
+
+			// Close instance in JSON 
+			zbx_json_close(&j);
+
+			// Increment discovered instances
+			discovered_instances++;
+
+		}
+
+	}
+
+	// Finalise JSON for discovery
+	zbx_json_close(&j);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%d)",MODULE,zbx_key,discovered_instances);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/**********************************************************************************************************
+ *                                                                                                        *
+ * Custom Key            : redis.stream.consumer.info[server,port,timeout,password,database,datatype,key, *
+ *                                                    group,consumer,field,default]                       *
+ *                                                                                                        *
+ * Function              : Gets a redis stream consumer field                                             *
+ * Parameters [server]   : Redis server address to connect                                                *
+ * Parameters [port]     : Redis server port to connect                                                   *
+ * Parameters [timeout]  : Timeout in seconds                                                             *
+ * Parameters [password] : Redis password to connect using (blank)                                        *
+ * Parameters [database] : Redis database to connect                                                      *
+ * Parameters [datatype] : Data type to return (integer,float,string,text)                                *
+ * Parameters [key]      : Redis stream key                                                               *
+ * Parameters [group]    : Consumer group                                                                 *
+ * Parameters [consumer] : Consumer                                                                       *
+ * Parameters [field]    : Field to return (pending,idle,inactive)                                        *
+ * Parameters [default]  : Value default to return if no value is detected                                *
+ * Returns               : 0 (success),1 (failure)                                                        *
+ *                                                                                                        *
+ *********************************************************************************************************/
+int redis_stream_consumer_info(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_stream_consumer_info";
+	const char     *__key_name      = "redis.stream.consumer.info[server,port,timeout,password,database,datatype,key,group,consumer,field,default]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 11;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_datatype;
+	int             cache_ttl;
+	char           *param_key, *param_group, *param_consumer, *param_field, *param_default;
+	redisReply     *redisR = NULL, *redisConsumers, *redisConsumer, *redisValue = NULL;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_datatype = get_rparam(request,5);
+	param_key      = get_rparam(request,6);
+	param_group    = get_rparam(request,7);
+	param_consumer = get_rparam(request,8);
+	param_field    = get_rparam(request,9);
+	param_default  = get_rparam(request,10);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Datatype", param_datatype, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Group", param_group, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                            {return ret;}
+	if (validate_param(result, zbx_key, "Consumer", param_consumer, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                            {return ret;}
+	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
+
+	// Get the stream groups and their consumers (The replies are owned by the cache so they are not freed)
+	if (redis_stream_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, param_database, param_key, &redisR)) {goto out;}
+
+	// Get the field of the consumer
+	if ((redisConsumers = redis_stream_consumers(param_server, param_port, param_database, param_key, param_group)) != NULL &&
+	    (redisConsumer = redis_reply_find(redisConsumers, "name", param_consumer)) != NULL) {redisValue = redis_reply_map_value(redisConsumer, param_field);}
+
+	// If the field is a value
+	if (redisValue != NULL && redisValue->type != REDIS_REPLY_NIL && redisValue->element == NULL) {
+
+		// Set return
+		zbx_ret_reply_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisValue, param_datatype, NULL);
+
+		goto out;
+
+	}
+
+	// If the info is undetected and can be set to a default value
+	if (strlen(param_default) > 0 && param_default != NULL) {
+
+		// Set return
+		zbx_ret_string_convert(result, &ret, LOG_LEVEL_DEBUG, zbx_key, param_default, param_datatype, NULL);
+
+		goto out;
+
+	}
+
+	// Set return
+	zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis stream consumer information does not exist", NULL);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***************************************************************************************
+ *                                                                                     *
+ * Custom Key            : redis.key.mget[server,port,timeout,password,database,keys]  *
+ *                                                                                     *
+ * Function              : Gets many redis string values with one MGET as a JSON       *
+ *                         object (keys that do not exist or are not strings are null) *
+ * Parameters [server]   : Redis server address to connect                             *
+ * Parameters [port]     : Redis server port to connect                                *
+ * Parameters [timeout]  : Timeout in seconds                                          *
+ * Parameters [password] : Redis password to connect using (blank)                     *
+ * Parameters [database] : Redis database to connect                                   *
+ * Parameters [keys]     : Redis keys separated by | (key-a|key-b etc...)              *
+ * Returns               : 0 (success),1 (failure)                                     *
+ *                                                                                     *
+ ***************************************************************************************/
+int redis_key_mget(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_mget";
+	const char     *__key_name      = "redis.key.mget[server,port,timeout,password,database,keys]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_keys;
+	const char     *redisArgv[MAX_MGET_KEYS + 1];
+	int             redisArgc;
+	struct          zbx_json j;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	size_t          count;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_keys     = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Keys", param_keys, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                              {return ret;}
+
+	// Set the redis command
+	redisArgv[0] = "MGET";
+
+	// Split the keys
+	if ((redisArgc = split_param(result, zbx_key, "Keys", param_keys, MGET_SEPARATOR, redisArgv + 1, MAX_MGET_KEYS)) == -1) {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// Run redis command
+	if ((redisR = redis_command_send_argv(redisC, redisArgc + 1, redisArgv, NULL)) == NULL) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis connection lost", NULL);
+
+		goto out;
+
+	}
+
+	// If the reply is not a value for every key
+	if (redisR->type != REDIS_REPLY_ARRAY || redisR->elements != (size_t)redisArgc) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->type == REDIS_REPLY_ERROR ? redisR->str : "Redis command (MGET) returned an unexpected reply", redisR);
+
+		goto out;
+
+	}
+
+	// Initialise JSON
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Add every value
+	for (count = 0; count < redisR->elements; count++) {
+
+		if (redisR->element[count]->str == NULL) {zbx_json_addstring(&j, redisArgv[count + 1], NULL, ZBX_JSON_TYPE_NULL);}
+		if (redisR->element[count]->str != NULL) {zbx_json_addstring(&j, redisArgv[count + 1], redisR->element[count]->str, ZBX_JSON_TYPE_STRING);}
+
+	}
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/**************************************************************************************************
+ *                                                                                                *
+ * Custom Key            : redis.key.hash.mget[server,port,timeout,password,database,key,fields]  *
+ *                                                                                                *
+ * Function              : Gets many redis hash field values with one HMGET as a JSON object      *
+ *                         (fields that do not exist are null)                                    *
+ * Parameters [server]   : Redis server address to connect                                        *
+ * Parameters [port]     : Redis server port to connect                                           *
+ * Parameters [timeout]  : Timeout in seconds                                                     *
+ * Parameters [password] : Redis password to connect using (blank)                                *
+ * Parameters [database] : Redis database to connect                                              *
+ * Parameters [key]      : Redis hash key                                                         *
+ * Parameters [fields]   : Hash fields separated by | (field-a|field-b etc...)                    *
+ * Returns               : 0 (success),1 (failure)                                                *
+ *                                                                                                *
+ **************************************************************************************************/
+int redis_key_hash_mget(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_mget";
+	const char     *__key_name      = "redis.key.hash.mget[server,port,timeout,password,database,key,fields]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 7;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_fields;
+	const char     *redisArgv[MAX_MGET_KEYS + 2];
+	int             redisArgc;
+	struct          zbx_json j;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL;
+	size_t          count;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_database = get_rparam(request,4);
+	param_key      = get_rparam(request,5);
+	param_fields   = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Fields", param_fields, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                          {return ret;}
+
+	// Set the redis command
+	redisArgv[0] = "HMGET";
+	redisArgv[1] = param_key;
+
+	// Split the fields
+	if ((redisArgc = split_param(result, zbx_key, "Fields", param_fields, MGET_SEPARATOR, redisArgv + 2, MAX_MGET_KEYS)) == -1) {return ret;}
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// Run redis command (pipelined with the key type check)
+	if (redis_key_typed_command(result, &ret, zbx_key, redisC, &redisR, param_key, "hash", redisArgc + 2, redisArgv, REDIS_REPLY_ARRAY)) {goto out;}
+
+	// Initialise JSON
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Add every value
+	for (count = 0; count < redisR->elements && count < (size_t)redisArgc; count++) {
+
+		if (redisR->element[count]->str == NULL) {zbx_json_addstring(&j, redisArgv[count + 2], NULL, ZBX_JSON_TYPE_NULL);}
+		if (redisR->element[count]->str != NULL) {zbx_json_addstring(&j, redisArgv[count + 2], redisR->element[count]->str, ZBX_JSON_TYPE_STRING);}
+
+	}
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/***********************************************************************************************
+ *                                                                                             *
+ * Custom Key             : redis.key.hash.json[server,port,timeout,password,database,key,     *
+ *                                              maxfields]                                     *
+ *                                                                                             *
+ * Function               : Gets every field of a redis hash as a JSON object                  *
+ *                          (HGETALL if the hash has no more than maxfields fields, otherwise  *
+ *                          HSCAN until maxfields fields have been read)                       *
+ * Parameters [server]    : Redis server address to connect                                    *
+ * Parameters [port]      : Redis server port to connect                                       *
+ * Parameters [timeout]   : Timeout in seconds                                                 *
+ * Parameters [password]  : Redis password to connect using (blank)                            *
+ * Parameters [database]  : Redis database to connect                                          *
+ * Parameters [key]       : Redis hash key                                                     *
+ * Parameters [maxfields] : Maximum fields to return (1000)                                    *
+ * Returns                : 0 (success),1 (failure)                                            *
+ *                                                                                             *
+ ***********************************************************************************************/
+int redis_key_hash_json(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_key_hash_json";
+	const char     *__key_name      = "redis.key.hash.json[server,port,timeout,password,database,key,maxfields]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 7;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_maxfields;
+	const char     *redisArgv[2];
+	char            cursor[MAX_LENGTH_CURSOR] = "0";
+	long long       fields = 0, maxfields;
+	struct          zbx_json j;
+	redisContext   *redisC;
+	redisReply     *redisR = NULL, *redisFields;
+	size_t          count, slots;
+	char          **names;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+
+	// Assign parameters
+	param_server    = get_rparam(request,0);
+	param_port      = get_rparam(request,1);
+	param_timeout   = get_rparam(request,2);
+	param_password  = get_rparam(request,3);
+	param_database  = get_rparam(request,4);
+	param_key       = get_rparam(request,5);
+	param_maxfields = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, NULL)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                 {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                       {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT))        {return ret;}
+	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                             {return ret;}
+	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                       {return ret;}
+	if (validate_param(result, zbx_key, "Maxfields", param_maxfields, DEFAULT_HASH_JSON_FIELDS, ALLOW_NULL_FALSE, MIN_HASH_JSON_FIELDS, MAX_HASH_JSON_FIELDS)) {return ret;}
+
+	// Set the maximum fields
+	maxfields = atoll(param_maxfields);
+
+	// Create the redis session
+	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+
+	// Select the redis database
+	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+
+	// Get the field count (pipelined with the key type check)
+	redisArgv[0] = "HLEN";
+	redisArgv[1] = param_key;
+
+	if (redis_key_typed_command(result, &ret, zbx_key, redisC, &redisR, param_key, "hash", 2, redisArgv, REDIS_REPLY_INTEGER)) {goto out;}
+
+	// If the hash is small enough then every field is read at once
+	if (redisR->integer <= maxfields) {
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+		// Run redis command
+		if ((redisR = redis_command_send(redisC,"HGETALL %s",param_key)) == NULL || redisR->type == REDIS_REPLY_ERROR) {
+
+			// Set return
+			zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR != NULL ? redisR->str : "Redis connection lost", redisR);
+
+			goto out;
+
+		}
+
+		// Initialise JSON
+		zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+		// Add every field (fields and values alternate on RESP2 and RESP3, and the hash may have grown since HLEN)
+		for (count = 0; count + 1 < redisR->elements && fields < maxfields; count += 2, fields++) {zbx_json_addstring(&j, redisR->element[count]->str, redisR->element[count + 1]->str, ZBX_JSON_TYPE_STRING);}
+
+		// Log message
+		if (count + 1 < redisR->elements) {zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) hash truncated to (%lld) fields",MODULE,zbx_key,fields);}
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+		goto json_out;
+
+	}
+
+	// Free the reply
+	redis_reply_free(redisR);
+
+	// Initialise JSON
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// HSCAN may return a field more than once so the fields added are remembered
+	slots = (size_t)maxfields * 2;
+	names = redis_arena_alloc(slots * sizeof(char *));
+	memset(names, 0, slots * sizeof(char *));
+
+	// Scan the hash until enough fields have been read
+	do {
+
+		// Run redis command
+		if ((redisR = redis_command_send(redisC,"HSCAN %s %s COUNT %d",param_key,cursor,HASH_JSON_SCAN_COUNT)) == NULL || redisR->type != REDIS_REPLY_ARRAY || redisR->elements != 2) {
+
+			// Set return
+			zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR != NULL && redisR->type == REDIS_REPLY_ERROR ? redisR->str : "Redis command (HSCAN) failed", redisR);
+
+			// Free the json
+			zbx_json_free(&j);
+
+			goto out;
+
+		}
+
+		// Add the fields of the batch
+		redisFields = redisR->element[1];
+
+		for (count = 0; count + 1 < redisFields->elements && fields < maxfields; count += 2) {
+
+			// If the field has already been added
+			if (redis_names_add(names, slots, redisFields->element[count]->str, redisFields->element[count]->len)) {continue;}
+
+			zbx_json_addstring(&j, redisFields->element[count]->str, redisFields->element[count + 1]->str, ZBX_JSON_TYPE_STRING);
+
+			fields++;
+
+		}
+
+		// Move the cursor
+		zbx_strlcpy(cursor,redisR->element[0]->str,MAX_LENGTH_CURSOR);
+
+		// Free the reply
+		redis_reply_free(redisR);
+
+	} while (strcmp(cursor,"0") != 0 && fields < maxfields);
+
+	// Log message
+	if (fields >= maxfields && strcmp(cursor,"0") != 0) {zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) hash truncated to (%lld) fields",MODULE,zbx_key,fields);}
+
+json_out:
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+out:
+
+	// Free the context
+	redisFree(redisC);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/*****************************************************************************************************
+ *                                                                                                   *
+ * Custom Key            : redis.pubsub.channel.discovery[server,port,timeout,password,pattern]      *
+ *                                                                                                   *
+ * Function              : Discovers redis pub/sub channels with at least one subscriber             *
+ * Parameters [server]   : Redis server address to connect                                           *
+ * Parameters [port]     : Redis server port to connect                                              *
+ * Parameters [timeout]  : Timeout in seconds                                                        *
+ * Parameters [password] : Redis password to connect using (blank)                                   *
+ * Parameters [pattern]  : Channel glob-style pattern (*)                                            *
+ * Returns               : 0 (success),1 (failure)                                                   *
+ *                                                                                                   *
+ ****************************************************************************************************/
+int redis_pubsub_channel_discovery(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_pubsub_channel_discovery";
+	const char     *__key_name      = "redis.pubsub.channel.discovery[server,port,timeout,password,pattern]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 5;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_pattern;
+	int             cache_ttl;
+	struct          zbx_json j;
+	redisReply     *redisR = NULL, *redisNumsub;
+	int             discovered_instances = 0;
+	size_t          count;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count (the pattern is optional)
+	if (validate_param_count(result, zbx_key, 4, request->nparam, "<"))           {return ret;}
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, ">")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_pattern  = strisnull(get_rparam(request,4)) ? DEFAULT_PUBSUB_PATTERN : get_rparam(request,4);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+
+	// Get the channels (The replies are owned by the cache so they are not freed)
+	if (redis_pubsub_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, param_pattern, &redisR, &redisNumsub)) {goto out;}
+
+	// Initialise JSON for discovery
+	zbx_json_init(&j,ZBX_JSON_STAT_BUF_LEN);
+
+	// Create JSON array of discovered instances
+	zbx_json_addarray(&j,ZBX_PROTO_TAG_DATA);
+
+	// For every channel
+	for (count = 0; count < redisR->elements; count++) {
+
+		// If the channel is not a string
+		if (redisR->element[count]->str == NULL) {continue;}
+
+		// Open instance in JSON
+		zbx_json_addobject(&j, NULL);
+
+		zbx_json_addstring(&j, "{#PATTERN}", param_pattern, ZBX_JSON_TYPE_STRING);
+		zbx_json_addstring(&j, "{#CHANNEL}", redisR->element[count]->str, ZBX_JSON_TYPE_STRING);
+
+		// Close instance in JSON 
+		zbx_json_close(&j);
+
+		// Increment discovered instances
+		discovered_instances++;
+
+	}
+
+	// Finalise JSON for discovery
+	zbx_json_close(&j);
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Key (%s) discovered instances (%d)",MODULE,zbx_key,discovered_instances);
+
+	// Set result
+	SET_STR_RESULT(result, strdup(j.buffer));
+
+	// Set return
+	ret = SYSINFO_RET_OK;
+
+	// Free the json
+	zbx_json_free(&j);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/*******************************************************************************************************
+ *                                                                                                     *
+ * Custom Key            : redis.pubsub.channel.subscribers[server,port,timeout,password,channel,      *
+ *                                                          pattern]                                   *
+ *                                                                                                     *
+ * Function              : Gets the subscriber count of a redis pub/sub channel (the counts of every   *
+ *                         channel matching the pattern are fetched together and cached)               *
+ * Parameters [server]   : Redis server address to connect                                             *
+ * Parameters [port]     : Redis server port to connect                                                *
+ * Parameters [timeout]  : Timeout in seconds                                                          *
+ * Parameters [password] : Redis password to connect using (blank)                                     *
+ * Parameters [channel]  : Channel to return the subscriber count of                                   *
+ * Parameters [pattern]  : Channel glob-style pattern used for discovery (*)                           *
+ * Returns               : 0 (success),1 (failure)                                                     *
+ *                                                                                                     *
+ ******************************************************************************************************/
+int redis_pubsub_channel_subscribers(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_pubsub_channel_subscribers";
+	const char     *__key_name      = "redis.pubsub.channel.subscribers[server,port,timeout,password,channel,pattern]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 6;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_channel, *param_pattern;
+	int             cache_ttl;
+	redisReply     *redisR = NULL, *redisNumsub;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count (the pattern is optional)
+	if (validate_param_count(result, zbx_key, 5, request->nparam, "<"))           {return ret;}
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, ">")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_channel  = get_rparam(request,4);
+	param_pattern  = strisnull(get_rparam(request,5)) ? DEFAULT_PUBSUB_PATTERN : get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+	if (validate_param(result, zbx_key, "Channel", param_channel, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                        {return ret;}
+
+	// Get the channels (The replies are owned by the cache so they are not freed)
+	if (redis_pubsub_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, param_pattern, &redisR, &redisNumsub)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redis_pubsub_subscribers(redisNumsub, param_channel), NULL);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/*************************************************************************************************
+ *                                                                                               *
+ * Custom Key            : redis.pubsub.channel.count[server,port,timeout,password,pattern]      *
+ *                                                                                               *
+ * Function              : Gets the number of redis pub/sub channels matching a pattern          *
+ * Parameters [server]   : Redis server address to connect                                       *
+ * Parameters [port]     : Redis server port to connect                                          *
+ * Parameters [timeout]  : Timeout in seconds                                                    *
+ * Parameters [password] : Redis password to connect using (blank)                               *
+ * Parameters [pattern]  : Channel glob-style pattern (*)                                        *
+ * Returns               : 0 (success),1 (failure)                                               *
+ *                                                                                               *
+ ************************************************************************************************/
+int redis_pubsub_channel_count(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_pubsub_channel_count";
+	const char     *__key_name      = "redis.pubsub.channel.count[server,port,timeout,password,pattern]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 5;
+	char           *param_server, *param_port, *param_timeout, *param_password, *param_pattern;
+	int             cache_ttl;
+	redisReply     *redisR = NULL, *redisNumsub;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
+
+	// Validate parameter count (the pattern is optional)
+	if (validate_param_count(result, zbx_key, 4, request->nparam, "<"))           {return ret;}
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, ">")) {return ret;}
+
+	// Assign parameters
+	param_server   = get_rparam(request,0);
+	param_port     = get_rparam(request,1);
+	param_timeout  = get_rparam(request,2);
+	param_password = get_rparam(request,3);
+	param_pattern  = strisnull(get_rparam(request,4)) ? DEFAULT_PUBSUB_PATTERN : get_rparam(request,4);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
+
+	// If parameters are invalid
+	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
+	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
+	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
+
+	// Get the channels (The replies are owned by the cache so they are not freed)
+	if (redis_pubsub_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, param_pattern, &redisR, &redisNumsub)) {goto out;}
+
+	// Set return
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->elements, NULL);
+
+out:
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
+
+	return ret;
+
+}
+
+/********************************************************************************
+ *                                                                              *
+ * Custom Key            : redis.pubsub.patterns[server,port,timeout,password]  *
+ *                                                                              *
+ * Function              : Gets the number of redis pub/sub pattern             *
+ *                         subscriptions (PUBSUB NUMPAT)                        *
+ * Parameters [server]   : Redis server address to connect                      *
+ * Parameters [port]     : Redis server port to connect                         *
+ * Parameters [timeout]  : Timeout in seconds                                   *
+ * Parameters [password] : Redis password to connect using (blank)              *
+ * Returns               : 0 (success),1 (failure)                              *
+ *                                                                              *
+ *******************************************************************************/
+int redis_pubsub_patterns(AGENT_REQUEST *request,AGENT_RESULT *result)
+{
+
+	// Declare Variables
+	const char     *__function_name = "redis_pubsub_patterns";
+	const char     *__key_name      = "redis.pubsub.patterns[server,port,timeout,password]";
+	int             ret = SYSINFO_RET_FAIL;
+	char           *zbx_key;
+	int             param_count = 4;
+	char           *param_server, *param_port, *param_timeout, *param_password;
+	int             cache_ttl;
+	char           *redisCmds[] = {"PUBSUB NUMPAT"};
+	redisReply     *redisR = NULL;
+
+	// Log message
+	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
+
+	// Generate the zabbix key
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -2913,49 +5504,23 @@ int redis_key_hash_field_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
-	param_field    = get_rparam(request,6);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
-	if (validate_param(result, zbx_key, "Field", param_field, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
-
-        // Append the parameters
-        strcat(redisParams,param_key);
-        strcat(redisParams," ");
-        strcat(redisParams,param_field);
- 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
 
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
-
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
-
-	// If the redis key type does not match
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "hash")) {goto out;}
-
-	// If the redis hash field does not exist
-	if (redis_hash_field_check_exists(result, &ret, zbx_key, &redisC, param_key, param_field)) {goto out;}
-
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "HSTRLEN", redisParams, REDIS_REPLY_INTEGER)) {goto out;}
+	// Get the pattern count (cached by the channel keys when they are polled, The reply is owned by the cache so it is not freed)
+	if (redis_cache_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, redisCmds, 1, 0, REDIS_REPLY_INTEGER, &redisR)) {goto out;}
 
 	// Set return
-	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, NULL);
 
 out:
 
-	// Free the context
-	redisFree(redisC);
-
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
 
@@ -2963,78 +5528,79 @@ out:
 
 }
 
-/***********************************************************************************************
- *                                                                                             *
- * Custom Key            : redis.key.list.exists[server,port,timeout,password,database,key]    *
- *                                                                                             *
- * Function              : Tests if redis list exists                                          *
- * Parameters [server]   : Redis server address to connect                                     *
- * Parameters [port]     : Redis server port to connect                                        *
- * Parameters [timeout]  : Timeout in seconds                                                  *
- * Parameters [password] : Redis password to connect using (blank)                             *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                    *
- * Parameters [key]      : Key to check (key-a, key-b, key-c etc...)                           *
- * Returns               : 0 (no),1 (yes)                                                      *
- *                                                                                             *
- ***********************************************************************************************/
-int redis_key_list_exists(AGENT_REQUEST *request,AGENT_RESULT *result)
+/***************************************************************************************************
+ *                                                                                                 *
+ * Custom Key            : redis.events.rate[server,port,timeout,password,event,prefix]            *
+ *                                                                                                 *
+ * Function              : Gets the rate of redis keyspace events per second over the last         *
+ *                         EVENT_RATE_INTERVAL seconds (counted by the keyspace event listener so  *
+ *                         redis is not polled)                                                    *
+ * Parameters [server]   : Redis server address listened to (LIBZBXREDIS_EVENTS)                   *
+ * Parameters [port]     : Redis server port listened to                                           *
+ * Parameters [timeout]  : Timeout in seconds (not used)                                           *
+ * Parameters [password] : Redis password to connect using (not used)                              *
+ * Parameters [event]    : Event to return (expired,evicted,set)                                   *
+ * Parameters [prefix]   : Key prefix before the first ':' (blank for every key)                   *
+ * Returns               : 0 (success),1 (failure)                                                 *
+ *                                                                                                 *
+ **************************************************************************************************/
+int redis_events_rate(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_list_exists";
-	const char     *__key_name      = "redis.key.list.exists[server,port,timeout,password,database,key]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char           *__function_name = "redis_events_rate";
+	const char           *__key_name      = "redis.events.rate[server,port,timeout,password,event,prefix]";
+	int                   ret = SYSINFO_RET_FAIL;
+	char                 *zbx_key, *zbx_msg;
+	int                   param_count = 6;
+	char                 *param_server, *param_port, *param_event, *param_prefix;
+	redis_event_prefix_t *slot;
+	int                   type;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
-	// Validate parameter count
-	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+	// Validate parameter count (the prefix is optional)
+	if (validate_param_count(result, zbx_key, 5, request->nparam, "<"))           {return ret;}
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, ">")) {return ret;}
 
-	// Assign parameters
+	// Assign parameters (the timeout and password are not used as redis is not polled)
 	param_server   = get_rparam(request,0);
 	param_port     = get_rparam(request,1);
-	param_timeout  = get_rparam(request,2);
-	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
+	param_event    = get_rparam(request,4);
+	param_prefix   = strisnull(get_rparam(request,5)) ? "" : get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, NULL, NULL, NULL)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
-	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Event", param_event, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                            {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+	// If the event is not counted
+	if ((type = redis_events_type(param_event)) == -1) {
 
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+		// Form message
+		zbx_msg = redis_arena_printf("Event must be one of expired,evicted,set");
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, NULL);
 
-	// If the redis key type does not match list
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 0, redisR);}
+		goto out;
 
-	// If the redis key type does match list
-	if (! redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, 1, redisR);}
+	}
 
-out:
+	// Get the counters of the prefix
+	if (redis_events_get(result, zbx_key, param_server, param_port, param_prefix, &slot)) {goto out;}
 
-	// Free the context
-	redisFree(redisC);
+	// Set return
+	zbx_ret_float(result, &ret, LOG_LEVEL_DEBUG, zbx_key, __atomic_load_n(&slot->rate[type],__ATOMIC_RELAXED) / 1000.0, NULL);
+
+out:
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
@@ -3043,110 +5609,79 @@ out:
 
 }
 
-/************************************************************************************************************
- *                                                                                                          *
- * Custom Key            : redis.key.list.get[server,port,timeout,password,database,key,element,default]    *
- *                                                                                                          *
- * Function              : Gets a redis list element                                                        *
- * Parameters [server]   : Redis server address to connect                                                  *
- * Parameters [port]     : Redis server port to connect                                                     *
- * Parameters [timeout]  : Timeout in seconds                                                               *
- * Parameters [password] : Redis password to connect using (blank)                                          *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                                 *
- * Parameters [key]      : Key to select the field from (key-a, key-b, key-c etc...)                        *
- * Parameters [element]  : Element to return (0, 1, 2 etc...)                                               *
- * Parameters [default]  : Value default to return if no value is detected                                  *
- * Returns               : 0 (success),1 (failure)                                                          *
- *                                                                                                          *
- ************************************************************************************************************/
-int redis_key_list_get(AGENT_REQUEST *request,AGENT_RESULT *result)
+/***************************************************************************************************
+ *                                                                                                 *
+ * Custom Key            : redis.events.count[server,port,timeout,password,event,prefix]           *
+ *                                                                                                 *
+ * Function              : Gets the number of redis keyspace events counted since the agent        *
+ *                         started (counted by the keyspace event listener so redis is not polled) *
+ * Parameters [server]   : Redis server address listened to (LIBZBXREDIS_EVENTS)                   *
+ * Parameters [port]     : Redis server port listened to                                           *
+ * Parameters [timeout]  : Timeout in seconds (not used)                                           *
+ * Parameters [password] : Redis password to connect using (not used)                              *
+ * Parameters [event]    : Event to return (expired,evicted,set)                                   *
+ * Parameters [prefix]   : Key prefix before the first ':' (blank for every key)                   *
+ * Returns               : 0 (success),1 (failure)                                                 *
+ *                                                                                                 *
+ **************************************************************************************************/
+int redis_events_count(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_list_get";
-	const char     *__key_name      = "redis.key.list.get[server,port,timeout,password,database,key,element,default]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 8;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key, *param_element, *param_default;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
-	char            redisParams[MAX_LENGTH_STRING];
+	const char           *__function_name = "redis_events_count";
+	const char           *__key_name      = "redis.events.count[server,port,timeout,password,event,prefix]";
+	int                   ret = SYSINFO_RET_FAIL;
+	char                 *zbx_key, *zbx_msg;
+	int                   param_count = 6;
+	char                 *param_server, *param_port, *param_event, *param_prefix;
+	redis_event_prefix_t *slot;
+	int                   type;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
-	// Validate parameter count
-	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
+	// Validate parameter count (the prefix is optional)
+	if (validate_param_count(result, zbx_key, 5, request->nparam, "<"))           {return ret;}
+	if (validate_param_count(result, zbx_key, param_count, request->nparam, ">")) {return ret;}
 
-	// Assign parameters
+	// Assign parameters (the timeout and password are not used as redis is not polled)
 	param_server   = get_rparam(request,0);
 	param_port     = get_rparam(request,1);
-	param_timeout  = get_rparam(request,2);
-	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
-	param_element  = get_rparam(request,6);
-	param_default  = get_rparam(request,7);
+	param_event    = get_rparam(request,4);
+	param_prefix   = strisnull(get_rparam(request,5)) ? "" : get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, NULL, NULL, NULL)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
-	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
-	if (validate_param(result, zbx_key, "Element", param_element, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
-	if (validate_param(result, zbx_key, "Default", param_default, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                         {return ret;}
-
-        // Append the parameters
-        strcat(redisParams,param_key);
-        strcat(redisParams," ");
-        strcat(redisParams,param_element);
- 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
-
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
-
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+	if (validate_param(result, zbx_key, "Event", param_event, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                            {return ret;}
 
-	// If the redis key type does not match list
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {goto out;}
-
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "LLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+	// If the event is not counted
+	if ((type = redis_events_type(param_event)) == -1) {
 
-	// If the redis list element does not exist
-	if (redisR->integer < atoi(param_element)) {
+		// Form message
+		zbx_msg = redis_arena_printf("Event must be one of expired,evicted,set");
 
 		// Set return
-		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis list element does not exist", redisR);
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, NULL);
 
 		goto out;
 
 	}
 
-	// Free the reply
-	freeReplyObject(redisR);
-
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "LINDEX", redisParams, REDIS_REPLY_STRING)) {goto out;}
+	// Get the counters of the prefix
+	if (redis_events_get(result, zbx_key, param_server, param_port, param_prefix, &slot)) {goto out;}
 
 	// Set return
-	zbx_ret_string(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->str, redisR);
+	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, __atomic_load_n(&slot->count[type],__ATOMIC_RELAXED), NULL);
 
 out:
 
-	// Free the context
-	redisFree(redisC);
-
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
 
@@ -3154,40 +5689,44 @@ out:
 
 }
 
-/***********************************************************************************************
- *                                                                                             *
- * Custom Key            : redis.key.list.length[server,port,timeout,password,database,key]    *
- *                                                                                             *
- * Function              : Gets the length of a redisk list key                                *
- * Parameters [server]   : Redis server address to connect                                     *
- * Parameters [port]     : Redis server port to connect                                        *
- * Parameters [timeout]  : Timeout in seconds                                                  *
- * Parameters [password] : Redis password to connect using (blank)                             *
- * Parameters [database] : Database to select the key from (1, 2, 3 etc...)                    *
- * Parameters [key]      : Key to return (key-a, key-b, key-c etc...)                          *
- * Returns               : 0 (success),1 (failure)                                             *
- *                                                                                             *
- ***********************************************************************************************/
-int redis_key_list_length(AGENT_REQUEST *request,AGENT_RESULT *result)
+/**********************************************************************************************************
+ *                                                                                                        *
+ * Custom Key            : redis.replication.lag[server,port,timeout,password,slave,measure]              *
+ *                                                                                                        *
+ * Function              : Gets the replication lag of a redis slave, or the replication throughput,      *
+ *                         from INFO REPLICATION fetched and parsed once per interval                     *
+ * Parameters [server]   : Redis server address to connect                                                *
+ * Parameters [port]     : Redis server port to connect                                                   *
+ * Parameters [timeout]  : Timeout in seconds                                                             *
+ * Parameters [password] : Redis password to connect using (blank)                                        *
+ * Parameters [slave]    : Slave to return the lag of (192.168.1.1:6789 etc..., blank for the master)     *
+ * Parameters [measure]  : Measure to return (bytes,seconds,rate)                                         *
+ *                           bytes   - master_repl_offset less the slave offset                           *
+ *                           seconds - bytes divided by the master offset rate                            *
+ *                           rate    - offset bytes per second of the slave (or master) between fetches   *
+ * Returns               : 0 (success),1 (failure)                                                        *
+ *                                                                                                        *
+ *********************************************************************************************************/
+int redis_replication_lag(AGENT_REQUEST *request,AGENT_RESULT *result)
 {
 
 	// Declare Variables
-	const char     *__function_name = "redis_key_list_length";
-	const char     *__key_name      = "redis.key.list.length[server,port,timeout,password,database,key,field]";
-	int             ret = SYSINFO_RET_FAIL;
-	char            zbx_key[MAX_LENGTH_KEY], zbx_msg[MAX_LENGTH_MSG];
-	int             param_count = 6;
-	char           *param_server, *param_port, *param_timeout, *param_password, *param_database, *param_key;
-	redisContext   *redisC;
-	redisReply     *redisR;
-	struct timeval  timeout;
-	char           *line;
+	const char          *__function_name = "redis_replication_lag";
+	const char          *__key_name      = "redis.replication.lag[server,port,timeout,password,slave,measure]";
+	int                  ret = SYSINFO_RET_FAIL;
+	char                *zbx_key, *zbx_msg;
+	int                  param_count = 6;
+	char                *param_server, *param_port, *param_timeout, *param_password, *param_slave, *param_measure;
+	int                  cache_ttl;
+	redis_replication_t *replication;
+	redis_replica_t     *slave = NULL;
+	unsigned long long   bytes = 0;
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Enter function %s",MODULE,__function_name);
 
 	// Generate the zabbix key
-	zbx_key_gen(request,zbx_key);
+	zbx_key = zbx_key_gen(request);
 
 	// Validate parameter count
 	if (validate_param_count(result, zbx_key, param_count, request->nparam, "!=")) {return ret;}
@@ -3197,38 +5736,101 @@ int redis_key_list_length(AGENT_REQUEST *request,AGENT_RESULT *result)
 	param_port     = get_rparam(request,1);
 	param_timeout  = get_rparam(request,2);
 	param_password = get_rparam(request,3);
-	param_database = get_rparam(request,4);
-	param_key      = get_rparam(request,5);
+	param_slave    = get_rparam(request,4);
+	param_measure  = get_rparam(request,5);
+
+	// Resolve a named target (@name) into its settings
+	if (redis_target_resolve(result, zbx_key, &param_server, &param_port, &param_timeout, &param_password, &cache_ttl)) {return ret;}
 
 	// If parameters are invalid
 	if (validate_param(result, zbx_key, "Redis server", param_server, DEFAULT_REDIS_SERVER, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                          {return ret;}
 	if (validate_param(result, zbx_key, "Redis port", param_port, DEFAULT_REDIS_PORT, ALLOW_NULL_FALSE, MIN_REDIS_PORT, MAX_REDIS_PORT))                {return ret;}
 	if (validate_param(result, zbx_key, "Redis timeout", param_timeout, DEFAULT_REDIS_TIMEOUT, ALLOW_NULL_FALSE, MIN_REDIS_TIMEOUT, MAX_REDIS_TIMEOUT)) {return ret;}
-	if (validate_param(result, zbx_key, "Database", param_database, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                      {return ret;}
-	if (validate_param(result, zbx_key, "Key", param_key, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                                {return ret;}
+	if (validate_param(result, zbx_key, "Slave", param_slave, NO_DEFAULT, ALLOW_NULL_TRUE, NO_MIN, NO_MAX))                                             {return ret;}
+	if (validate_param(result, zbx_key, "Measure", param_measure, NO_DEFAULT, ALLOW_NULL_FALSE, NO_MIN, NO_MAX))                                        {return ret;}
 
-	// Create the redis session
-	if ((redisC = redis_session(result, zbx_key, param_server, param_port, param_timeout, param_password)) == NULL) {return ret;}
+	// If the measure is not known
+	if (strcmp(param_measure,"bytes") != 0 && strcmp(param_measure,"seconds") != 0 && strcmp(param_measure,"rate") != 0) {
 
-	// Select the redis database
-	if (redis_select_database(result, &ret, zbx_key, &redisC, param_database)) {goto out;}
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Measure must be one of bytes,seconds,rate", NULL);
 
-	// If the redis key does not exist
-	if (redis_key_check_exists(result, &ret, zbx_key, &redisC, param_key)) {goto out;}
+		goto out;
 
-	// If the redis key type does not match list
-	if (redis_key_check_type(result, &ret, zbx_key, &redisC, param_key, "list")) {goto out;}
+	}
 
-	// Run redis command
-	if (redis_command(result, zbx_key, redisC, &redisR, "LLEN", param_key, REDIS_REPLY_INTEGER)) {goto out;}
+	// If the lag is asked for without a slave
+	if (strlen(param_slave) == 0 && strcmp(param_measure,"rate") != 0) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Slave must not be empty", NULL);
+
+		goto out;
+
+	}
+
+	// Get the replication state (The state is a copy in the request arena so it is not freed)
+	if (redis_replication_fetch(result, zbx_key, param_server, param_port, param_timeout, param_password, cache_ttl, &replication)) {goto out;}
+
+	// If the slave does not exist
+	if (strlen(param_slave) > 0 && (slave = redis_replication_slave(replication, param_slave)) == NULL) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Redis slave does not exist", NULL);
+
+		goto out;
+
+	}
+
+	// Work out the lag in bytes (a slave can briefly report an offset ahead of the fetched master offset)
+	if (slave != NULL && replication->master_offset > slave->offset) {bytes = replication->master_offset - slave->offset;}
 
 	// Set return
-	zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, redisR->integer, redisR);
+	if (strcmp(param_measure,"bytes") == 0) {zbx_ret_integer(result, &ret, LOG_LEVEL_DEBUG, zbx_key, bytes, NULL); goto out;}
 
-out:
+	// If the rates are not known yet (they need two fetches)
+	if (! replication->rated) {
 
-	// Free the context
-	redisFree(redisC);
+		// Form message
+		zbx_msg = redis_arena_printf("Replication rate is not known until INFO REPLICATION has been fetched twice");
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, NULL);
+
+		goto out;
+
+	}
+
+	// If the rate of the slave is not known yet (it needs two samples of the slave)
+	if (strcmp(param_measure,"rate") == 0 && slave != NULL && ! slave->rated) {
+
+		// Form message
+		zbx_msg = redis_arena_printf("Replication rate of the slave is not known until it has been seen in INFO REPLICATION twice");
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, zbx_msg, NULL);
+
+		goto out;
+
+	}
+
+	// Set return
+	if (strcmp(param_measure,"rate") == 0) {zbx_ret_float(result, &ret, LOG_LEVEL_DEBUG, zbx_key, (slave != NULL) ? slave->rate : replication->master_rate, NULL); goto out;}
+
+	// If the slave is behind without any writes to estimate from
+	if (bytes > 0 && replication->master_rate <= 0) {
+
+		// Set return
+		zbx_ret_fail(result, &ret, LOG_LEVEL_DEBUG, zbx_key, "Replication lag can not be estimated without replication traffic", NULL);
+
+		goto out;
+
+	}
+
+	// Set return
+	zbx_ret_float(result, &ret, LOG_LEVEL_DEBUG, zbx_key, (bytes > 0) ? bytes / replication->master_rate : 0, NULL);
+
+out:
 
 	// Log message
 	zabbix_log(LOG_LEVEL_DEBUG,"Module (%s): Exit function %s",MODULE,__function_name);
@@ -3236,4 +5838,3 @@ out:
 	return ret;
 
 }
-